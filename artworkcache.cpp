@@ -0,0 +1,155 @@
+/*
+ * Author: Itoro Ifon, jason Hippolite, Prince Umeh
+ * Date: 2026-10-16
+ * Course/Assignment: C++ Project - Qt Music Player
+ * File: artworkcache.cpp
+ * Purpose: Implements artwork lookup, scaled decoding and the two thumbnail
+ *          cache levels.
+ */
+#include "artworkcache.h"
+#include "tracer.h"
+
+#include <QDir>
+#include <QImageReader>
+#include <QCryptographicHash>
+#include <QStandardPaths>
+
+// Same order the player has always probed in: folder art first, then art
+// named after the track.
+static const QStringList kCoverNames = {"cover.jpg", "cover.jpeg", "cover.png", "folder.jpg", "folder.png"};
+static const QStringList kTrackArtExts = {"jpg", "jpeg", "png"};
+
+ArtworkCache::ArtworkCache(const QSize& size, int maxThumbs)
+    : thumbSize(size),
+      diskDir(QDir(QStandardPaths::writableLocation(QStandardPaths::CacheLocation)).filePath("artwork")),
+      thumbs(maxThumbs) {}
+
+// ========================= Lookup =========================
+QPixmap ArtworkCache::thumbnailFor(const QString& audioPath) {
+    TRACE_SCOPE("ArtworkCache::thumbnailFor");
+    const QString dirPath = QFileInfo(audioPath).absolutePath();
+    const DirListing& listing = listingFor(dirPath);
+    if (listing.images.isEmpty()) return QPixmap();
+
+    for (const QString& artPath : candidatesFor(audioPath, listing)) {
+        if (QPixmap* hit = thumbs.object(artPath)) return *hit;
+        if (undecodable.contains(artPath)) continue;
+
+        const QFileInfo& art = listing.images.value(QFileInfo(artPath).fileName().toLower());
+        QImage img = loadThumbnail(art);
+        if (img.isNull()) {
+            undecodable.insert(artPath); // fall through to the next candidate
+            continue;
+        }
+
+        auto* px = new QPixmap(QPixmap::fromImage(img));
+        QPixmap result = *px;
+        thumbs.insert(artPath, px);
+        return result;
+    }
+    return QPixmap();
+}
+
+const ArtworkCache::DirListing& ArtworkCache::listingFor(const QString& dirPath) {
+    auto it = dirs.constFind(dirPath);
+    if (it != dirs.constEnd()) return it.value();
+
+    // One directory read replaces the per-candidate exists() probes. Names
+    // are matched case-insensitively, as exists() did on Windows; where two
+    // files differ only in case, the all-lowercase one wins.
+    DirListing listing;
+    const QStringList filters = {"*.jpg", "*.jpeg", "*.png"};
+    const QFileInfoList infos = QDir(dirPath).entryInfoList(filters, QDir::Files | QDir::Readable);
+    for (const QFileInfo& fi : infos) {
+        const QString key = fi.fileName().toLower();
+        if (!listing.images.contains(key) || fi.fileName() == key) listing.images.insert(key, fi);
+    }
+
+    return dirs.insert(dirPath, listing).value();
+}
+
+QStringList ArtworkCache::candidatesFor(const QString& audioPath, const DirListing& listing) const {
+    // Paths come from the listing, so they carry the names' real case.
+    QStringList out;
+    for (const QString& name : kCoverNames) {
+        auto it = listing.images.constFind(name);
+        if (it != listing.images.constEnd()) out << it->absoluteFilePath();
+    }
+
+    const QString base = QFileInfo(audioPath).completeBaseName().toLower();
+    for (const QString& ext : kTrackArtExts) {
+        auto it = listing.images.constFind(base + "." + ext);
+        if (it != listing.images.constEnd()) out << it->absoluteFilePath();
+    }
+    return out;
+}
+
+void ArtworkCache::forgetDirectory(const QString& dirPath) {
+    const QString abs = QDir(dirPath).absolutePath();
+
+    // Roots are scanned recursively, so the listings below go too.
+    const QString prefix = abs + '/';
+    for (auto it = dirs.begin(); it != dirs.end();) {
+        if (it.key() == abs || it.key().startsWith(prefix)) it = dirs.erase(it);
+        else ++it;
+    }
+
+    // Thumbnails of replaced covers must not outlive the listing.
+    for (const QString& key : thumbs.keys())
+        if (key.startsWith(prefix)) thumbs.remove(key);
+    for (auto it = undecodable.begin(); it != undecodable.end();) {
+        if (it->startsWith(prefix)) it = undecodable.erase(it);
+        else ++it;
+    }
+}
+
+void ArtworkCache::clear() {
+    thumbs.clear();
+    dirs.clear();
+    undecodable.clear();
+}
+
+// ========================= Thumbnails =========================
+QImage ArtworkCache::loadThumbnail(const QFileInfo& art) const {
+    // The key changes whenever the cover does, so stale files are never read.
+    const QString stored = QDir(diskDir).filePath(diskKey(art) + ".png");
+
+    QImage img(stored);
+    if (!img.isNull()) return img;
+
+    img = decodeScaled(art.absoluteFilePath());
+    if (img.isNull()) return img;
+
+    QDir().mkpath(diskDir);
+    img.save(stored, "PNG"); // best effort; a failed write only costs a re-decode
+    return img;
+}
+
+QImage ArtworkCache::decodeScaled(const QString& artPath) const {
+    QImageReader reader(artPath);
+    reader.setAutoTransform(true);
+
+    // Let the decoder downscale (JPEG does this during IDCT) instead of
+    // materialising a multi-megapixel image first.
+    const QSize full = reader.size();
+    if (full.isValid()) {
+        QSize target = full.scaled(thumbSize, Qt::KeepAspectRatioByExpanding);
+        // Decode at twice the target so the final smooth scale stays sharp.
+        const QSize twice = target * 2;
+        if (twice.width() < full.width() && twice.height() < full.height()) reader.setScaledSize(twice);
+    }
+
+    QImage img = reader.read();
+    if (img.isNull()) return img;
+
+    return img.scaled(thumbSize, Qt::KeepAspectRatioByExpanding, Qt::SmoothTransformation);
+}
+
+QString ArtworkCache::diskKey(const QFileInfo& art) const {
+    QCryptographicHash h(QCryptographicHash::Sha1);
+    h.addData(art.absoluteFilePath().toUtf8());
+    h.addData(QByteArray::number(art.size()));
+    h.addData(QByteArray::number(art.lastModified().toMSecsSinceEpoch()));
+    h.addData(QByteArray::number(thumbSize.width()) + 'x' + QByteArray::number(thumbSize.height()));
+    return QString::fromLatin1(h.result().toHex());
+}
@@ -0,0 +1,61 @@
+/*
+ * Author: Itoro Ifon, jason Hippolite, Prince Umeh
+ * Date: 2026-10-16
+ * Course/Assignment: C++ Project - Qt Music Player
+ * File: artworkcache.h
+ * Purpose: Declares ArtworkCache, which finds cover art for a track and keeps
+ *          small pre-scaled thumbnails in memory and on disk.
+ */
+#pragma once
+
+#include <QString>
+#include <QStringList>
+#include <QHash>
+#include <QSet>
+#include <QCache>
+#include <QFileInfo>
+#include <QPixmap>
+#include <QImage>
+#include <QSize>
+
+// Class: ArtworkCache
+// Purpose: Turns an audio path into a thumbnail-sized cover pixmap.
+//          Level 1: LRU of scaled pixmaps keyed by resolved artwork path.
+//          Level 2: PNG thumbnails under the app cache directory, keyed by
+//                   artwork path, size and mtime.
+//          Each directory is listed once; later lookups for tracks in it
+//          resolve the cover from that listing without touching the disk.
+// Notes: GUI thread only (QPixmap). forgetDirectory() drops the listings of
+//        a directory and everything under it, so a cover added or replaced
+//        on disk is picked up.
+class ArtworkCache {
+public:
+    explicit ArtworkCache(const QSize& thumbSize, int maxThumbs = 256);
+
+    // Null pixmap when the track has no usable artwork.
+    QPixmap thumbnailFor(const QString& audioPath);
+
+    void forgetDirectory(const QString& dirPath);
+    void clear();
+
+    QString storeDir() const { return diskDir; }
+
+private:
+    struct DirListing {
+        QHash<QString, QFileInfo> images; // lowercased file name -> info, stat'ed once
+    };
+
+    const DirListing& listingFor(const QString& dirPath);
+    QStringList candidatesFor(const QString& audioPath, const DirListing& listing) const;
+
+    QImage loadThumbnail(const QFileInfo& art) const;
+    QImage decodeScaled(const QString& artPath) const;
+    QString diskKey(const QFileInfo& art) const;
+
+    QSize thumbSize;
+    QString diskDir;
+
+    QCache<QString, QPixmap> thumbs;  // resolved artwork path -> thumbnail
+    QHash<QString, DirListing> dirs;  // absolute directory -> image files
+    QSet<QString> undecodable;        // artwork paths that failed to decode
+};
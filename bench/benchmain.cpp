@@ -0,0 +1,556 @@
+/*
+ * Author: Itoro Ifon, jason Hippolite, Prince Umeh
+ * Date: 2026-10-16
+ * Course/Assignment: C++ Project - Qt Music Player
+ * File: benchmain.cpp
+ * Purpose: Headless benchmark suite. Times filename parsing, path sorting,
+ *          gram extraction, import, per-keystroke filtering, play order
+ *          and shuffle, memory per track, on-disk scanning, content hashing
+ *          and seeking over synthetic libraries, and writes the results as
+ *          JSON for comparison across commits.
+ */
+#include <QCoreApplication>
+#include <QCommandLineParser>
+#include <QElapsedTimer>
+#include <QFile>
+#include <QFileInfo>
+#include <QJsonArray>
+#include <QJsonDocument>
+#include <QJsonObject>
+#include <QDateTime>
+#include <QStandardPaths>
+#include <QTemporaryDir>
+#include <QThread>
+#include <QRandomGenerator>
+
+#include <algorithm>
+#include <cstdio>
+#include <functional>
+#include <memory>
+#include <vector>
+
+#include "collationkey.h"
+#include "librarycache.h"
+#include "dspchain.h"
+#include "duplicatescanner.h"
+#include "loudnessmeter.h"
+#include "librarymodel.h"
+#include "libraryscanner.h"
+#include "playbackengine.h"
+#include "playqueue.h"
+#include "searchindex.h"
+#include "seekindex.h"
+#include "shuffleorder.h"
+#include "trackfiltermodel.h"
+#include "synthlibrary.h"
+#include "waveformpeaks.h"
+
+namespace {
+
+// ========================= Timing =========================
+struct Timing {
+    double medianMs = 0.0;
+    double minMs = 0.0;
+    double maxMs = 0.0;
+};
+
+// Runs `setup` untimed and `body` timed, `repeat` times.
+Timing measure(int repeat, const std::function<void()>& setup, const std::function<void()>& body) {
+    std::vector<double> runs;
+    for (int r = 0; r < std::max(1, repeat); ++r) {
+        if (setup) setup();
+        QElapsedTimer clock;
+        clock.start();
+        body();
+        runs.push_back(double(clock.nsecsElapsed()) / 1e6);
+    }
+    std::sort(runs.begin(), runs.end());
+    return {runs[runs.size() / 2], runs.front(), runs.back()};
+}
+
+// Spins the event loop until `done` is set (queued scanner/filter results).
+void waitFor(const bool& done) {
+    while (!done) QCoreApplication::processEvents(QEventLoop::AllEvents | QEventLoop::WaitForMoreEvents, 50);
+}
+
+// ========================= Results =========================
+class Report {
+public:
+    void add(const QString& name, int tracks, bool lyrics, const Timing& t, int items,
+             const QJsonObject& extra = QJsonObject()) {
+        QJsonObject o = extra;
+        o["benchmark"] = name;
+        o["tracks"] = tracks;
+        o["lyrics"] = lyrics;
+        o["ms"] = t.medianMs;
+        o["minMs"] = t.minMs;
+        o["maxMs"] = t.maxMs;
+        if (items > 0) o["nsPerItem"] = t.medianMs * 1e6 / items;
+        results.append(o);
+
+        std::printf("%-22s %9d %-6s %12.3f ms", qPrintable(name), tracks, lyrics ? "lyrics" : "", t.medianMs);
+        if (items > 0) std::printf("  %10.1f ns/item", t.medianMs * 1e6 / items);
+        for (auto it = extra.begin(); it != extra.end(); ++it)
+            std::printf("  %s=%s", qPrintable(it.key()), qPrintable(it.value().toVariant().toString()));
+        std::printf("\n");
+        std::fflush(stdout);
+    }
+
+    bool write(const QString& path, const QString& label, int repeat) const {
+        QJsonObject root;
+        root["suite"] = "QtMusicPlayerBench";
+        root["formatVersion"] = 1;
+        root["label"] = label;
+        root["timestamp"] = QDateTime::currentDateTimeUtc().toString(Qt::ISODate);
+        root["qtVersion"] = qVersion();
+        root["threads"] = QThread::idealThreadCount();
+        root["repeat"] = repeat;
+#ifdef NDEBUG
+        root["build"] = "release";
+#else
+        root["build"] = "debug";
+#endif
+        root["results"] = results;
+
+        QFile f(path);
+        if (!f.open(QIODevice::WriteOnly | QIODevice::Truncate)) return false;
+        f.write(QJsonDocument(root).toJson(QJsonDocument::Indented));
+        return true;
+    }
+
+private:
+    QJsonArray results;
+};
+
+// ========================= Benchmarks =========================
+void benchParse(Report& report, const QVector<ScannedTrack>& tracks, bool lyrics, int repeat) {
+    QStringList names;
+    names.reserve(tracks.size());
+    for (const auto& t : tracks) names << QFileInfo(t.path).completeBaseName();
+
+    QString artist, title;
+    const Timing t = measure(repeat, nullptr, [&] {
+        for (const QString& n : names) LibraryScanner::parseArtistTitleFromFilename(n, artist, title);
+    });
+    report.add("parseFilename", tracks.size(), lyrics, t, tracks.size());
+}
+
+void benchSort(Report& report, const QVector<ScannedTrack>& tracks, bool lyrics, int repeat) {
+    QStringList shuffled;
+    shuffled.reserve(tracks.size());
+    for (const auto& t : tracks) shuffled << t.path;
+    std::shuffle(shuffled.begin(), shuffled.end(), *QRandomGenerator::global());
+
+    QStringList work;
+    const Timing t = measure(repeat, [&] { work = shuffled; work.detach(); },
+                             [&] { LibraryScanner::sortPaths(work); });
+    report.add("sortPaths", tracks.size(), lyrics, t, tracks.size());
+}
+
+// Header-click sorting of an imported library, per column, alternating
+// direction so every run moves rows. Keys are built once on import.
+void benchSortColumns(Report& report, const QVector<ScannedTrack>& tracks, bool lyrics, int repeat) {
+    LibraryModel model;
+    for (int i = 0; i < tracks.size(); i += 4096) model.appendTracks(tracks.mid(i, 4096));
+
+    const Timing keys = measure(repeat, nullptr, [&] {
+        for (const auto& t : tracks) CollationKey::forTrack(t.title, t.artist, t.album, t.path);
+    });
+    report.add("collationKeys", tracks.size(), lyrics, keys, tracks.size());
+
+    const struct { int column; const char* name; } columns[] = {
+        {LibraryModel::ColTitle, "title"}, {LibraryModel::ColArtist, "artist"}, {LibraryModel::ColAlbum, "album"},
+        {LibraryModel::ColDuration, "duration"}, {LibraryModel::ColPath, "path"}};
+    for (const auto& c : columns) {
+        Qt::SortOrder order = Qt::AscendingOrder;
+        const Timing t = measure(repeat, nullptr, [&] {
+            model.sort(c.column, order);
+            order = order == Qt::AscendingOrder ? Qt::DescendingOrder : Qt::AscendingOrder;
+        });
+        report.add("sortColumn", tracks.size(), lyrics, t, tracks.size(), {{"column", c.name}});
+    }
+}
+
+void benchGrams(Report& report, const QVector<ScannedTrack>& tracks, bool lyrics, int repeat) {
+    qint64 grams = 0;
+    const Timing t = measure(repeat, [&] { grams = 0; }, [&] {
+        for (const auto& tr : tracks) grams += SearchIndex::extractGrams(tr.title, tr.artist, tr.lyrics).size();
+    });
+    report.add("extractGrams", tracks.size(), lyrics, t, tracks.size(),
+               {{"gramsPerTrack", double(grams) / std::max(1, int(tracks.size()))}});
+}
+
+// Import = appendTracks() in scanner-sized batches into an empty model.
+void benchImport(Report& report, const QVector<ScannedTrack>& tracks, bool lyrics, int repeat) {
+    constexpr int kBatch = 256;
+    std::unique_ptr<LibraryModel> model;
+
+    const Timing t = measure(repeat, [&] { model = std::make_unique<LibraryModel>(); }, [&] {
+        for (int i = 0; i < tracks.size(); i += kBatch) model->appendTracks(tracks.mid(i, kBatch));
+    });
+    const LyricsStore& pool = model->store().lyricsPool();
+    report.add("import", tracks.size(), lyrics, t, tracks.size(),
+               {{"bytesPerTrack", double(model->bytesPerTrack())},
+                {"totalKiB", double(model->memoryUsage() / 1024)},
+                {"lyricsTextKiB", double(pool.textBytes() / 1024)},
+                {"lyricsResidentKiB", double(pool.residentBytes() / 1024)},
+                {"lyricsMappedKiB", double(pool.mappedBytes() / 1024)},
+                {"exposedRows", model->exposedRows()}});
+}
+
+// Scrolling to the end: the view behind the search proxy pulls every row
+// in, one fetchMore() batch at a time, as it would while scrolling.
+void benchFetch(Report& report, const QVector<ScannedTrack>& tracks, bool lyrics, int repeat) {
+    std::unique_ptr<LibraryModel> model;
+    std::unique_ptr<TrackFilterModel> proxy;
+    int fetches = 0;
+
+    const Timing t = measure(repeat, [&] {
+        proxy.reset();
+        model = std::make_unique<LibraryModel>();
+        for (int i = 0; i < tracks.size(); i += 4096) model->appendTracks(tracks.mid(i, 4096));
+        proxy = std::make_unique<TrackFilterModel>();
+        proxy->setSourceModel(model.get());
+        fetches = 0;
+    }, [&] {
+        while (proxy->canFetchMore(QModelIndex())) {
+            proxy->fetchMore(QModelIndex());
+            ++fetches;
+        }
+    });
+    report.add("fetchAll", tracks.size(), lyrics, t, tracks.size(),
+               {{"fetches", fetches}, {"shown", proxy->rowCount()}});
+}
+
+// A watcher batch deleting every tenth track of a fully fetched library:
+// one store pass however scattered the rows are.
+void benchRemove(Report& report, const QVector<ScannedTrack>& tracks, bool lyrics, int repeat) {
+    std::unique_ptr<LibraryModel> model;
+    QVector<int> rows;
+    for (int r = 0; r < tracks.size(); r += 10) rows << r;
+
+    const Timing t = measure(repeat, [&] {
+        model = std::make_unique<LibraryModel>();
+        for (int i = 0; i < tracks.size(); i += 4096) model->appendTracks(tracks.mid(i, 4096));
+        model->exposeAll();
+    }, [&] { model->removeTracks(rows); });
+    report.add("removeBatch", tracks.size(), lyrics, t, rows.size(), {{"left", model->store().size()}});
+}
+
+// Plays through the whole library the way the player does: every seventh
+// track also queued, a peek per step (the gapless preload), then back
+// through the history.
+void benchPlayQueue(Report& report, const QVector<ScannedTrack>& tracks, bool lyrics, int repeat) {
+    LibraryModel model;
+    for (int i = 0; i < tracks.size(); i += 4096) model.appendTracks(tracks.mid(i, 4096));
+    const TrackStore& store = model.store();
+
+    int steps = 0;
+    const Timing t = measure(repeat, [&] { steps = 0; }, [&] {
+        PlayQueue queue(store);
+        for (int r = 0; r < store.size(); r += 7) queue.enqueue(store.idAt(r));
+        TrackId current = queue.advance(kNoTrack, PlayQueue::Step::Skip);
+        while (current != kNoTrack) {
+            queue.peek(current, PlayQueue::Step::Auto);
+            current = queue.advance(current, PlayQueue::Step::Auto);
+            ++steps;
+        }
+        for (int i = 0; i < PlayQueue::kHistoryLimit; ++i) current = queue.back(current);
+    });
+    report.add("playQueue", tracks.size(), lyrics, t, steps);
+}
+
+// Shuffled picks straight from an imported library, per mode, up to 100k
+// per run: the cost of a pick should not depend on the library size.
+void benchShuffle(Report& report, const QVector<ScannedTrack>& tracks, bool lyrics, int repeat) {
+    LibraryModel model;
+    for (int i = 0; i < tracks.size(); i += 4096) model.appendTracks(tracks.mid(i, 4096));
+    const int picks = std::min(int(tracks.size()), 100000);
+
+    const struct { ShuffleOrder::Mode mode; const char* name; } modes[] = {
+        {ShuffleOrder::Mode::Uniform, "uniform"}, {ShuffleOrder::Mode::LeastPlayed, "leastPlayed"},
+        {ShuffleOrder::Mode::SpreadArtists, "spreadArtists"}};
+    for (const auto& m : modes) {
+        ShuffleOrder order(model.store());
+        order.setMode(m.mode);
+        const Timing t = measure(repeat, [&] { order.restart(); }, [&] {
+            for (int i = 0; i < picks; ++i) order.take(order.peek(true));
+        });
+        report.add("shufflePick", tracks.size(), lyrics, t, picks, {{"mode", m.name}});
+    }
+}
+
+// Types a query one character at a time, waiting for each pass to apply,
+// then clears it. Reports each keystroke separately.
+void benchFilter(Report& report, const QVector<ScannedTrack>& tracks, bool lyrics, int repeat) {
+    LibraryModel model;
+    for (int i = 0; i < tracks.size(); i += 4096) model.appendTracks(tracks.mid(i, 4096));
+
+    TrackFilterModel proxy;
+    proxy.setSourceModel(&model);
+
+    bool applied = false;
+    QObject::connect(&proxy, &TrackFilterModel::queryApplied, [&] { applied = true; });
+
+    auto apply = [&](const QString& q) {
+        applied = false;
+        proxy.applyQuery(q); // bypasses the debounce: we time the work, not the wait
+        waitFor(applied);
+    };
+
+    const QString query = SynthLibrary::commonWord(0) + ' ' + SynthLibrary::commonWord(3);
+    for (int k = 1; k <= query.size(); ++k) {
+        const QString prefix = query.left(k);
+        const Timing t = measure(repeat, [&] { apply(query.left(k - 1)); }, [&] { apply(prefix); });
+        report.add("filterKeystroke", tracks.size(), lyrics, t, 0,
+                   {{"keystroke", k}, {"query", prefix}, {"shown", proxy.rowCount()}});
+    }
+
+    const Timing clear = measure(repeat, [&] { apply(query); }, [&] { apply(QString()); });
+    report.add("filterClear", tracks.size(), lyrics, clear, 0);
+}
+
+// Cold scan (empty cache) and warm scan (every file a cache hit) of a real
+// directory tree; includes the walk, tag reading, sidecars and delivery.
+void benchScan(Report& report, int count, bool lyrics) {
+    QTemporaryDir dir;
+    if (!dir.isValid()) return;
+
+    QElapsedTimer gen;
+    gen.start();
+    const QStringList paths = SynthLibrary::writeFiles(dir.path(), count, lyrics);
+    const double genMs = double(gen.nsecsElapsed()) / 1e6;
+
+    auto scanOnce = [&] {
+        int delivered = 0;
+        bool done = false;
+        LibraryScanner scanner; // destructor saves the cache
+        QObject::connect(&scanner, &LibraryScanner::batchReady,
+                         [&](const QVector<ScannedTrack>& b) { delivered += b.size(); });
+        QObject::connect(&scanner, &LibraryScanner::scanFinished, [&] { done = true; });
+        scanner.scanFolder(dir.path());
+        waitFor(done);
+        return delivered;
+    };
+
+    QFile::remove(LibraryCache::defaultFilePath());
+    int delivered = 0;
+    const Timing cold = measure(1, nullptr, [&] { delivered = scanOnce(); });
+    report.add("scanCold", count, lyrics, cold, count, {{"delivered", delivered}, {"generateMs", genMs}});
+
+    const Timing warm = measure(1, nullptr, [&] { delivered = scanOnce(); });
+    report.add("scanWarm", count, lyrics, warm, count, {{"delivered", delivered}});
+
+    // Duplicate detection over the same files: every core, bounded reads.
+    HashStats hashed;
+    const Timing hash = measure(1, nullptr, [&] {
+        bool done = false;
+        DuplicateScanner hasher;
+        QObject::connect(&hasher, &DuplicateScanner::finished, [&](const HashStats& s) {
+            hashed = s;
+            done = true;
+        });
+        hasher.analyze(paths);
+        waitFor(done);
+    });
+    report.add("contentHash", count, lyrics, hash, paths.size(),
+               {{"megabytesPerSecond", hashed.megabytesPerSecond()}, {"failed", hashed.failed}});
+
+    QFile::remove(LibraryCache::defaultFilePath());
+}
+
+// Loudness analysis cost without decoding: one core, 60 s of 44.1 kHz stereo.
+void benchLoudness(Report& report, int repeat) {
+    constexpr unsigned kRate = 44100;
+    constexpr std::size_t kFrames = std::size_t(kRate) * 60;
+    std::vector<std::int16_t> pcm(kFrames * 2);
+    QRandomGenerator rng(7);
+    for (auto& s : pcm) s = std::int16_t(int(rng.bounded(20000)) - 10000);
+
+    TrackLoudness result;
+    const Timing t = measure(repeat, nullptr, [&] {
+        LoudnessMeter meter(kRate, 2);
+        for (std::size_t f = 0; f < kFrames; f += kRate / 2)
+            meter.addFrames(pcm.data() + f * 2, std::min<std::size_t>(kRate / 2, kFrames - f));
+        result = meter.result();
+    });
+    report.add("loudnessMeter", 0, false, t, int(kFrames),
+               {{"realtimePerCore", 60000.0 / t.medianMs}, {"lufs", double(result.lufs)}});
+}
+
+// Playback DSP cost: every EQ band active plus a limiter that engages,
+// 60 s of 44.1 kHz stereo in the stream's 100 ms blocks.
+void benchDsp(Report& report, int repeat) {
+    constexpr unsigned kRate = 44100;
+    constexpr std::size_t kBlock = kRate / 10;
+    constexpr std::size_t kFrames = std::size_t(kRate) * 60;
+    std::vector<std::int16_t> source(kFrames * 2);
+    QRandomGenerator rng(13);
+    for (auto& s : source) s = std::int16_t(int(rng.bounded(40000)) - 20000);
+
+    DspParams params;
+    params.eqEnabled = true;
+    for (EqBand& band : params.bands) band.gainDb = 6.0f;
+
+    std::vector<std::int16_t> pcm;
+    DspChain chain;
+    chain.setParams(params);
+    chain.prepare(kRate, 2, kBlock);
+    const Timing t = measure(repeat, [&] { pcm = source; chain.resetStats(); }, [&] {
+        for (std::size_t f = 0; f < kFrames; f += kBlock) chain.process(pcm.data() + f * 2, kBlock, 1.0f);
+    });
+    const DspStats s = chain.stats();
+    report.add("dspChain", 0, false, t, int(kFrames),
+               {{"realtimePerCore", 60000.0 / t.medianMs}, {"blockAvgUs", s.avgUs}, {"blockMaxUs", s.maxUs},
+                {"gainReductionDb", double(s.gainReductionDb)}});
+}
+
+// Waveform peaks: reducing 60 s of stereo PCM, then rendering one frame of
+// the seek bar (1920 columns) at full view and at the closest zoom.
+void benchPeaks(Report& report, int repeat) {
+    constexpr unsigned kRate = 44100;
+    constexpr std::size_t kFrames = std::size_t(kRate) * 60;
+    std::vector<std::int16_t> pcm(kFrames * 2);
+    QRandomGenerator rng(11);
+    for (auto& s : pcm) s = std::int16_t(int(rng.bounded(20000)) - 10000);
+
+    PeakPyramid pyramid;
+    const Timing build = measure(repeat, nullptr, [&] {
+        PeakBuilder builder(2);
+        for (std::size_t f = 0; f < kFrames; f += kRate / 2)
+            builder.addFrames(pcm.data() + f * 2, std::min<std::size_t>(kRate / 2, kFrames - f));
+        pyramid = builder.finish(kRate);
+    });
+    report.add("peakBuild", 0, false, build, int(kFrames),
+               {{"realtimePerCore", 60000.0 / build.medianMs}, {"levels", pyramid.levelCount()},
+                {"storedBytes", int(pyramid.serialize().size())}});
+
+    constexpr int kColumns = 1920;
+    std::vector<PeakPair> columns;
+    const Timing full = measure(repeat * 100, nullptr, [&] { pyramid.render(0.0, 1.0, kColumns, columns); });
+    report.add("peakRenderFull", 0, false, full, kColumns);
+
+    const double span = double(kColumns) / double(pyramid.baseBuckets());
+    const Timing zoomed = measure(repeat * 100, nullptr, [&] { pyramid.render(0.4, 0.4 + span, kColumns, columns); });
+    report.add("peakRenderZoomed", 0, false, zoomed, kColumns);
+}
+
+// Seeking in a 20 minute FLAC file without a SEEKTABLE: building the index
+// (once per file, at scan time), looking a position up in it, and random
+// seeks plus the first 100 ms of audio after each, decoded plainly and
+// through the index.
+void benchSeek(Report& report, int repeat) {
+    QTemporaryDir dir;
+    if (!dir.isValid()) return;
+    const QString path = SynthLibrary::writeLongFlac(dir.path(), 20 * 60);
+    if (path.isEmpty()) return;
+
+    SeekIndex index;
+    const Timing build = measure(repeat, nullptr, [&] { index = SeekIndex::build(path); });
+    report.add("seekIndexBuild", 0, false, build, 0,
+               {{"points", index.size()}, {"encodedBytes", int(index.encode().size())}});
+    if (index.isEmpty()) return;
+
+    constexpr int kLookups = 100000;
+    const quint64 lastSample = index.at(index.size() - 1).sample;
+    std::vector<quint64> samples(kLookups);
+    QRandomGenerator rng(17);
+    for (auto& s : samples) s = rng.bounded(lastSample);
+    quint64 sink = 0;
+    const Timing lookup = measure(repeat, nullptr, [&] {
+        for (quint64 s : samples) sink += index.floor(s)->offset;
+    });
+    report.add("seekIndexLookup", 0, false, lookup, kLookups, {{"checksum", QString::number(sink % 1000)}});
+
+    constexpr int kSeeks = 50;
+    std::vector<std::int16_t> pcm(4410 * 2);
+    auto seeks = [&](const char* name, const SeekIndex& with) {
+        auto file = PlaybackEngine::openFile(path, with);
+        if (!file) return;
+        std::vector<sf::Time> targets(kSeeks);
+        QRandomGenerator pick(19);
+        for (auto& t : targets) t = sf::microseconds(pick.bounded(file->getDuration().asMicroseconds()));
+        const Timing t = measure(repeat, nullptr, [&] {
+            for (sf::Time target : targets) {
+                file->seek(target);
+                file->read(pcm.data(), pcm.size());
+            }
+        });
+        report.add(name, 0, false, t, kSeeks, {{"msPerSeek", t.medianMs / kSeeks}});
+    };
+    seeks("seekPlain", SeekIndex());
+    seeks("seekIndexed", index);
+}
+
+QVector<int> parseSizes(const QString& text) {
+    QVector<int> out;
+    for (QString s : text.split(',', Qt::SkipEmptyParts)) {
+        s = s.trimmed().toLower();
+        int mul = 1;
+        if (s.endsWith('k')) { mul = 1000; s.chop(1); }
+        else if (s.endsWith('m')) { mul = 1000000; s.chop(1); }
+        bool ok = false;
+        const int n = s.toInt(&ok);
+        if (ok && n > 0) out << n * mul;
+    }
+    return out;
+}
+
+} // namespace
+
+int main(int argc, char* argv[]) {
+    QCoreApplication app(argc, argv); // no display needed
+    QCoreApplication::setApplicationName("QtMusicPlayerBench");
+
+    // Keep the library cache and any other app data away from the user's.
+    QStandardPaths::setTestModeEnabled(true);
+
+    QCommandLineParser cli;
+    cli.setApplicationDescription("Headless benchmarks over synthetic music libraries.");
+    cli.addHelpOption();
+    QCommandLineOption sizesOpt("sizes", "Library sizes, e.g. 1k,10k,100k,1M.", "list", "1k,10k,100k,1M");
+    QCommandLineOption diskMaxOpt("disk-max", "Largest library written to disk for scan benchmarks.", "n", "100k");
+    QCommandLineOption repeatOpt("repeat", "Runs per measurement (median is reported).", "n", "3");
+    QCommandLineOption outOpt("out", "JSON results file.", "file", "bench-results.json");
+    QCommandLineOption labelOpt("label", "Free-form label stored in the results (e.g. a commit id).", "text");
+    QCommandLineOption noDiskOpt("no-disk", "Skip the on-disk scan and seek benchmarks.");
+    cli.addOptions({sizesOpt, diskMaxOpt, repeatOpt, outOpt, labelOpt, noDiskOpt});
+    cli.process(app);
+
+    const QVector<int> sizes = parseSizes(cli.value(sizesOpt));
+    const QVector<int> diskMaxList = parseSizes(cli.value(diskMaxOpt));
+    const int diskMax = diskMaxList.isEmpty() ? 0 : diskMaxList.first();
+    const int repeat = std::max(1, cli.value(repeatOpt).toInt());
+
+    Report report;
+    benchLoudness(report, repeat);
+    benchPeaks(report, repeat);
+    benchDsp(report, repeat);
+    if (!cli.isSet(noDiskOpt)) benchSeek(report, repeat);
+    for (int n : sizes) {
+        for (bool lyrics : {false, true}) {
+            const QVector<ScannedTrack> tracks = SynthLibrary::makeTracks(n, lyrics);
+
+            benchParse(report, tracks, lyrics, repeat);
+            benchSort(report, tracks, lyrics, repeat);
+            benchSortColumns(report, tracks, lyrics, repeat);
+            benchGrams(report, tracks, lyrics, repeat);
+            benchImport(report, tracks, lyrics, repeat);
+            benchFetch(report, tracks, lyrics, repeat);
+            benchRemove(report, tracks, lyrics, repeat);
+            benchPlayQueue(report, tracks, lyrics, repeat);
+            benchShuffle(report, tracks, lyrics, repeat);
+            benchFilter(report, tracks, lyrics, repeat);
+
+            if (!cli.isSet(noDiskOpt) && n <= diskMax) benchScan(report, n, lyrics);
+        }
+    }
+
+    const QString out = cli.value(outOpt);
+    if (!report.write(out, cli.value(labelOpt), repeat)) {
+        std::fprintf(stderr, "could not write %s\n", qPrintable(out));
+        return 1;
+    }
+    std::printf("results written to %s\n", qPrintable(out));
+    return 0;
+}
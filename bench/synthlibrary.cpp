@@ -0,0 +1,262 @@
+/*
+ * Author: Itoro Ifon, jason Hippolite, Prince Umeh
+ * Date: 2026-10-16
+ * Course/Assignment: C++ Project - Qt Music Player
+ * File: synthlibrary.cpp
+ * Purpose: Implements the synthetic library generator used by the benchmarks.
+ */
+#include "synthlibrary.h"
+#include "lyricsstore.h"
+#include "searchindex.h"
+
+#include <QDir>
+#include <QFile>
+#include <QRandomGenerator>
+#include <QtEndian>
+
+#include <algorithm>
+
+namespace {
+
+// ========================= Vocabulary =========================
+const char* const kSyllables[] = {"ka", "lo", "mi", "ra", "ne", "to", "su", "vi", "de", "an",
+                                  "or", "el", "ba", "qu", "zi", "po", "ly", "ce", "fa", "um"};
+constexpr int kSyllableCount = int(sizeof(kSyllables) / sizeof(kSyllables[0]));
+
+QString word(QRandomGenerator& rng) {
+    QString w;
+    const int parts = 2 + int(rng.bounded(2));
+    for (int i = 0; i < parts; ++i) w += QLatin1String(kSyllables[rng.bounded(kSyllableCount)]);
+    return w;
+}
+
+QString words(QRandomGenerator& rng, int count) {
+    QStringList out;
+    for (int i = 0; i < count; ++i) out << word(rng);
+    out[0][0] = out[0][0].toUpper();
+    return out.join(' ');
+}
+
+struct Meta {
+    QString artist, album, title, lyrics;
+    int trackNumber = 0;
+    bool artistInName = false;
+};
+
+// Albums of ~12 tracks by ~200 artists; one generator per track keeps every
+// track independent of the total count.
+Meta metaFor(int i, bool lyrics, quint32 seed) {
+    QRandomGenerator albumRng(seed * 7919u + quint32(i / 12));
+    QRandomGenerator artistRng(seed * 104729u + quint32((i / 12) % 200));
+    QRandomGenerator rng(seed * 15485863u + quint32(i));
+
+    Meta m;
+    m.artist = words(artistRng, 1 + int(artistRng.bounded(2)));
+    m.album = words(albumRng, 1 + int(albumRng.bounded(3)));
+    m.title = words(rng, 1 + int(rng.bounded(4)));
+    m.trackNumber = i % 12 + 1;
+    m.artistInName = (i % 2) == 0;
+
+    if (lyrics) {
+        QStringList lines;
+        for (int l = 0; l < 6; ++l)
+            lines << QString("[%1:%2.00] ").arg(l / 6).arg((l * 10) % 60, 2, 10, QChar('0')) + words(rng, 6);
+        m.lyrics = lines.join('\n');
+    }
+    return m;
+}
+
+QString fileBase(int i, const Meta& m) {
+    if (m.artistInName) return m.artist + " - " + m.title + QString(" (%1)").arg(i);
+    return QString("%1 %2 (%3)").arg(m.trackNumber, 2, 10, QChar('0')).arg(m.title).arg(i);
+}
+
+// ========================= WAV writer =========================
+void appendLe32(QByteArray& b, quint32 v) {
+    const quint32 le = qToLittleEndian(v);
+    b.append(reinterpret_cast<const char*>(&le), 4);
+}
+
+void appendLe16(QByteArray& b, quint16 v) {
+    const quint16 le = qToLittleEndian(v);
+    b.append(reinterpret_cast<const char*>(&le), 2);
+}
+
+void appendInfo(QByteArray& list, const char* id, const QString& text) {
+    QByteArray utf8 = text.toUtf8();
+    utf8.append('\0');
+    list.append(id, 4);
+    appendLe32(list, quint32(utf8.size()));
+    list.append(utf8);
+    if (utf8.size() & 1) list.append('\0');
+}
+
+QByteArray wavFile(const Meta& m) {
+    QByteArray fmt;
+    appendLe16(fmt, 1);       // PCM
+    appendLe16(fmt, 1);       // mono
+    appendLe32(fmt, 44100);
+    appendLe32(fmt, 88200);   // byte rate
+    appendLe16(fmt, 2);       // block align
+    appendLe16(fmt, 16);
+
+    QByteArray list("INFO");
+    appendInfo(list, "INAM", m.title);
+    appendInfo(list, "IART", m.artist);
+    appendInfo(list, "IPRD", m.album);
+    appendInfo(list, "ITRK", QString::number(m.trackNumber));
+
+    QByteArray data(4410 * 2, '\0'); // 100 ms of silence
+
+    QByteArray body("WAVE");
+    body.append("fmt ", 4);
+    appendLe32(body, quint32(fmt.size()));
+    body.append(fmt);
+    body.append("LIST", 4);
+    appendLe32(body, quint32(list.size()));
+    body.append(list);
+    body.append("data", 4);
+    appendLe32(body, quint32(data.size()));
+    body.append(data);
+
+    QByteArray out("RIFF");
+    appendLe32(out, quint32(body.size()));
+    out.append(body);
+    return out;
+}
+
+// ========================= FLAC writer =========================
+void appendBe(QByteArray& b, quint64 v, int bytes) {
+    for (int i = bytes - 1; i >= 0; --i) b.append(char((v >> (8 * i)) & 0xff));
+}
+
+quint8 crc8(const QByteArray& b) {
+    quint8 crc = 0;
+    for (char c : b) {
+        crc ^= quint8(c);
+        for (int bit = 0; bit < 8; ++bit) crc = quint8((crc & 0x80) ? (crc << 1) ^ 0x07 : crc << 1);
+    }
+    return crc;
+}
+
+quint16 crc16(const QByteArray& b) {
+    quint16 crc = 0;
+    for (char c : b) {
+        crc ^= quint16(quint8(c)) << 8;
+        for (int bit = 0; bit < 8; ++bit) crc = quint16((crc & 0x8000) ? (crc << 1) ^ 0x8005 : crc << 1);
+    }
+    return crc;
+}
+
+// FLAC's UTF-8 style frame number.
+void appendCodedNumber(QByteArray& b, quint32 n) {
+    if (n < 0x80) {
+        b.append(char(n));
+        return;
+    }
+    int bytes = 2;
+    while (n >= (1u << (5 * bytes + 1))) ++bytes;
+    b.append(char(((0xff00 >> bytes) & 0xff) | (n >> (6 * (bytes - 1)))));
+    for (int i = bytes - 2; i >= 0; --i) b.append(char(0x80 | ((n >> (6 * i)) & 0x3f)));
+}
+
+} // namespace
+
+// ========================= Public =========================
+QVector<ScannedTrack> SynthLibrary::makeTracks(int count, bool lyrics, quint32 seed) {
+    QVector<ScannedTrack> out;
+    out.reserve(count);
+    for (int i = 0; i < count; ++i) {
+        const Meta m = metaFor(i, lyrics, seed);
+        ScannedTrack t;
+        t.path = QString("/synth/%1/%2.wav").arg(i / 500, 4, 10, QChar('0')).arg(fileBase(i, m));
+        t.title = m.title;
+        t.artist = m.artist;
+        t.album = m.album;
+        t.trackNumber = m.trackNumber;
+        t.durationMs = 100;
+        t.lyrics = lyrics ? LibraryScanner::cleanLyricsText(m.lyrics) : QString();
+        t.grams = SearchIndex::extractGrams(t.title, t.artist, t.lyrics);
+        t.packedLyrics = LyricsStore::pack(t.lyrics);
+        t.sortKeys = CollationKey::forTrack(t.title, t.artist, t.album, t.path);
+        out << t;
+    }
+    return out;
+}
+
+QStringList SynthLibrary::writeFiles(const QString& dir, int count, bool lyrics, quint32 seed) {
+    QStringList paths;
+    paths.reserve(count);
+    QDir root(dir);
+
+    for (int i = 0; i < count; ++i) {
+        const Meta m = metaFor(i, lyrics, seed);
+        const QString sub = QString("%1").arg(i / 500, 4, 10, QChar('0'));
+        if (i % 500 == 0) root.mkpath(sub);
+
+        const QString base = root.filePath(sub + '/' + fileBase(i, m));
+        QFile audio(base + ".wav");
+        if (audio.open(QIODevice::WriteOnly)) audio.write(wavFile(m));
+        paths << audio.fileName();
+
+        if (lyrics) {
+            QFile lrc(base + ".lrc");
+            if (lrc.open(QIODevice::WriteOnly)) lrc.write(m.lyrics.toUtf8());
+        }
+    }
+    return paths;
+}
+
+QString SynthLibrary::commonWord(int n) {
+    // Two-syllable words built from the first syllables are frequent.
+    return QLatin1String(kSyllables[n % kSyllableCount]) + QLatin1String(kSyllables[(n + 1) % kSyllableCount]);
+}
+
+QString SynthLibrary::writeLongFlac(const QString& dir, int seconds, quint32 seed) {
+    constexpr quint32 kRate = 44100;
+    constexpr quint32 kBlock = 4096;
+    const quint64 total = quint64(kRate) * quint64(seconds);
+
+    QFile f(QDir(dir).filePath("long.flac"));
+    if (!f.open(QIODevice::WriteOnly)) return {};
+
+    QByteArray head("fLaC");
+    head.append(char(0x80)); // STREAMINFO, last block
+    appendBe(head, 34, 3);
+    appendBe(head, kBlock, 2);
+    appendBe(head, kBlock, 2);
+    appendBe(head, 0, 3); // frame sizes unknown
+    appendBe(head, 0, 3);
+    appendBe(head, quint64(kRate) << 44 | quint64(1) << 41 | quint64(15) << 36 | total, 8);
+    head.append(QByteArray(16, '\0')); // no MD5
+    f.write(head);
+
+    QRandomGenerator rng(seed);
+    QByteArray frame;
+    quint32 number = 0;
+    for (quint64 s = 0; s < total; s += kBlock, ++number) {
+        const quint32 n = quint32(std::min<quint64>(kBlock, total - s));
+        frame.clear();
+        frame.append(char(0xff));
+        frame.append(char(0xf8));                         // fixed block size
+        frame.append(char((n == kBlock ? 12 : 7) << 4 | 9)); // 4096 or explicit; 44.1 kHz
+        frame.append(char(1 << 4 | 4 << 1));              // two channels, 16 bit
+        appendCodedNumber(frame, number);
+        if (n != kBlock) appendBe(frame, n - 1, 2);
+        frame.append(char(crc8(frame)));
+
+        const bool noisy = number % 8 == 0;
+        for (int ch = 0; ch < 2; ++ch) {
+            if (noisy) {
+                frame.append(char(0x02)); // VERBATIM
+                for (quint32 i = 0; i < n; ++i) appendBe(frame, quint16(qint16(int(rng.bounded(4000)) - 2000)), 2);
+            } else {
+                frame.append(char(0x00)); // CONSTANT
+                appendBe(frame, quint16(qint16(int(rng.bounded(600)) - 300)), 2);
+            }
+        }
+        appendBe(frame, crc16(frame), 2);
+        if (f.write(frame) != frame.size()) return {};
+    }
+    return f.fileName();
+}
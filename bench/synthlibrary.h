@@ -0,0 +1,41 @@
+/*
+ * Author: Itoro Ifon, jason Hippolite, Prince Umeh
+ * Date: 2026-10-16
+ * Course/Assignment: C++ Project - Qt Music Player
+ * File: synthlibrary.h
+ * Purpose: Declares SynthLibrary, which fabricates deterministic music
+ *          libraries for the benchmark suite, in memory or on disk.
+ */
+#pragma once
+
+#include <QString>
+#include <QStringList>
+#include <QVector>
+
+#include "libraryscanner.h"
+
+// Class: SynthLibrary
+// Purpose: Generates N plausible tracks from a fixed seed: pseudo-words for
+//          artists, albums and titles, half the files named "Artist - Title",
+//          half "NN Title" with the artist only in the tags, and optional
+//          lyrics. The same (count, lyrics, seed) always gives the same
+//          library, so runs on different commits are comparable.
+class SynthLibrary {
+public:
+    // Tracks as the scanner would deliver them (search grams included).
+    static QVector<ScannedTrack> makeTracks(int count, bool lyrics, quint32 seed = 1);
+
+    // Writes tiny tagged WAV files (RIFF LIST/INFO) under `dir`, 500 per
+    // sub-folder, plus a .lrc sidecar each when `lyrics` is set.
+    // Returns the audio file paths.
+    static QStringList writeFiles(const QString& dir, int count, bool lyrics, quint32 seed = 1);
+
+    // Writes an untagged stereo 44.1 kHz FLAC file of `seconds` without a
+    // SEEKTABLE, the case SeekIndex exists for. Mostly constant frames with
+    // a stretch of verbatim noise every eighth frame, so bytes per second
+    // vary along the file. Returns the path, or an empty string on failure.
+    static QString writeLongFlac(const QString& dir, int seconds, quint32 seed = 1);
+
+    // A word that occurs in the generated titles/lyrics, for search queries.
+    static QString commonWord(int n = 0);
+};
@@ -0,0 +1,159 @@
+/*
+ * Author: Itoro Ifon, jason Hippolite, Prince Umeh
+ * Date: 2026-10-16
+ * Course/Assignment: C++ Project - Qt Music Player
+ * File: collationkey.cpp
+ * Purpose: Implements collation keys and the parallel stable sort.
+ */
+#include "collationkey.h"
+
+#include <QSemaphore>
+#include <QThread>
+#include <QThreadPool>
+
+#include <algorithm>
+#include <functional>
+#include <vector>
+
+namespace {
+
+// ========================= Keys =========================
+void appendDigits(QByteArray& out, const QByteArray& digits) {
+    int skip = 0;
+    while (skip + 1 < digits.size() && digits[skip] == '0') ++skip;
+    const int len = std::min<int>(digits.size() - skip, 255);
+    out.append('0');
+    out.append(char(len));
+    out.append(digits.constData() + skip, len);
+}
+
+// ========================= Sorting =========================
+struct Item {
+    quint64 prefix = 0; // first key bytes, big-endian, so integer order is byte order
+    int row = 0;
+};
+
+quint64 prefixOf(const QByteArray& key) {
+    quint64 v = 0;
+    const int n = std::min<int>(key.size(), 8);
+    for (int i = 0; i < 8; ++i) v = v << 8 | (i < n ? quint8(key[i]) : 0);
+    return v;
+}
+
+// Runs fn(0..count-1), using idle global pool threads; whatever cannot be
+// started there runs on the calling thread, so this never waits on a pool
+// it may itself be running on.
+void runParallel(int count, const std::function<void(int)>& fn) {
+    QSemaphore done;
+    int started = 0;
+    for (int i = 1; i < count; ++i) {
+        if (QThreadPool::globalInstance()->tryStart([&fn, &done, i] {
+                fn(i);
+                done.release();
+            })) {
+            ++started;
+        } else {
+            fn(i);
+        }
+    }
+    if (count > 0) fn(0);
+    done.acquire(started);
+}
+
+template <typename Less>
+void stableSort(std::vector<Item>& items, Less less) {
+    const int n = int(items.size());
+    const int parts = n < CollationKey::kParallelThreshold ? 1 : std::clamp(QThread::idealThreadCount(), 1, 16);
+    if (parts == 1) {
+        std::stable_sort(items.begin(), items.end(), less);
+        return;
+    }
+
+    std::vector<int> bounds(std::size_t(parts) + 1);
+    for (int p = 0; p <= parts; ++p) bounds[std::size_t(p)] = int(qint64(n) * p / parts);
+    runParallel(parts, [&](int p) {
+        std::stable_sort(items.begin() + bounds[std::size_t(p)], items.begin() + bounds[std::size_t(p) + 1], less);
+    });
+
+    // Merge neighbouring runs; std::merge prefers the left run on ties, so
+    // the result stays stable.
+    std::vector<Item> buffer(items.size());
+    for (int width = 1; width < parts; width *= 2) {
+        const int pairs = (parts + 2 * width - 1) / (2 * width);
+        runParallel(pairs, [&](int k) {
+            const int p = k * 2 * width;
+            const int lo = bounds[std::size_t(p)];
+            const int mid = bounds[std::size_t(std::min(p + width, parts))];
+            const int hi = bounds[std::size_t(std::min(p + 2 * width, parts))];
+            std::merge(items.begin() + lo, items.begin() + mid, items.begin() + mid, items.begin() + hi,
+                       buffer.begin() + lo, less);
+        });
+        items.swap(buffer);
+    }
+}
+
+QVector<int> rowsOf(const std::vector<Item>& items) {
+    QVector<int> rows;
+    rows.reserve(int(items.size()));
+    for (const Item& it : items) rows.append(it.row);
+    return rows;
+}
+
+} // namespace
+
+QByteArray CollationKey::make(const QString& text) {
+    const QString decomposed = text.normalized(QString::NormalizationForm_KD);
+
+    QByteArray out;
+    out.reserve(decomposed.size() + 4);
+    QByteArray digits;
+    QString folded;
+    for (const QChar ch : decomposed) {
+        const int digit = ch.digitValue();
+        if (digit >= 0 && ch.category() == QChar::Number_DecimalDigit) {
+            if (!folded.isEmpty()) {
+                out.append(folded.toUtf8());
+                folded.clear();
+            }
+            digits.append(char('0' + digit));
+            continue;
+        }
+        if (!digits.isEmpty()) {
+            appendDigits(out, digits);
+            digits.clear();
+        }
+        if (ch.isMark()) continue;
+        folded.append(ch.toCaseFolded());
+    }
+    if (!digits.isEmpty()) appendDigits(out, digits);
+    if (!folded.isEmpty()) out.append(folded.toUtf8());
+    return out;
+}
+
+SortKeys CollationKey::forTrack(const QString& title, const QString& artist, const QString& album, const QString& path) {
+    return {make(title), make(artist), make(album), make(path)};
+}
+
+QVector<int> CollationKey::order(const QVector<const QByteArray*>& keys, Qt::SortOrder direction) {
+    std::vector<Item> items(std::size_t(keys.size()));
+    for (int i = 0; i < keys.size(); ++i) items[std::size_t(i)] = {prefixOf(*keys[i]), i};
+
+    auto less = [&keys](const Item& a, const Item& b) {
+        if (a.prefix != b.prefix) return a.prefix < b.prefix;
+        return *keys[a.row] < *keys[b.row];
+    };
+    if (direction == Qt::AscendingOrder) stableSort(items, less);
+    else stableSort(items, [&less](const Item& a, const Item& b) { return less(b, a); });
+    return rowsOf(items);
+}
+
+QVector<int> CollationKey::order(const QVector<qint64>& values, Qt::SortOrder direction) {
+    std::vector<Item> items(std::size_t(values.size()));
+    for (int i = 0; i < values.size(); ++i)
+        items[std::size_t(i)] = {quint64(values[i]) ^ (quint64(1) << 63), i}; // signed -> unsigned order
+
+    auto less = [](const Item& a, const Item& b) { return a.prefix < b.prefix; };
+    if (direction == Qt::AscendingOrder) stableSort(items, less);
+    else stableSort(items, [](const Item& a, const Item& b) { return b.prefix < a.prefix; });
+    return rowsOf(items);
+}
@@ -0,0 +1,50 @@
+/*
+ * Author: Itoro Ifon, jason Hippolite, Prince Umeh
+ * Date: 2026-10-16
+ * Course/Assignment: C++ Project - Qt Music Player
+ * File: collationkey.h
+ * Purpose: Declares CollationKey, byte-comparable sort keys for library
+ *          text, and the parallel stable sort the playlist is ordered with.
+ */
+#pragma once
+
+#include <QByteArray>
+#include <QString>
+#include <QVector>
+
+// Struct: SortKeys
+// Purpose: Precomputed CollationKey::make() of one track's sortable text.
+struct SortKeys {
+    QByteArray title;
+    QByteArray artist;
+    QByteArray album;
+    QByteArray path;
+};
+
+// Class: CollationKey
+// Purpose: Turns text into a key whose plain byte order (memcmp) is the
+//          order a listener expects: case- and accent-insensitive, with runs
+//          of digits compared by value ("Track 2" before "Track 10").
+// Notes: Keys are NFKD with combining marks dropped and case folded, as
+//        UTF-8; each digit run becomes '0', its length and its digits
+//        without leading zeros. That is the primary strength of most
+//        locales' collation, not the full per-locale tailoring, but it is
+//        computed once per track (on the scan workers) and then compared
+//        without allocating, which QCollator's opaque sort keys cannot be
+//        as bytes. make() is thread-safe.
+//        order() returns the stable sorted permutation. Above
+//        kParallelThreshold items it sorts slices on the global thread pool
+//        and merges them pairwise, also in parallel; the first eight key
+//        bytes are packed into an integer so most comparisons never touch
+//        the keys.
+class CollationKey {
+public:
+    static QByteArray make(const QString& text);
+    static SortKeys forTrack(const QString& title, const QString& artist, const QString& album, const QString& path);
+
+    // Row indices in sorted order; ties keep their current order.
+    static QVector<int> order(const QVector<const QByteArray*>& keys, Qt::SortOrder direction = Qt::AscendingOrder);
+    static QVector<int> order(const QVector<qint64>& values, Qt::SortOrder direction = Qt::AscendingOrder);
+
+    static constexpr int kParallelThreshold = 16384;
+};
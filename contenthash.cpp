@@ -0,0 +1,232 @@
+/*
+ * Author: Itoro Ifon, jason Hippolite, Prince Umeh
+ * Date: 2026-10-16
+ * Course/Assignment: C++ Project - Qt Music Player
+ * File: contenthash.cpp
+ * Purpose: Implements the tag-skipping payload walk and XXH64.
+ */
+#include "contenthash.h"
+
+#include <QFile>
+#include <QByteArray>
+#include <QSemaphore>
+#include <QtEndian>
+
+#include <algorithm>
+#include <cstring>
+
+namespace {
+
+// ========================= XXH64 =========================
+constexpr quint64 kPrime1 = 0x9E3779B185EBCA87ULL;
+constexpr quint64 kPrime2 = 0xC2B2AE3D27D4EB4FULL;
+constexpr quint64 kPrime3 = 0x165667B19E3779F9ULL;
+constexpr quint64 kPrime4 = 0x85EBCA77C2B2AE63ULL;
+constexpr quint64 kPrime5 = 0x27D4EB2F165667C5ULL;
+
+quint64 rotl(quint64 x, int r) { return (x << r) | (x >> (64 - r)); }
+quint64 read64(const uchar* p) { return qFromLittleEndian<quint64>(p); }
+quint32 read32(const uchar* p) { return qFromLittleEndian<quint32>(p); }
+
+quint64 round64(quint64 acc, quint64 input) {
+    acc += input * kPrime2;
+    return rotl(acc, 31) * kPrime1;
+}
+
+quint64 mergeRound(quint64 acc, quint64 val) {
+    acc ^= round64(0, val);
+    return acc * kPrime1 + kPrime4;
+}
+
+// Class: Xxh64
+// Purpose: Streaming XXH64 (seed 0); update() takes any split of the input.
+class Xxh64 {
+public:
+    void update(const uchar* p, qint64 n) {
+        total += quint64(n);
+        if (held + n < 32) {
+            std::memcpy(buffer + held, p, size_t(n));
+            held += int(n);
+            return;
+        }
+        if (held > 0) {
+            const int fill = 32 - held;
+            std::memcpy(buffer + held, p, size_t(fill));
+            stripe(buffer);
+            p += fill;
+            n -= fill;
+            held = 0;
+        }
+        for (; n >= 32; p += 32, n -= 32) stripe(p);
+        std::memcpy(buffer, p, size_t(n));
+        held = int(n);
+    }
+
+    quint64 digest() const {
+        quint64 h = total >= 32
+            ? mergeRound(mergeRound(mergeRound(mergeRound(rotl(v[0], 1) + rotl(v[1], 7) + rotl(v[2], 12) + rotl(v[3], 18),
+                                                          v[0]), v[1]), v[2]), v[3])
+            : kPrime5;
+        h += total;
+
+        const uchar* p = buffer;
+        int n = held;
+        for (; n >= 8; p += 8, n -= 8) h = rotl(h ^ round64(0, read64(p)), 27) * kPrime1 + kPrime4;
+        if (n >= 4) {
+            h = rotl(h ^ (quint64(read32(p)) * kPrime1), 23) * kPrime2 + kPrime3;
+            p += 4;
+            n -= 4;
+        }
+        for (; n > 0; ++p, --n) h = rotl(h ^ (quint64(*p) * kPrime5), 11) * kPrime1;
+
+        h ^= h >> 33;
+        h *= kPrime2;
+        h ^= h >> 29;
+        h *= kPrime3;
+        h ^= h >> 32;
+        return h;
+    }
+
+private:
+    void stripe(const uchar* p) {
+        for (int i = 0; i < 4; ++i) v[i] = round64(v[i], read64(p + 8 * i));
+    }
+
+    quint64 v[4] = {kPrime1 + kPrime2, kPrime2, 0, quint64(0) - kPrime1};
+    uchar buffer[32] = {};
+    int held = 0;
+    quint64 total = 0;
+};
+
+// ========================= Payload =========================
+QByteArray readAt(QFile& f, qint64 off, qint64 len) {
+    if (off < 0 || len <= 0 || !f.seek(off)) return {};
+    return f.read(len);
+}
+
+quint32 be32(const char* b) { return qFromBigEndian<quint32>(b); }
+quint32 le32(const char* b) { return qFromLittleEndian<quint32>(b); }
+quint32 be24(const char* b) { return quint32(uchar(b[0])) << 16 | quint32(uchar(b[1])) << 8 | uchar(b[2]); }
+quint32 synchsafe32(const char* b) {
+    return quint32(b[0] & 0x7f) << 21 | quint32(b[1] & 0x7f) << 14 | quint32(b[2] & 0x7f) << 7 | quint32(b[3] & 0x7f);
+}
+
+void addRange(QVector<ContentHash::Range>& out, qint64 off, qint64 len, qint64 end) {
+    len = std::min(len, end - off);
+    if (off < 0 || len <= 0) return;
+    if (!out.isEmpty() && out.last().offset + out.last().size == off) {
+        out.last().size += len; // adjacent: one run of reads
+        return;
+    }
+    out.push_back({off, len});
+}
+
+// RIFF (little-endian sizes) and IFF/AIFF (big-endian) share the chunk walk.
+void chunks(QFile& f, qint64 start, qint64 end, bool bigEndian, const char* a, const char* b,
+            QVector<ContentHash::Range>& out) {
+    qint64 pos = start;
+    while (pos + 8 <= end) {
+        const QByteArray h = readAt(f, pos, 8);
+        if (h.size() < 8) break;
+        const qint64 len = bigEndian ? be32(h.constData() + 4) : le32(h.constData() + 4);
+        const QByteArray id = h.left(4);
+        if (id == a || id == b) addRange(out, pos + 8, len, end);
+        pos += 8 + len + (len & 1);
+    }
+}
+
+// Header pages carry granule position 0; the first page with another value
+// holds audio, and so does every page after it. Page headers are left out:
+// their sequence numbers and CRCs shift when a tag grows by a page.
+void oggPages(QFile& f, qint64 start, qint64 end, QVector<ContentHash::Range>& out) {
+    qint64 pos = start;
+    bool audio = false;
+    while (pos + 27 <= end) {
+        const QByteArray h = readAt(f, pos, 27);
+        if (h.size() < 27 || !h.startsWith("OggS")) break;
+        const int segments = uchar(h[26]);
+        const QByteArray table = readAt(f, pos + 27, segments);
+        if (table.size() < segments) break;
+        qint64 body = 0;
+        for (char s : table) body += uchar(s);
+
+        const qint64 granule = qFromLittleEndian<qint64>(h.constData() + 6);
+        audio = audio || granule != 0;
+        if (audio) addRange(out, pos + 27 + segments, body, end);
+        pos += 27 + segments + body;
+    }
+}
+
+} // namespace
+
+// ========================= Entry points =========================
+QVector<ContentHash::Range> ContentHash::payload(QFile& f) {
+    QVector<Range> out;
+    qint64 start = 0;
+    qint64 end = f.size();
+
+    const QByteArray head = readAt(f, 0, 12);
+    if (head.startsWith("ID3") && head.size() >= 10) {
+        start = 10 + qint64(synchsafe32(head.constData() + 6));
+        if (head[5] & 0x10) start += 10; // footer
+    }
+    const QByteArray tail = readAt(f, end - 128, 3);
+    if (tail == "TAG" && end - 128 >= start) end -= 128;
+    if (start >= end) return out;
+
+    const QByteArray magic = start == 0 ? head : readAt(f, start, 12);
+    if (magic.startsWith("fLaC")) {
+        qint64 pos = start + 4;
+        for (;;) {
+            const QByteArray h = readAt(f, pos, 4);
+            if (h.size() < 4) return out; // no audio
+            pos += 4 + be24(h.constData() + 1);
+            if (h[0] & 0x80) break; // last metadata block
+        }
+        addRange(out, pos, end - pos, end);
+    } else if (magic.startsWith("OggS")) {
+        oggPages(f, start, end, out);
+    } else if (magic.startsWith("RIFF") && magic.mid(8, 4) == "WAVE") {
+        chunks(f, start + 12, end, false, "fmt ", "data", out);
+    } else if (magic.startsWith("FORM") && (magic.mid(8, 4) == "AIFF" || magic.mid(8, 4) == "AIFC")) {
+        chunks(f, start + 12, end, true, "COMM", "SSND", out);
+    } else if (magic.startsWith(".snd") && magic.size() >= 8) {
+        const qint64 offset = start + be32(magic.constData() + 4);
+        addRange(out, offset, end - offset, end);
+    } else {
+        addRange(out, start, end - start, end);
+    }
+    return out;
+}
+
+quint64 ContentHash::ofFile(const QString& path, QSemaphore* readSlots) {
+    QFile f(path);
+    if (!f.open(QIODevice::ReadOnly)) return 0;
+
+    if (readSlots) readSlots->acquire();
+    const QVector<Range> ranges = payload(f);
+    if (readSlots) readSlots->release();
+    if (ranges.isEmpty()) return 0; // no audio found
+
+    Xxh64 hash;
+    QByteArray chunk(int(std::min<qint64>(kChunkBytes, f.size())), Qt::Uninitialized);
+    for (const Range& r : ranges) {
+        if (!f.seek(r.offset)) return 0;
+        for (qint64 left = r.size; left > 0;) {
+            if (readSlots) readSlots->acquire();
+            const qint64 got = f.read(chunk.data(), std::min<qint64>(left, chunk.size()));
+            if (readSlots) readSlots->release();
+            if (got <= 0) return 0;
+            hash.update(reinterpret_cast<const uchar*>(chunk.constData()), got);
+            left -= got;
+        }
+    }
+    const quint64 h = hash.digest();
+    return h != 0 ? h : 1;
+}
+
+quint64 ContentHash::ofBytes(const char* data, qint64 size) {
+    Xxh64 hash;
+    hash.update(reinterpret_cast<const uchar*>(data), size);
+    return hash.digest();
+}
@@ -0,0 +1,46 @@
+/*
+ * Author: Itoro Ifon, jason Hippolite, Prince Umeh
+ * Date: 2026-10-16
+ * Course/Assignment: C++ Project - Qt Music Player
+ * File: contenthash.h
+ * Purpose: Declares ContentHash, a fingerprint of a file's audio payload
+ *          that ignores its tags, for finding duplicate tracks.
+ */
+#pragma once
+
+#include <QString>
+#include <QVector>
+
+class QFile;
+class QSemaphore;
+
+// Class: ContentHash
+// Purpose: 64-bit XXH64 over the bytes that carry the audio, so two copies
+//          of a song match even after one was retagged or renamed:
+//            FLAC - everything after the metadata blocks
+//            Ogg  - page payloads from the first audio page on
+//            WAV  - fmt and data chunks
+//            AIFF - COMM and SSND chunks
+//            AU   - everything after the header
+//          A leading ID3v2 and a trailing ID3v1 tag are skipped on any
+//          format; unknown formats hash the rest of the file.
+// Notes: Reads kChunkBytes at a time, holding one of `readSlots` (if given)
+//        for each read, so many hashing threads share a bounded number of
+//        reads in flight. Stateless and thread-safe. 0 is never a valid
+//        hash; it means "not hashed".
+class ContentHash {
+public:
+    struct Range {
+        qint64 offset = 0;
+        qint64 size = 0;
+    };
+
+    // 0 when the file cannot be read.
+    static quint64 ofFile(const QString& path, QSemaphore* readSlots = nullptr);
+    // The byte ranges ofFile() hashes, in file order.
+    static QVector<Range> payload(QFile& file);
+    // XXH64 of a buffer (seed 0), as used for the payload.
+    static quint64 ofBytes(const char* data, qint64 size);
+
+    static constexpr qint64 kChunkBytes = 1024 * 1024;
+};
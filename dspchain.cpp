@@ -0,0 +1,254 @@
+/*
+ * Author: Itoro Ifon, jason Hippolite, Prince Umeh
+ * Date: 2026-10-16
+ * Course/Assignment: C++ Project - Qt Music Player
+ * File: dspchain.cpp
+ * Purpose: Implements the EQ filter design, the per-block processing
+ *          kernels and the cost statistics of the playback DSP chain.
+ */
+#include "dspchain.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+
+namespace {
+
+constexpr double kPi = 3.14159265358979323846;
+
+float dbToLinear(float db) {
+    return float(std::pow(10.0, double(db) / 20.0));
+}
+
+// Relaxed read-modify-write for counters only the audio thread writes.
+template <typename T>
+void bump(std::atomic<T>& a, T by) {
+    a.store(a.load(std::memory_order_relaxed) + by, std::memory_order_relaxed);
+}
+
+template <typename T>
+void raiseTo(std::atomic<T>& a, T v) {
+    if (v > a.load(std::memory_order_relaxed)) a.store(v, std::memory_order_relaxed);
+}
+
+} // namespace
+
+DspChain::DspChain() : incoming(DspParams()) {}
+
+// ========================= GUI side =========================
+void DspChain::setParams(const DspParams& p) {
+    edited = p;
+    incoming.write(p);
+}
+
+DspStats DspChain::stats() const {
+    DspStats s;
+    if (resetRequested.load(std::memory_order_relaxed)) return s; // audio thread hasn't seen it yet
+
+    s.blocks = blocks.load(std::memory_order_relaxed);
+    s.lastUs = double(lastNs.load(std::memory_order_relaxed)) / 1000.0;
+    s.maxUs = double(maxNs.load(std::memory_order_relaxed)) / 1000.0;
+    const std::uint64_t total = sumNs.load(std::memory_order_relaxed);
+    const std::uint64_t audio = sumAudioNs.load(std::memory_order_relaxed);
+    s.avgUs = s.blocks ? double(total) / double(s.blocks) / 1000.0 : 0.0;
+    s.load = audio ? double(total) / double(audio) : 0.0;
+    s.peakLoad = double(peakLoad.load(std::memory_order_relaxed));
+    s.gainReductionDb = float(20.0 * std::log10(double(std::max(1e-6f, minEnvelope.load(std::memory_order_relaxed)))));
+    return s;
+}
+
+void DspChain::resetStats() {
+    resetRequested.store(true, std::memory_order_relaxed);
+}
+
+// ========================= Setup =========================
+void DspChain::prepare(unsigned sampleRate, unsigned channels, std::size_t maxFrames) {
+    rate = std::max(1u, sampleRate);
+    channelCount = std::max(1u, channels);
+    capacity = std::max<std::size_t>(1, maxFrames);
+
+    state.assign(std::size_t(channelCount) * DspParams::kBands, BiquadState());
+    planar.assign(std::size_t(channelCount) * capacity, 0.0f);
+    framePeak.assign(capacity, 0.0f);
+    envelope = 1.0f;
+    bandOn.fill(false);
+
+    // The stream is stopped, so nothing else reads the buffer now.
+    if (const DspParams* p = incoming.read()) active = *p;
+    apply(active);
+}
+
+void DspChain::apply(const DspParams& p) {
+    active = p;
+    preamp = dbToLinear(p.preampDb);
+    ceiling = dbToLinear(p.limiterCeilingDb);
+    releaseCoeff = float(1.0 - std::exp(-1000.0 / (std::max(1.0f, p.limiterReleaseMs) * double(rate))));
+
+    bandsOn = 0;
+    for (int b = 0; b < DspParams::kBands; ++b) {
+        const EqBand& band = p.bands[std::size_t(b)];
+        const bool on = p.eqEnabled && band.gainDb != 0.0f;
+        if (on && !bandOn[std::size_t(b)]) {
+            // A band coming back starts from rest, not from stale history.
+            for (unsigned c = 0; c < channelCount; ++c) state[c * DspParams::kBands + std::size_t(b)] = BiquadState();
+        }
+        bandOn[std::size_t(b)] = on;
+        if (on) {
+            coeffs[std::size_t(b)] = design(band, double(rate));
+            ++bandsOn;
+        }
+    }
+}
+
+// RBJ audio EQ cookbook, normalized by a0.
+DspChain::Coeffs DspChain::design(const EqBand& band, double sampleRate) {
+    const double f = std::clamp(double(band.frequency), 10.0, 0.45 * sampleRate);
+    const double q = std::clamp(double(band.q), 0.1, 20.0);
+    const double a = std::pow(10.0, double(band.gainDb) / 40.0);
+    const double w0 = 2.0 * kPi * f / sampleRate;
+    const double cw = std::cos(w0);
+    const double alpha = std::sin(w0) / (2.0 * q);
+    const double sa = 2.0 * std::sqrt(a) * alpha;
+
+    double b0, b1, b2, a0, a1, a2;
+    switch (band.type) {
+    case EqBand::LowShelf:
+        b0 = a * ((a + 1) - (a - 1) * cw + sa);
+        b1 = 2 * a * ((a - 1) - (a + 1) * cw);
+        b2 = a * ((a + 1) - (a - 1) * cw - sa);
+        a0 = (a + 1) + (a - 1) * cw + sa;
+        a1 = -2 * ((a - 1) + (a + 1) * cw);
+        a2 = (a + 1) + (a - 1) * cw - sa;
+        break;
+    case EqBand::HighShelf:
+        b0 = a * ((a + 1) + (a - 1) * cw + sa);
+        b1 = -2 * a * ((a - 1) + (a + 1) * cw);
+        b2 = a * ((a + 1) + (a - 1) * cw - sa);
+        a0 = (a + 1) - (a - 1) * cw + sa;
+        a1 = 2 * ((a - 1) - (a + 1) * cw);
+        a2 = (a + 1) - (a - 1) * cw - sa;
+        break;
+    case EqBand::Peak:
+    default:
+        b0 = 1 + alpha * a;
+        b1 = -2 * cw;
+        b2 = 1 - alpha * a;
+        a0 = 1 + alpha / a;
+        a1 = -2 * cw;
+        a2 = 1 - alpha / a;
+        break;
+    }
+    return {b0 / a0, b1 / a0, b2 / a0, a1 / a0, a2 / a0};
+}
+
+// ========================= Processing =========================
+void DspChain::process(std::int16_t* interleaved, std::size_t frames, float gain) {
+    if (capacity == 0 || frames == 0) return;
+    const auto start = std::chrono::steady_clock::now();
+
+    if (resetRequested.exchange(false, std::memory_order_relaxed)) {
+        blocks.store(0, std::memory_order_relaxed);
+        lastNs.store(0, std::memory_order_relaxed);
+        maxNs.store(0, std::memory_order_relaxed);
+        sumNs.store(0, std::memory_order_relaxed);
+        sumAudioNs.store(0, std::memory_order_relaxed);
+        peakLoad.store(0.0f, std::memory_order_relaxed);
+        minEnvelope.store(1.0f, std::memory_order_relaxed);
+    }
+    if (const DspParams* p = incoming.read()) apply(*p);
+
+    const float g = gain * preamp;
+    const bool limiting = active.limiterEnabled && ceiling < 1.0f;
+    if (bandsOn > 0 || g != 1.0f || limiting) {
+        for (std::size_t done = 0; done < frames; done += capacity) {
+            const std::size_t n = std::min(capacity, frames - done);
+            runBlock(interleaved + done * channelCount, n, g);
+        }
+    }
+
+    const auto ns = std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - start);
+    record(std::uint64_t(ns.count()), frames);
+}
+
+void DspChain::runBlock(std::int16_t* interleaved, std::size_t n, float gain) {
+    const std::size_t ch = channelCount;
+
+    // De-interleave, scale to [-1, 1) and apply the gain in one pass.
+    const float inScale = gain / 32768.0f;
+    for (std::size_t c = 0; c < ch; ++c) {
+        float* x = planar.data() + c * capacity;
+        const std::int16_t* src = interleaved + c;
+        for (std::size_t i = 0; i < n; ++i) x[i] = float(src[i * ch]) * inScale;
+    }
+
+    if (bandsOn > 0) {
+        for (std::size_t c = 0; c < ch; ++c) {
+            float* x = planar.data() + c * capacity;
+            for (int b = 0; b < DspParams::kBands; ++b) {
+                if (!bandOn[std::size_t(b)]) continue;
+                const Coeffs k = coeffs[std::size_t(b)];
+                BiquadState& st = state[c * DspParams::kBands + std::size_t(b)];
+                double s1 = st.s1, s2 = st.s2;
+                for (std::size_t i = 0; i < n; ++i) { // transposed direct form II
+                    const double in = x[i];
+                    const double out = k.b0 * in + s1;
+                    s1 = k.b1 * in - k.a1 * out + s2;
+                    s2 = k.b2 * in - k.a2 * out;
+                    x[i] = float(out);
+                }
+                // Decaying state would end up denormal in silence, which is slow.
+                st.s1 = std::fabs(s1) < 1e-25 ? 0.0 : s1;
+                st.s2 = std::fabs(s2) < 1e-25 ? 0.0 : s2;
+            }
+        }
+    }
+
+    if (active.limiterEnabled) limit(n);
+
+    // Re-interleave with saturation.
+    for (std::size_t c = 0; c < ch; ++c) {
+        const float* x = planar.data() + c * capacity;
+        std::int16_t* dst = interleaved + c;
+        for (std::size_t i = 0; i < n; ++i)
+            dst[i * ch] = std::int16_t(std::clamp(x[i] * 32768.0f, -32768.0f, 32767.0f));
+    }
+}
+
+// Brickwall peak limiter without lookahead: the gain drops instantly to the
+// level that keeps the loudest channel of a frame at the ceiling, then
+// recovers exponentially. No sample ever exceeds the ceiling.
+void DspChain::limit(std::size_t n) {
+    const std::size_t ch = channelCount;
+    float* m = framePeak.data();
+    std::fill(m, m + n, 0.0f);
+    for (std::size_t c = 0; c < ch; ++c) {
+        const float* x = planar.data() + c * capacity;
+        for (std::size_t i = 0; i < n; ++i) m[i] = std::max(m[i], std::fabs(x[i]));
+    }
+
+    float env = envelope, lowest = 1.0f;
+    for (std::size_t i = 0; i < n; ++i) {
+        const float target = m[i] > ceiling ? ceiling / m[i] : 1.0f;
+        env = target < env ? target : env + (target - env) * releaseCoeff;
+        m[i] = env;
+        lowest = std::min(lowest, env);
+    }
+    envelope = env;
+    if (lowest >= 1.0f) return;
+
+    for (std::size_t c = 0; c < ch; ++c) {
+        float* x = planar.data() + c * capacity;
+        for (std::size_t i = 0; i < n; ++i) x[i] *= m[i];
+    }
+    if (lowest < minEnvelope.load(std::memory_order_relaxed)) minEnvelope.store(lowest, std::memory_order_relaxed);
+}
+
+void DspChain::record(std::uint64_t ns, std::size_t frames) {
+    const std::uint64_t audioNs = std::uint64_t(frames) * 1000000000ull / rate;
+    bump(blocks, std::uint64_t(1));
+    bump(sumNs, ns);
+    bump(sumAudioNs, audioNs);
+    lastNs.store(ns, std::memory_order_relaxed);
+    raiseTo(maxNs, ns);
+    if (audioNs > 0) raiseTo(peakLoad, float(double(ns) / double(audioNs)));
+}
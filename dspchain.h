@@ -0,0 +1,136 @@
+/*
+ * Author: Itoro Ifon, jason Hippolite, Prince Umeh
+ * Date: 2026-10-16
+ * Course/Assignment: C++ Project - Qt Music Player
+ * File: dspchain.h
+ * Purpose: Declares DspChain, the playback effects chain (preamp, parametric
+ *          EQ, peak limiter) run on every block the sound stream hands to
+ *          SFML, and the parameter and statistics types around it.
+ */
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include "triplebuffer.h"
+
+// Struct: EqBand
+// Purpose: One parametric EQ band (RBJ cookbook biquad).
+struct EqBand {
+    enum Type : std::uint8_t { Peak, LowShelf, HighShelf };
+
+    Type type = Peak;
+    float frequency = 1000.0f; // Hz
+    float gainDb = 0.0f;       // 0 dB leaves the band out entirely
+    float q = 0.707f;          // bandwidth (Peak) or slope (shelves)
+};
+
+// Struct: DspParams
+// Purpose: Everything the UI can change. Plain data, so it can be handed to
+//          the audio thread by copy through a TripleBuffer.
+struct DspParams {
+    static constexpr int kBands = 5;
+
+    bool eqEnabled = false;
+    float preampDb = 0.0f;
+    std::array<EqBand, kBands> bands = {{
+        {EqBand::LowShelf, 100.0f, 0.0f, 0.707f},
+        {EqBand::Peak, 400.0f, 0.0f, 1.0f},
+        {EqBand::Peak, 1500.0f, 0.0f, 1.0f},
+        {EqBand::Peak, 5000.0f, 0.0f, 1.0f},
+        {EqBand::HighShelf, 10000.0f, 0.0f, 0.707f},
+    }};
+
+    // On by default at full scale: replaces the hard clipping boosts used
+    // to cause, and is inaudible otherwise.
+    bool limiterEnabled = true;
+    float limiterCeilingDb = 0.0f;
+    float limiterReleaseMs = 80.0f;
+};
+
+// Struct: DspStats
+// Purpose: Cost of the chain on the audio thread since the last reset.
+//          load is processing time over the audio time processed; 1.0 would
+//          be exactly real time on one core.
+struct DspStats {
+    std::uint64_t blocks = 0;
+    double lastUs = 0.0;
+    double avgUs = 0.0;
+    double maxUs = 0.0;
+    double load = 0.0;
+    double peakLoad = 0.0;        // worst single block
+    float gainReductionDb = 0.0f; // deepest limiter reduction (<= 0)
+};
+
+// Class: DspChain
+// Purpose: int16 in, int16 out: de-interleave to planar float with the track
+//          gain and preamp folded in, run the active EQ bands per channel,
+//          limit, and re-interleave with saturation.
+// Notes: setParams(), params(), stats() and resetStats() are for the GUI
+//        thread. prepare() sizes the scratch buffers and must run while the
+//        stream is stopped; process() then never allocates or locks. New
+//        parameters reach it through a TripleBuffer and the coefficients
+//        are recomputed on the audio thread. Statistics are relaxed atomics.
+//        The EQ biquads are recursive, so they run per channel in double
+//        precision; conversion, peak detection and gain application are
+//        flat loops over contiguous buffers for the auto-vectorizer.
+class DspChain {
+public:
+    DspChain();
+
+    void setParams(const DspParams& p);
+    const DspParams& params() const { return edited; }
+
+    DspStats stats() const;
+    void resetStats();
+
+    void prepare(unsigned sampleRate, unsigned channels, std::size_t maxFrames);
+    void process(std::int16_t* interleaved, std::size_t frames, float gain);
+
+private:
+    struct Coeffs {
+        double b0 = 1.0, b1 = 0.0, b2 = 0.0, a1 = 0.0, a2 = 0.0;
+    };
+    struct BiquadState {
+        double s1 = 0.0, s2 = 0.0;
+    };
+
+    void apply(const DspParams& p);
+    void runBlock(std::int16_t* interleaved, std::size_t frames, float gain);
+    void limit(std::size_t frames);
+    void record(std::uint64_t ns, std::size_t frames);
+
+    static Coeffs design(const EqBand& band, double sampleRate);
+
+    DspParams edited;                 // GUI thread copy
+    TripleBuffer<DspParams> incoming;
+
+    // Audio side
+    unsigned rate = 44100;
+    unsigned channelCount = 2;
+    std::size_t capacity = 0;         // frames per runBlock()
+    DspParams active;
+    std::array<Coeffs, DspParams::kBands> coeffs{};
+    std::array<bool, DspParams::kBands> bandOn{};
+    int bandsOn = 0;
+    float preamp = 1.0f;
+    float ceiling = 1.0f;
+    float releaseCoeff = 0.0f;
+    float envelope = 1.0f;
+    std::vector<BiquadState> state;   // channels * kBands
+    std::vector<float> planar;        // channels * capacity
+    std::vector<float> framePeak;     // capacity
+
+    // Statistics
+    std::atomic<std::uint64_t> blocks{0};
+    std::atomic<std::uint64_t> lastNs{0};
+    std::atomic<std::uint64_t> maxNs{0};
+    std::atomic<std::uint64_t> sumNs{0};
+    std::atomic<std::uint64_t> sumAudioNs{0};
+    std::atomic<float> peakLoad{0.0f};
+    std::atomic<float> minEnvelope{1.0f};
+    std::atomic<bool> resetRequested{false};
+};
@@ -0,0 +1,140 @@
+/*
+ * Author: Itoro Ifon, jason Hippolite, Prince Umeh
+ * Date: 2026-10-16
+ * Course/Assignment: C++ Project - Qt Music Player
+ * File: duplicatescanner.cpp
+ * Purpose: Implements the parallel background content hashing.
+ */
+#include "duplicatescanner.h"
+#include "contenthash.h"
+#include "tracer.h"
+
+#include <QFileInfo>
+#include <QDateTime>
+#include <QMutexLocker>
+#include <QThread>
+
+#include <algorithm>
+
+DuplicateScanner::DuplicateScanner(QObject* parent) : QObject(parent) {
+    pool.setMaxThreadCount(QThread::idealThreadCount());
+    pool.setThreadPriority(QThread::LowPriority); // playback and the UI come first
+}
+
+DuplicateScanner::~DuplicateScanner() {
+    cancel();
+    pool.waitForDone();
+}
+
+// ========================= Queue =========================
+void DuplicateScanner::analyze(const QStringList& paths) {
+    {
+        QMutexLocker guard(&lock);
+        if (running == 0 && queue.empty()) {
+            totals = HashStats();
+            wall.start();
+        }
+        for (const QString& p : paths) {
+            if (queued.contains(p)) continue;
+            queued.insert(p);
+            queue.push_back(p);
+            ++totals.queued;
+        }
+    }
+    startWorkers();
+}
+
+void DuplicateScanner::cancel() {
+    ++generation;
+    QMutexLocker guard(&lock);
+    queue.clear();
+    queued.clear();
+    outbox.clear();
+}
+
+HashStats DuplicateScanner::stats() const {
+    QMutexLocker guard(&lock);
+    HashStats s = totals;
+    s.threads = pool.maxThreadCount();
+    s.readSlots = kReadSlots;
+    s.wallSeconds = wall.isValid() ? double(wall.elapsed()) / 1000.0 : 0.0;
+    return s;
+}
+
+void DuplicateScanner::startWorkers() {
+    const quint64 gen = generation;
+    int wanted = 0;
+    {
+        QMutexLocker guard(&lock);
+        wanted = std::min(int(queue.size()), pool.maxThreadCount() - running.load());
+    }
+    for (int i = 0; i < wanted; ++i) {
+        ++running;
+        pool.start([this, gen] { worker(gen); });
+    }
+}
+
+// ========================= Workers =========================
+void DuplicateScanner::worker(quint64 gen) {
+    for (;;) {
+        QString path;
+        {
+            QMutexLocker guard(&lock);
+            if (gen != generation || queue.empty()) break;
+            path = queue.front();
+            queue.pop_front();
+        }
+
+        const QFileInfo info(path);
+        ContentHashResult r{path, 0, info.size(), info.lastModified().toMSecsSinceEpoch()};
+        {
+            TRACE_SCOPE("DuplicateScanner::hash");
+            r.hash = ContentHash::ofFile(path, &readSlots);
+        }
+
+        bool flush = false;
+        {
+            QMutexLocker guard(&lock);
+            if (gen != generation) break;
+            queued.remove(path);
+            if (r.hash != 0) {
+                ++totals.done;
+                totals.bytes += r.size;
+                outbox.push_back(r);
+            } else {
+                ++totals.failed;
+            }
+            flush = outbox.size() >= kDeliverEvery;
+        }
+        if (flush) deliver(gen, false);
+    }
+
+    const bool last = --running == 0;
+    deliver(gen, last);
+}
+
+// Hands the outbox to the GUI thread; the last worker out also reports the
+// run's throughput.
+void DuplicateScanner::deliver(quint64 gen, bool final) {
+    QVector<ContentHashResult> batch;
+    HashStats s;
+    {
+        QMutexLocker guard(&lock);
+        if (gen != generation) return;
+        batch.swap(outbox);
+        final = final && queue.empty();
+    }
+    if (final) s = stats();
+
+    QMetaObject::invokeMethod(this, [this, gen, batch, final, s] {
+        if (gen != generation) return;
+        if (!batch.isEmpty()) emit resultsReady(batch);
+
+        const HashStats now = stats();
+        emit progress(now.done + now.failed, now.queued);
+        if (final && !isRunning()) {
+            TRACE_COUNTER("duplicates.megabytesPerSecond", s.megabytesPerSecond());
+            emit finished(s);
+        }
+    }, Qt::QueuedConnection);
+}
@@ -0,0 +1,96 @@
+/*
+ * Author: Itoro Ifon, jason Hippolite, Prince Umeh
+ * Date: 2026-10-16
+ * Course/Assignment: C++ Project - Qt Music Player
+ * File: duplicatescanner.h
+ * Purpose: Declares DuplicateScanner, which content-hashes tracks on every
+ *          core in the background so copies of a song can be grouped.
+ */
+#pragma once
+
+#include <QObject>
+#include <QString>
+#include <QStringList>
+#include <QVector>
+#include <QSet>
+#include <QMutex>
+#include <QSemaphore>
+#include <QThreadPool>
+#include <QElapsedTimer>
+
+#include <atomic>
+#include <deque>
+
+// Struct: ContentHashResult
+// Purpose: One hashed track, with the file identity the hash belongs to.
+struct ContentHashResult {
+    QString path;
+    quint64 hash = 0;
+    qint64 size = 0;
+    qint64 mtimeMs = 0;
+};
+
+// Struct: HashStats
+// Purpose: Throughput of the current hashing run.
+struct HashStats {
+    int done = 0;
+    int failed = 0;
+    int queued = 0;
+    int threads = 0;
+    int readSlots = 0;
+    qint64 bytes = 0;            // file bytes hashed (payload and tags)
+    double wallSeconds = 0.0;
+
+    double megabytesPerSecond() const { return wallSeconds > 0.0 ? double(bytes) / 1e6 / wallSeconds : 0.0; }
+};
+
+// Class: DuplicateScanner
+// Purpose: Work queue of paths drained by one worker per core at low thread
+//          priority; each worker runs ContentHash::ofFile() and results are
+//          batched back to the GUI thread, like LoudnessScanner.
+// Notes: Hashing is mostly waiting on the disk, so the workers share
+//        kReadSlots reads in flight (ContentHash reads in 1 MiB chunks);
+//        the rest of the threads hash what was read. The file's size and
+//        mtime are taken before hashing and returned with the result, so
+//        the cache only keeps a hash for the file it was computed from.
+//        analyze() skips paths already queued; cancel() drops the queue and
+//        discards results still in flight.
+class DuplicateScanner : public QObject {
+    Q_OBJECT
+
+public:
+    explicit DuplicateScanner(QObject* parent = nullptr);
+    ~DuplicateScanner() override;
+
+    void analyze(const QStringList& paths);
+    void cancel();
+
+    bool isRunning() const { return running > 0; }
+    HashStats stats() const;
+
+    static constexpr int kReadSlots = 4;
+
+signals:
+    void resultsReady(const QVector<ContentHashResult>& results);
+    void progress(int done, int total);
+    void finished(const HashStats& stats);
+
+private:
+    void startWorkers();
+    void worker(quint64 generation);
+    void deliver(quint64 generation, bool final);
+
+    static constexpr int kDeliverEvery = 64;
+
+    QThreadPool pool;
+    QSemaphore readSlots{kReadSlots};
+    std::atomic<quint64> generation{0};
+    std::atomic<int> running{0};
+
+    mutable QMutex lock;              // guards everything below
+    std::deque<QString> queue;
+    QSet<QString> queued;
+    QVector<ContentHashResult> outbox;
+    HashStats totals;
+    QElapsedTimer wall;
+};
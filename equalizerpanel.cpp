@@ -0,0 +1,251 @@
+/*
+ * Author: Itoro Ifon, jason Hippolite, Prince Umeh
+ * Date: 2026-10-16
+ * Course/Assignment: C++ Project - Qt Music Player
+ * File: equalizerpanel.cpp
+ * Purpose: Implements the DSP chain window and its session format.
+ */
+#include "equalizerpanel.h"
+#include "playbackengine.h"
+
+#include <QCheckBox>
+#include <QDoubleSpinBox>
+#include <QGridLayout>
+#include <QHBoxLayout>
+#include <QLabel>
+#include <QPushButton>
+#include <QSlider>
+#include <QSpinBox>
+#include <QVBoxLayout>
+#include <QVariantList>
+
+#include <cmath>
+
+namespace {
+
+QString dbText(double db) {
+    return QString("%1%2 dB").arg(db > 0 ? "+" : "").arg(db, 0, 'f', 1);
+}
+
+QString typeName(EqBand::Type t) {
+    switch (t) {
+    case EqBand::LowShelf: return "Low shelf";
+    case EqBand::HighShelf: return "High shelf";
+    case EqBand::Peak: break;
+    }
+    return "Peak";
+}
+
+} // namespace
+
+EqualizerPanel::EqualizerPanel(PlaybackEngine* playback, QWidget* parent)
+    : QWidget(parent, Qt::Tool), engine(playback) {
+    setWindowTitle("Equalizer");
+
+    eqBox = new QCheckBox("Equalizer");
+    connect(eqBox, &QCheckBox::toggled, this, &EqualizerPanel::publish);
+
+    preampSlider = new QSlider(Qt::Horizontal);
+    preampSlider->setRange(-12 * kStepsPerDb, 12 * kStepsPerDb);
+    preampLabel = new QLabel();
+    preampLabel->setMinimumWidth(60);
+    connect(preampSlider, &QSlider::valueChanged, this, &EqualizerPanel::publish);
+
+    auto* resetBtn = new QPushButton("Reset");
+    connect(resetBtn, &QPushButton::clicked, this, &EqualizerPanel::resetAll);
+
+    auto* topRow = new QHBoxLayout();
+    topRow->addWidget(eqBox);
+    topRow->addSpacing(12);
+    topRow->addWidget(new QLabel("Preamp"));
+    topRow->addWidget(preampSlider, 1);
+    topRow->addWidget(preampLabel);
+    topRow->addWidget(resetBtn);
+
+    // One column per band: gain slider on top, frequency and Q below.
+    auto* grid = new QGridLayout();
+    const DspParams& initial = engine->dspParams();
+    for (int b = 0; b < DspParams::kBands; ++b) {
+        BandRow row;
+        row.gain = new QSlider(Qt::Vertical);
+        row.gain->setRange(-12 * kStepsPerDb, 12 * kStepsPerDb);
+        row.gain->setMinimumHeight(140);
+        row.gainLabel = new QLabel();
+        row.gainLabel->setAlignment(Qt::AlignCenter);
+
+        row.frequency = new QSpinBox();
+        row.frequency->setRange(20, 20000);
+        row.frequency->setSuffix(" Hz");
+        row.frequency->setKeyboardTracking(false);
+
+        row.q = new QDoubleSpinBox();
+        row.q->setRange(0.1, 10.0);
+        row.q->setSingleStep(0.1);
+        row.q->setPrefix("Q ");
+        row.q->setKeyboardTracking(false);
+
+        connect(row.gain, &QSlider::valueChanged, this, &EqualizerPanel::publish);
+        connect(row.frequency, &QSpinBox::valueChanged, this, &EqualizerPanel::publish);
+        connect(row.q, &QDoubleSpinBox::valueChanged, this, &EqualizerPanel::publish);
+
+        auto* type = new QLabel(typeName(initial.bands[std::size_t(b)].type));
+        type->setAlignment(Qt::AlignCenter);
+        grid->addWidget(type, 0, b);
+        grid->addWidget(row.gain, 1, b, Qt::AlignHCenter);
+        grid->addWidget(row.gainLabel, 2, b);
+        grid->addWidget(row.frequency, 3, b);
+        grid->addWidget(row.q, 4, b);
+        bands << row;
+    }
+
+    limiterBox = new QCheckBox("Limiter");
+    ceilingSpin = new QDoubleSpinBox();
+    ceilingSpin->setRange(-12.0, 0.0);
+    ceilingSpin->setSingleStep(0.1);
+    ceilingSpin->setDecimals(1);
+    ceilingSpin->setSuffix(" dBFS");
+    ceilingSpin->setKeyboardTracking(false);
+    releaseSpin = new QSpinBox();
+    releaseSpin->setRange(10, 1000);
+    releaseSpin->setSuffix(" ms");
+    releaseSpin->setKeyboardTracking(false);
+    connect(limiterBox, &QCheckBox::toggled, this, &EqualizerPanel::publish);
+    connect(ceilingSpin, &QDoubleSpinBox::valueChanged, this, &EqualizerPanel::publish);
+    connect(releaseSpin, &QSpinBox::valueChanged, this, &EqualizerPanel::publish);
+
+    auto* limiterRow = new QHBoxLayout();
+    limiterRow->addWidget(limiterBox);
+    limiterRow->addWidget(new QLabel("Ceiling"));
+    limiterRow->addWidget(ceilingSpin);
+    limiterRow->addWidget(new QLabel("Release"));
+    limiterRow->addWidget(releaseSpin);
+    limiterRow->addStretch(1);
+
+    statsLabel = new QLabel();
+    auto* resetStatsBtn = new QPushButton("Reset Stats");
+    connect(resetStatsBtn, &QPushButton::clicked, this, [this] {
+        engine->resetDspStats();
+        refreshStats();
+    });
+    auto* statsRow = new QHBoxLayout();
+    statsRow->addWidget(statsLabel, 1);
+    statsRow->addWidget(resetStatsBtn);
+
+    auto* layout = new QVBoxLayout(this);
+    layout->addLayout(topRow);
+    layout->addLayout(grid);
+    layout->addLayout(limiterRow);
+    layout->addLayout(statsRow);
+
+    load(engine->dspParams());
+
+    refreshTimer.setInterval(kRefreshMs);
+    connect(&refreshTimer, &QTimer::timeout, this, &EqualizerPanel::refreshStats);
+}
+
+void EqualizerPanel::showEvent(QShowEvent* e) {
+    QWidget::showEvent(e);
+    refreshStats();
+    refreshTimer.start();
+}
+
+void EqualizerPanel::hideEvent(QHideEvent* e) {
+    QWidget::hideEvent(e);
+    refreshTimer.stop();
+}
+
+// ========================= Controls =========================
+void EqualizerPanel::load(const DspParams& p) {
+    loading = true;
+    eqBox->setChecked(p.eqEnabled);
+    preampSlider->setValue(int(std::lround(p.preampDb * kStepsPerDb)));
+    preampLabel->setText(dbText(p.preampDb));
+    for (int b = 0; b < DspParams::kBands; ++b) {
+        const EqBand& band = p.bands[std::size_t(b)];
+        bands[b].gain->setValue(int(std::lround(band.gainDb * kStepsPerDb)));
+        bands[b].gainLabel->setText(dbText(band.gainDb));
+        bands[b].frequency->setValue(int(std::lround(band.frequency)));
+        bands[b].q->setValue(band.q);
+    }
+    limiterBox->setChecked(p.limiterEnabled);
+    ceilingSpin->setValue(p.limiterCeilingDb);
+    releaseSpin->setValue(int(std::lround(p.limiterReleaseMs)));
+    loading = false;
+}
+
+void EqualizerPanel::publish() {
+    if (loading) return;
+
+    DspParams p = engine->dspParams(); // keeps the band types
+    p.eqEnabled = eqBox->isChecked();
+    p.preampDb = float(preampSlider->value()) / kStepsPerDb;
+    preampLabel->setText(dbText(p.preampDb));
+    for (int b = 0; b < DspParams::kBands; ++b) {
+        EqBand& band = p.bands[std::size_t(b)];
+        band.gainDb = float(bands[b].gain->value()) / kStepsPerDb;
+        band.frequency = float(bands[b].frequency->value());
+        band.q = float(bands[b].q->value());
+        bands[b].gainLabel->setText(dbText(band.gainDb));
+    }
+    p.limiterEnabled = limiterBox->isChecked();
+    p.limiterCeilingDb = float(ceilingSpin->value());
+    p.limiterReleaseMs = float(releaseSpin->value());
+
+    engine->setDspParams(p);
+    emit paramsChanged(p);
+}
+
+void EqualizerPanel::resetAll() {
+    DspParams p;
+    engine->setDspParams(p);
+    load(p);
+    emit paramsChanged(p);
+}
+
+void EqualizerPanel::refreshStats() {
+    const DspStats s = engine->dspStats();
+    if (s.blocks == 0) {
+        statsLabel->setText("DSP: idle");
+        return;
+    }
+    statsLabel->setText(QString("DSP per block: avg %1 µs, max %2 µs · load %3 % (peak %4 %) · limiter %5")
+                            .arg(s.avgUs, 0, 'f', 1)
+                            .arg(s.maxUs, 0, 'f', 1)
+                            .arg(s.load * 100.0, 0, 'f', 3)
+                            .arg(s.peakLoad * 100.0, 0, 'f', 3)
+                            .arg(dbText(s.gainReductionDb)));
+}
+
+// ========================= Session format =========================
+QVariantMap EqualizerPanel::toVariant(const DspParams& p) {
+    QVariantList list;
+    for (const EqBand& band : p.bands)
+        list << QVariantMap{{"type", int(band.type)}, {"frequency", band.frequency}, {"gainDb", band.gainDb}, {"q", band.q}};
+
+    return {{"eqEnabled", p.eqEnabled},
+            {"preampDb", p.preampDb},
+            {"bands", list},
+            {"limiterEnabled", p.limiterEnabled},
+            {"limiterCeilingDb", p.limiterCeilingDb},
+            {"limiterReleaseMs", p.limiterReleaseMs}};
+}
+
+DspParams EqualizerPanel::fromVariant(const QVariantMap& map) {
+    DspParams p;
+    p.eqEnabled = map.value("eqEnabled", p.eqEnabled).toBool();
+    p.preampDb = map.value("preampDb", p.preampDb).toFloat();
+    const QVariantList list = map.value("bands").toList();
+    for (int b = 0; b < DspParams::kBands && b < list.size(); ++b) {
+        const QVariantMap m = list[b].toMap();
+        EqBand& band = p.bands[std::size_t(b)];
+        const int type = m.value("type", int(band.type)).toInt();
+        if (type >= EqBand::Peak && type <= EqBand::HighShelf) band.type = EqBand::Type(type);
+        band.frequency = m.value("frequency", band.frequency).toFloat();
+        band.gainDb = m.value("gainDb", band.gainDb).toFloat();
+        band.q = m.value("q", band.q).toFloat();
+    }
+    p.limiterEnabled = map.value("limiterEnabled", p.limiterEnabled).toBool();
+    p.limiterCeilingDb = map.value("limiterCeilingDb", p.limiterCeilingDb).toFloat();
+    p.limiterReleaseMs = map.value("limiterReleaseMs", p.limiterReleaseMs).toFloat();
+    return p;
+}
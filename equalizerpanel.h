@@ -0,0 +1,75 @@
+/*
+ * Author: Itoro Ifon, jason Hippolite, Prince Umeh
+ * Date: 2026-10-16
+ * Course/Assignment: C++ Project - Qt Music Player
+ * File: equalizerpanel.h
+ * Purpose: Declares EqualizerPanel, the window for the playback DSP chain
+ *          (preamp, parametric EQ, limiter) and its live cost.
+ */
+#pragma once
+
+#include <QWidget>
+#include <QTimer>
+#include <QVariantMap>
+#include <QVector>
+
+#include "dspchain.h"
+
+class QCheckBox;
+class QDoubleSpinBox;
+class QLabel;
+class QSlider;
+class QSpinBox;
+class PlaybackEngine;
+
+// Class: EqualizerPanel
+// Purpose: Tool window that edits the engine's DspParams. Every change is
+//          pushed to the audio thread at once and reported through
+//          paramsChanged() so the owner can persist it.
+// Notes: Shows the chain's per-block cost and limiter activity twice a
+//        second while visible. toVariant()/fromVariant() are the session
+//        format.
+class EqualizerPanel : public QWidget {
+    Q_OBJECT
+public:
+    EqualizerPanel(PlaybackEngine* engine, QWidget* parent = nullptr);
+
+    static QVariantMap toVariant(const DspParams& p);
+    static DspParams fromVariant(const QVariantMap& map);
+
+signals:
+    void paramsChanged(const DspParams& p);
+
+protected:
+    void showEvent(QShowEvent* e) override;
+    void hideEvent(QHideEvent* e) override;
+
+private:
+    struct BandRow {
+        QSlider* gain = nullptr;
+        QLabel* gainLabel = nullptr;
+        QSpinBox* frequency = nullptr;
+        QDoubleSpinBox* q = nullptr;
+    };
+
+    void load(const DspParams& p); // fills the controls without publishing
+    void publish();                // controls -> engine
+    void resetAll();
+    void refreshStats();
+
+    static constexpr int kRefreshMs = 500;
+    static constexpr int kStepsPerDb = 2; // sliders move in 0.5 dB steps
+
+    PlaybackEngine* engine = nullptr;
+    QTimer refreshTimer;
+    bool loading = false;
+
+    QCheckBox* eqBox = nullptr;
+    QSlider* preampSlider = nullptr;
+    QLabel* preampLabel = nullptr;
+    QVector<BandRow> bands;
+    QCheckBox* limiterBox = nullptr;
+    QDoubleSpinBox* ceilingSpin = nullptr;
+    QSpinBox* releaseSpin = nullptr;
+    QLabel* statsLabel = nullptr;
+};
@@ -0,0 +1,208 @@
+/*
+ * Author: Itoro Ifon, jason Hippolite, Prince Umeh
+ * Date: 2026-10-16
+ * Course/Assignment: C++ Project - Qt Music Player
+ * File: librarycache.cpp
+ * Purpose: Implements loading, saving and validating the library cache file.
+ */
+#include "librarycache.h"
+
+#include <QFile>
+#include <QSaveFile>
+#include <QDataStream>
+#include <QDir>
+#include <QFileInfo>
+#include <QStandardPaths>
+
+#include <algorithm>
+
+static constexpr quint32 kCacheMagic   = 0x514D504C; // "QMPL"
+static constexpr quint32 kCacheVersion = 7; // 2: album, track number, duration; 3: loudness; 4: seek index; 5: packed lyrics; 6: play count; 7: content hash
+
+LibraryCache::LibraryCache() : path(defaultFilePath()) {}
+
+LibraryCache::LibraryCache(const QString& filePath) : path(filePath) {}
+
+QString LibraryCache::defaultFilePath() {
+    return QDir(QStandardPaths::writableLocation(QStandardPaths::AppDataLocation))
+        .filePath("library.cache");
+}
+
+// ========================= File I/O =========================
+bool LibraryCache::load() {
+    if (loaded) return true; // fast path for scan workers
+    QWriteLocker guard(&lock);
+    if (loaded) return true;
+
+    QFile f(path);
+    if (!f.open(QIODevice::ReadOnly)) {
+        loaded = true; // first run: start empty
+        return false;
+    }
+
+    QDataStream in(&f);
+    in.setVersion(QDataStream::Qt_6_0);
+
+    quint32 magic = 0, version = 0, count = 0;
+    in >> magic >> version >> count;
+    if (magic != kCacheMagic || version != kCacheVersion) {
+        loaded = true; // stale format: rebuild from scratch
+        return false;
+    }
+
+    QHash<QString, ScannedTrack> read;
+    read.reserve(count);
+    for (quint32 i = 0; i < count && in.status() == QDataStream::Ok; ++i) {
+        ScannedTrack t;
+        in >> t.path >> t.size >> t.mtimeMs >> t.lyricsMtimeMs >> t.title >> t.artist >> t.album
+           >> t.trackNumber >> t.durationMs >> t.packedLyrics
+           >> t.loudness.analyzed >> t.loudness.lufs >> t.loudness.truePeakDb >> t.loudness.gatedSeconds
+           >> t.seekIndex >> t.playCount >> t.contentHash;
+        read.insert(t.path, t);
+    }
+
+    if (in.status() != QDataStream::Ok) {
+        loaded = true; // truncated or corrupt: ignore it, next save rewrites it
+        return false;
+    }
+
+    entries = std::move(read);
+    loaded = true;
+    return true;
+}
+
+bool LibraryCache::save() {
+    QMutexLocker saving(&saveLock);
+
+    // Snapshot under the lock, write without it.
+    QHash<QString, ScannedTrack> snapshot;
+    {
+        QWriteLocker guard(&lock);
+        if (!dirty) return true;
+        snapshot = entries;
+        dirty = false;
+    }
+
+    QDir().mkpath(QFileInfo(path).absolutePath());
+
+    QSaveFile f(path);
+    if (!f.open(QIODevice::WriteOnly)) {
+        QWriteLocker guard(&lock);
+        dirty = true;
+        return false;
+    }
+
+    QDataStream out(&f);
+    out.setVersion(QDataStream::Qt_6_0);
+    out << kCacheMagic << kCacheVersion << quint32(snapshot.size());
+    for (auto it = snapshot.cbegin(); it != snapshot.cend(); ++it) {
+        const ScannedTrack& t = it.value();
+        out << t.path << t.size << t.mtimeMs << t.lyricsMtimeMs << t.title << t.artist << t.album
+            << t.trackNumber << t.durationMs << t.packedLyrics
+            << t.loudness.analyzed << t.loudness.lufs << t.loudness.truePeakDb << t.loudness.gatedSeconds
+            << t.seekIndex << t.playCount << t.contentHash;
+    }
+
+    if (!f.commit()) {
+        QWriteLocker guard(&lock);
+        dirty = true;
+        return false;
+    }
+    return true;
+}
+
+bool LibraryCache::isDirty() const {
+    QReadLocker guard(&lock);
+    return dirty;
+}
+
+int LibraryCache::size() const {
+    QReadLocker guard(&lock);
+    return entries.size();
+}
+
+// ========================= Entries =========================
+bool LibraryCache::lookup(const QString& trackPath, qint64 size, qint64 mtimeMs, qint64 lyricsMtimeMs,
+                          ScannedTrack& out) const {
+    QReadLocker guard(&lock);
+    auto it = entries.constFind(trackPath);
+    if (it == entries.constEnd()) return false;
+
+    const ScannedTrack& t = it.value();
+    if (t.size != size || t.mtimeMs != mtimeMs || t.lyricsMtimeMs != lyricsMtimeMs) return false;
+
+    out = t;
+    return true;
+}
+
+void LibraryCache::insert(const ScannedTrack& t) {
+    ScannedTrack stored = t;
+    stored.grams.clear(); // derived data; recomputed from the text
+    stored.lyrics.clear(); // kept packed
+
+    QWriteLocker guard(&lock);
+    // A changed file (retagged, say) is still the same song to the listener.
+    auto it = entries.constFind(stored.path);
+    if (it != entries.constEnd()) stored.playCount = std::max(stored.playCount, it->playCount);
+    entries.insert(stored.path, stored);
+    dirty = true;
+}
+
+void LibraryCache::setLoudness(const QString& trackPath, const TrackLoudness& loudness) {
+    QWriteLocker guard(&lock);
+    auto it = entries.find(trackPath);
+    if (it == entries.end()) return;
+    it->loudness = loudness;
+    dirty = true;
+}
+
+void LibraryCache::setPlayCount(const QString& trackPath, quint32 count) {
+    QWriteLocker guard(&lock);
+    auto it = entries.find(trackPath);
+    if (it == entries.end()) return;
+    it->playCount = count;
+    dirty = true;
+}
+
+void LibraryCache::setContentHash(const QString& trackPath, quint64 hash, qint64 size, qint64 mtimeMs) {
+    QWriteLocker guard(&lock);
+    auto it = entries.find(trackPath);
+    if (it == entries.end() || it->size != size || it->mtimeMs != mtimeMs) return;
+    it->contentHash = hash;
+    dirty = true;
+}
+
+QByteArray LibraryCache::seekIndex(const QString& trackPath, qint64 size, qint64 mtimeMs) const {
+    QReadLocker guard(&lock);
+    auto it = entries.constFind(trackPath);
+    if (it == entries.constEnd() || it->size != size || it->mtimeMs != mtimeMs) return {};
+    return it->seekIndex;
+}
+
+void LibraryCache::rename(const QString& from, const QString& to) {
+    QWriteLocker guard(&lock);
+    auto it = entries.find(from);
+    if (it == entries.end() || from == to) return;
+    ScannedTrack moved = std::move(it.value());
+    entries.erase(it);
+    moved.path = to;
+    // Size and mtime survive a rename, so the next scan still hits; a lyrics
+    // sidecar that did not move along makes it miss and re-read, as it should.
+    entries.insert(to, moved);
+    dirty = true;
+}
+
+void LibraryCache::retainInFolder(const QString& folder, const QSet<QString>& seenPaths) {
+    const QString prefix = QDir(folder).absolutePath() + '/';
+
+    QWriteLocker guard(&lock);
+    for (auto it = entries.begin(); it != entries.end();) {
+        const QString& p = it.key();
+        if (p.startsWith(prefix) && !seenPaths.contains(p)) {
+            it = entries.erase(it);
+            dirty = true;
+        } else {
+            ++it;
+        }
+    }
+}
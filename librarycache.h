@@ -0,0 +1,62 @@
+/*
+ * Author: Itoro Ifon, jason Hippolite, Prince Umeh
+ * Date: 2026-10-16
+ * Course/Assignment: C++ Project - Qt Music Player
+ * File: librarycache.h
+ * Purpose: Declares LibraryCache, the on-disk store of parsed track metadata
+ *          that lets a rescan skip files whose size and mtime are unchanged.
+ */
+#pragma once
+
+#include <QString>
+#include <QStringList>
+#include <QHash>
+#include <QSet>
+#include <QReadWriteLock>
+#include <QMutex>
+
+#include <atomic>
+
+#include "libraryscanner.h"
+
+// Class: LibraryCache
+// Purpose: Path -> ScannedTrack map persisted as one compact binary file.
+//          Entries carry the audio file's size/mtime and the lyrics sidecar's
+//          mtime; a lookup only hits when all three still match.
+// Notes: Thread-safe. Scan workers look up and insert concurrently; save()
+//        snapshots the entries and writes the file without holding the lock.
+class LibraryCache {
+public:
+    LibraryCache();
+    explicit LibraryCache(const QString& filePath);
+
+    bool load();           // no-op after the first successful call
+    bool save();           // atomic (QSaveFile); skipped when nothing changed
+    bool isDirty() const;
+
+    // Returns true and fills `out` when the cached entry is still valid.
+    bool lookup(const QString& path, qint64 size, qint64 mtimeMs, qint64 lyricsMtimeMs,
+                ScannedTrack& out) const;
+    void insert(const ScannedTrack& t);
+    void setLoudness(const QString& path, const TrackLoudness& loudness); // no-op if not cached
+    void setPlayCount(const QString& path, quint32 count);                 // no-op if not cached
+    void setContentHash(const QString& path, quint64 hash, qint64 size, qint64 mtimeMs); // ... or stale
+    QByteArray seekIndex(const QString& path, qint64 size, qint64 mtimeMs) const; // empty if stale
+    void rename(const QString& from, const QString& to); // the entry moves with its analysis; no-op if not cached
+
+    // Drops entries anywhere under `folder` whose files were not seen.
+    void retainInFolder(const QString& folder, const QSet<QString>& seenPaths);
+
+    int size() const;
+    QString filePath() const { return path; }
+
+    static QString defaultFilePath();
+
+private:
+    QString path;
+    mutable QReadWriteLock lock;
+    QMutex saveLock; // one writer of the file at a time
+    QHash<QString, ScannedTrack> entries;
+    std::atomic<bool> loaded{false};
+    bool dirty = false;
+};
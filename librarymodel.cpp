@@ -0,0 +1,273 @@
+/*
+ * Author: Itoro Ifon, jason Hippolite, Prince Umeh
+ * Date: 2026-10-16
+ * Course/Assignment: C++ Project - Qt Music Player
+ * File: librarymodel.cpp
+ * Purpose: Implements LibraryModel on top of TrackStore.
+ */
+#include "librarymodel.h"
+
+#include <QSet>
+
+#include <algorithm>
+#include <iterator>
+
+// ========================= Mutations =========================
+int LibraryModel::appendTracks(const QVector<ScannedTrack>& batch) {
+    // Filter first so the whole batch becomes one contiguous insert.
+    QVector<const ScannedTrack*> fresh;
+    QSet<QString> seen;
+    fresh.reserve(batch.size());
+    for (const auto& t : batch) {
+        if (tracks.contains(t.path) || seen.contains(t.path)) continue;
+        seen.insert(t.path);
+        fresh << &t;
+    }
+    if (fresh.isEmpty()) return 0;
+
+    // The store takes the whole batch; the model only grows through its
+    // first fetch batch here and through fetchMore()/exposeUpTo() after.
+    for (const ScannedTrack* t : fresh) index.add(tracks.add(*t), t->grams);
+    if (exposed < kFetchBatch) exposeTo(std::min(tracks.size(), kFetchBatch));
+    return fresh.size();
+}
+
+void LibraryModel::removeTracks(QVector<int> rows) {
+    std::sort(rows.begin(), rows.end());
+    rows.erase(std::unique(rows.begin(), rows.end()), rows.end());
+    rows.erase(std::remove_if(rows.begin(), rows.end(), [this](int r) { return r < 0 || r >= tracks.size(); }),
+               rows.end());
+    if (rows.isEmpty()) return;
+    for (int row : rows) index.remove(tracks.idAt(row));
+
+    // Unfetched rows need no signals.
+    const int visible = int(std::lower_bound(rows.begin(), rows.end(), exposed) - rows.begin());
+    if (visible == 0) {
+        tracks.removeRows(rows);
+        return;
+    }
+
+    // One contiguous run (a single track, a folder): a plain row removal.
+    if (rows[visible - 1] - rows.first() == visible - 1) {
+        beginRemoveRows(QModelIndex(), rows.first(), rows[visible - 1]);
+        tracks.removeRows(rows);
+        exposed -= visible;
+        endRemoveRows();
+        return;
+    }
+
+    // Scattered rows: a removal signal per run would compact the store once
+    // per run, so compact once and announce it as a layout change instead.
+    // Persistent indexes on removed rows become invalid; the rest shift up.
+    emit layoutAboutToBeChanged();
+    const QModelIndexList before = persistentIndexList();
+    QModelIndexList after;
+    after.reserve(before.size());
+    for (const QModelIndex& idx : before) {
+        const auto at = std::lower_bound(rows.begin(), rows.end(), idx.row());
+        if (at != rows.end() && *at == idx.row()) after << QModelIndex();
+        else after << createIndex(idx.row() - int(at - rows.begin()), idx.column());
+    }
+    tracks.removeRows(rows);
+    exposed -= visible;
+    changePersistentIndexList(before, after);
+    emit layoutChanged();
+}
+
+void LibraryModel::renameTrack(int row, const QString& newPath) {
+    if (!tracks.setPath(row, newPath) || row >= exposed) return;
+    emit dataChanged(index(row, 0), index(row, ColumnCount - 1), {Qt::DisplayRole, Qt::ToolTipRole});
+}
+
+void LibraryModel::setLoudness(int row, const TrackLoudness& loudness) {
+    if (row < 0 || row >= tracks.size()) return;
+    tracks.setLoudness(row, loudness);
+    if (row < exposed) emit dataChanged(index(row, 0), index(row, ColumnCount - 1), {Qt::ToolTipRole});
+}
+
+void LibraryModel::setPlayCount(int row, quint32 count) {
+    if (row >= 0 && row < tracks.size()) tracks.setPlayCount(row, count);
+}
+
+void LibraryModel::setContentHash(int row, quint64 hash) {
+    if (row >= 0 && row < tracks.size()) tracks.setContentHash(row, hash);
+}
+
+void LibraryModel::moveTrack(int from, int to) {
+    if (from < 0 || from >= tracks.size() || to < 0 || to >= tracks.size() || from == to) return;
+    exposeUpTo(std::max(from, to));
+    // beginMoveRows wants the destination as "insert before" in pre-move rows.
+    const int destChild = (to > from) ? to + 1 : to;
+    if (!beginMoveRows(QModelIndex(), from, from, QModelIndex(), destChild)) return;
+    tracks.move(from, to);
+    endMoveRows();
+}
+
+void LibraryModel::clear() {
+    beginResetModel();
+    tracks.clear();
+    index.clear();
+    exposed = 0;
+    endResetModel();
+}
+
+// ========================= Sorting =========================
+void LibraryModel::sort(int column, Qt::SortOrder order) {
+    TrackStore::SortField field;
+    switch (column) {
+    case ColTitle:    field = TrackStore::SortField::Title; break;
+    case ColArtist:   field = TrackStore::SortField::Artist; break;
+    case ColAlbum:    field = TrackStore::SortField::Album; break;
+    case ColDuration: field = TrackStore::SortField::Duration; break;
+    case ColPath:     field = TrackStore::SortField::Path; break;
+    default:          return;
+    }
+
+    const QVector<int> permutation = tracks.sortedOrder(field, order);
+    QVector<int> newRowOf(permutation.size());
+    for (int r = 0; r < permutation.size(); ++r) newRowOf[permutation[r]] = r;
+
+    emit layoutAboutToBeChanged({}, QAbstractItemModel::VerticalSortHint);
+    const QModelIndexList before = persistentIndexList();
+    QModelIndexList after;
+    after.reserve(before.size());
+    for (const QModelIndex& idx : before) {
+        const int r = newRowOf[idx.row()];
+        after << (r < exposed ? createIndex(r, idx.column()) : QModelIndex()); // may now be unfetched
+    }
+    tracks.permute(permutation);
+    changePersistentIndexList(before, after);
+    emit layoutChanged({}, QAbstractItemModel::VerticalSortHint);
+}
+
+// ========================= Lazy rows =========================
+void LibraryModel::exposeTo(int count) {
+    count = std::min(count, tracks.size());
+    if (count <= exposed) return;
+    beginInsertRows(QModelIndex(), exposed, count - 1);
+    exposed = count;
+    endInsertRows();
+}
+
+void LibraryModel::exposeUpTo(int row) {
+    if (row < exposed) return;
+    // Whole fetch batches, so jumping far ahead still costs one insert.
+    exposeTo((row / kFetchBatch + 1) * kFetchBatch);
+}
+
+void LibraryModel::collapseTo(int count) {
+    // Never below the first fetch batch, which appendTracks() keeps exposed.
+    count = std::max(count, std::min(tracks.size(), kFetchBatch));
+    if (count >= exposed) return;
+    beginRemoveRows(QModelIndex(), count, exposed - 1);
+    exposed = count;
+    endRemoveRows();
+}
+
+bool LibraryModel::canFetchMore(const QModelIndex& parent) const {
+    return !parent.isValid() && exposed < tracks.size();
+}
+
+void LibraryModel::fetchMore(const QModelIndex& parent) {
+    if (!parent.isValid()) exposeTo(exposed + kFetchBatch);
+}
+
+qint64 LibraryModel::bytesPerTrack() const {
+    if (tracks.isEmpty()) return 0;
+    return memoryUsage() / tracks.size();
+}
+
+// ========================= Search =========================
+bool LibraryModel::rowMatches(int row, const QString& query) const {
+    const QString folded = SearchIndex::normalize(query);
+    if (SearchIndex::normalize(tracks.titleAt(row)).contains(folded)
+        || SearchIndex::normalize(tracks.artistAt(row)).contains(folded))
+        return true;
+    return folded.size() >= SearchIndex::kGramLength && tracks.hasLyrics(row)
+           && SearchIndex::normalize(tracks.lyricsAt(row)).contains(folded);
+}
+
+bool LibraryModel::idMatches(TrackId id, const QString& query) const {
+    const int r = tracks.rowOf(id);
+    return r >= 0 && rowMatches(r, query);
+}
+
+QVector<TrackId> LibraryModel::candidates(const QString& query) const {
+    const QString folded = SearchIndex::normalize(query);
+    const QVector<TrackId> names = index.candidates(folded);
+    const QVector<TrackId> inLyrics = index.lyricsCandidates(folded);
+    if (inLyrics.isEmpty()) return names;
+
+    QVector<TrackId> out;
+    out.reserve(names.size() + inLyrics.size());
+    std::set_union(names.cbegin(), names.cend(), inLyrics.cbegin(), inLyrics.cend(), std::back_inserter(out));
+    return out;
+}
+
+QVector<TrackId> LibraryModel::search(const QString& query) const {
+    // Trigram hits are a superset (the trigrams may not be adjacent), so the
+    // candidates are confirmed against the text.
+    QVector<TrackId> out;
+    for (TrackId id : candidates(query))
+        if (idMatches(id, query)) out << id;
+    return out;
+}
+
+// ========================= Model interface =========================
+QString LibraryModel::formatDuration(qint64 ms) {
+    if (ms <= 0) return QString();
+    const qint64 total = (ms + 500) / 1000;
+    return QString("%1:%2").arg(total / 60).arg(total % 60, 2, 10, QChar('0'));
+}
+
+int LibraryModel::rowCount(const QModelIndex& parent) const {
+    return parent.isValid() ? 0 : exposed;
+}
+
+int LibraryModel::columnCount(const QModelIndex& parent) const {
+    return parent.isValid() ? 0 : ColumnCount;
+}
+
+QVariant LibraryModel::data(const QModelIndex& index, int role) const {
+    if (!index.isValid() || index.row() >= exposed) return QVariant();
+    const int row = index.row();
+
+    if (role == Qt::DisplayRole) {
+        switch (index.column()) {
+        case ColTitle:  return tracks.titleAt(row);
+        case ColArtist: return tracks.artistAt(row);
+        case ColAlbum:  return tracks.albumAt(row);
+        case ColDuration: return formatDuration(tracks.durationMsAt(row));
+        case ColLyrics: return tracks.lyricsAt(row);
+        case ColPath:   return tracks.pathAt(row);
+        default:        return QVariant();
+        }
+    }
+
+    if (role == Qt::ToolTipRole) {
+        const TrackLoudness& l = tracks.loudnessAt(row);
+        if (!l.analyzed || l.gatedSeconds <= 0.0f) return tracks.pathAt(row);
+        return QString("%1\n%2 LUFS, peak %3 dBTP")
+            .arg(tracks.pathAt(row))
+            .arg(double(l.lufs), 0, 'f', 1)
+            .arg(double(l.truePeakDb), 0, 'f', 1);
+    }
+    if (role == Qt::TextAlignmentRole && index.column() == ColDuration)
+        return QVariant(Qt::AlignRight | Qt::AlignVCenter);
+
+    return QVariant();
+}
+
+QVariant LibraryModel::headerData(int section, Qt::Orientation orientation, int role) const {
+    if (orientation != Qt::Horizontal || role != Qt::DisplayRole) return QVariant();
+
+    switch (section) {
+    case ColTitle:  return QStringLiteral("Title");
+    case ColArtist: return QStringLiteral("Artist");
+    case ColAlbum:  return QStringLiteral("Album");
+    case ColDuration: return QStringLiteral("Time");
+    case ColLyrics: return QStringLiteral("Lyrics");
+    case ColPath:   return QStringLiteral("Path");
+    default:        return QVariant();
+    }
+}
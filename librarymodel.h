@@ -0,0 +1,96 @@
+/*
+ * Author: Itoro Ifon, jason Hippolite, Prince Umeh
+ * Date: 2026-10-16
+ * Course/Assignment: C++ Project - Qt Music Player
+ * File: librarymodel.h
+ * Purpose: Declares LibraryModel, the table model that exposes TrackStore
+ *          rows to the view without allocating per-cell items.
+ */
+#pragma once
+
+#include <QAbstractTableModel>
+#include <QVector>
+
+#include "trackstore.h"
+#include "searchindex.h"
+
+// Class: LibraryModel
+// Purpose: Read-only table model over a TrackStore. Cell values are produced
+//          on demand in data(), so the model holds no per-row objects. All
+//          playlist mutations go through this class so rows and the store can
+//          never drift apart.
+// Notes: Rows are exposed lazily. The first kFetchBatch tracks appear as
+//        they arrive; later ones sit in the store (and the search index)
+//        until a view scrolls near the end and calls fetchMore(), or a
+//        caller needs one via exposeUpTo(). Store rows and model rows share
+//        numbering, so the model's rows are always a prefix of the store.
+class LibraryModel : public QAbstractTableModel {
+    Q_OBJECT
+
+public:
+    enum Column {
+        ColTitle = 0,
+        ColArtist,
+        ColAlbum,
+        ColDuration,
+        ColLyrics, // hidden but searchable
+        ColPath,   // hidden
+        ColumnCount
+    };
+
+    using QAbstractTableModel::QAbstractTableModel;
+
+    const TrackStore& store() const { return tracks; }
+
+    // Appends the tracks not already present; returns how many were added.
+    int appendTracks(const QVector<ScannedTrack>& batch);
+    void removeTrack(int row) { removeTracks({row}); }
+    void removeTracks(QVector<int> rows); // one store pass for the batch
+    void renameTrack(int row, const QString& newPath); // keeps ID, row and metadata
+    void setLoudness(int row, const TrackLoudness& loudness);
+    void setPlayCount(int row, quint32 count); // not shown; feeds the shuffle weights
+    void setContentHash(int row, quint64 hash);  // not shown; see duplicateGroups()
+    void moveTrack(int from, int to);
+    void clear();
+
+    int exposedRows() const { return exposed; }
+    void exposeUpTo(int row); // makes `row` (and everything before it) a model row
+    void exposeAll() { exposeUpTo(tracks.size() - 1); }
+    void collapseTo(int count); // hands rows from `count` on back to the unfetched tail
+    static constexpr int kFetchBatch = 2000;
+
+    // Bytes held for all tracks (store columns, hash and search indexes).
+    qint64 memoryUsage() const { return tracks.memoryUsage() + index.memoryUsage(); }
+    qint64 bytesPerTrack() const;
+
+    // Search: IDs of tracks whose title, artist or lyrics contain the query,
+    // compared case-folded as the index is. Queries shorter than
+    // SearchIndex::kGramLength match title and artist only. Lyrics are
+    // unpacked only for tracks the names did not match.
+    QVector<TrackId> search(const QString& query) const;
+    bool rowMatches(int row, const QString& query) const;
+    bool idMatches(TrackId id, const QString& query) const;
+
+    // Unverified superset of search() from the index, in ID order. Cheap;
+    // lets callers verify in slices.
+    QVector<TrackId> candidates(const QString& query) const;
+
+    int rowCount(const QModelIndex& parent = QModelIndex()) const override;
+    int columnCount(const QModelIndex& parent = QModelIndex()) const override;
+    QVariant data(const QModelIndex& index, int role = Qt::DisplayRole) const override;
+    QVariant headerData(int section, Qt::Orientation orientation, int role = Qt::DisplayRole) const override;
+    bool canFetchMore(const QModelIndex& parent) const override;
+    void fetchMore(const QModelIndex& parent) override;
+
+    // Reorders the playlist itself (and so the play order) by a column,
+    // through the store's precomputed keys. Persistent indexes follow.
+    void sort(int column, Qt::SortOrder order = Qt::AscendingOrder) override;
+
+private:
+    static QString formatDuration(qint64 ms); // "m:ss", empty when unknown
+    void exposeTo(int count); // one insert for rows [exposed, count)
+
+    TrackStore tracks;
+    SearchIndex index;
+    int exposed = 0; // model rows; the rest of the store is not fetched yet
+};
@@ -0,0 +1,460 @@
+/*
+ * Author: Itoro Ifon, jason Hippolite, Prince Umeh
+ * Date: 2026-10-16
+ * Course/Assignment: C++ Project - Qt Music Player
+ * File: libraryscanner.cpp
+ * Purpose: Implements the background library scanner: folder walking,
+ *          filename parsing and lyrics sidecar loading on a worker pool.
+ */
+#include "libraryscanner.h"
+#include "searchindex.h"
+#include "librarycache.h"
+#include "lyricsstore.h"
+#include "tagreader.h"
+
+#include <QDirIterator>
+#include <QFileInfo>
+#include <QFile>
+#include <QDir>
+#include <QRegularExpression>
+#include <QThread>
+#include <QDateTime>
+#include <QSet>
+#include <QStorageInfo>
+
+#include <algorithm>
+#include <vector>
+
+LibraryScanner::LibraryScanner(QObject* parent)
+    : QObject(parent), cache(std::make_unique<LibraryCache>()) {
+    pool.setMaxThreadCount(1); // cache loads and saves are serialized anyway
+}
+
+LibraryScanner::~LibraryScanner() {
+    for (const auto& job : jobs) job->cancelled = true;
+    jobs.clear();
+    for (auto& [volume, p] : volumePools) p->clear();
+    for (auto& [volume, p] : volumePools) p->waitForDone();
+    pool.clear();
+    pool.waitForDone();
+    cache->save(); // a queued save may have been dropped by clear()
+}
+
+// ========================= Jobs =========================
+void LibraryScanner::scanFolder(const QString& folderPath) {
+    auto job = std::make_shared<Job>();
+    job->report.folder = folderPath;
+    jobs << job;
+    emitProgress();
+
+    // The directory walk itself can be slow on network shares, so it runs on
+    // the volume's pool too. Results come back to this thread before batching.
+    poolFor(folderPath)->start([this, job, folderPath] {
+        cache->load();
+
+        // Recursive; symlinked directories are not followed, so loops are impossible.
+        QDirIterator it(folderPath, QDir::Files | QDir::Dirs | QDir::NoDotAndDotDot, QDirIterator::Subdirectories);
+        QStringList supported;
+        QStringList unsupported;
+        QStringList directories = {QDir(folderPath).absolutePath()};
+
+        while (it.hasNext()) {
+            if (job->cancelled) return;
+            const QString path = it.next();
+            const QFileInfo fi = it.fileInfo();
+            if (fi.isDir()) {
+                if (!fi.isSymLink()) directories << path;
+                continue;
+            }
+            if (isSupportedAudio(path)) supported << path;
+            else unsupported << fi.fileName();
+        }
+
+        sortPaths(supported);
+
+        QMetaObject::invokeMethod(this, [this, job, supported, unsupported, directories] {
+            if (!jobs.contains(job)) return;
+            job->report.unsupportedNames = unsupported;
+            job->report.directories = directories;
+            dispatch(job, supported);
+        }, Qt::QueuedConnection);
+    });
+}
+
+void LibraryScanner::scanFiles(const QStringList& filePaths, bool background) {
+    auto job = std::make_shared<Job>();
+    job->report.background = background;
+    jobs << job;
+
+    QStringList supported;
+    for (const auto& p : filePaths) {
+        if (isSupportedAudio(p)) supported << p;
+        else job->report.unsupportedNames << QFileInfo(p).fileName();
+    }
+    dispatch(job, supported);
+}
+
+void LibraryScanner::listTree(const QString& root) {
+    if (listingsQueued.contains(root)) return;
+    listingsQueued.insert(root);
+    startListing(root);
+}
+
+void LibraryScanner::startListing(const QString& root) {
+    poolFor(root)->start([this, root] {
+        TreeListing listing;
+        listing.root = root;
+        listing.directories << root;
+
+        QDirIterator it(root, QDir::Files | QDir::Dirs | QDir::NoDotAndDotDot, QDirIterator::Subdirectories);
+        while (it.hasNext()) {
+            const QString path = it.next();
+            const QFileInfo fi = it.fileInfo();
+            if (fi.isDir()) {
+                if (!fi.isSymLink()) listing.directories << path;
+            } else if (isSupportedAudio(path)) {
+                listing.files << path;
+                listing.sizes << fi.size();
+                listing.mtimesMs << fi.lastModified().toMSecsSinceEpoch();
+            }
+        }
+
+        QMetaObject::invokeMethod(this, [this, listing] {
+            if (!listingsQueued.remove(listing.root)) return; // answered already
+            emit treeListed(listing);
+        }, Qt::QueuedConnection);
+    });
+}
+
+void LibraryScanner::cancel() {
+    const QList<JobPtr> dropped = jobs;
+    for (const auto& job : dropped) job->cancelled = true;
+    jobs.clear();
+    for (auto& [volume, p] : volumePools) p->clear(); // drop batches that have not started yet
+    // Listings belong to the watcher, not to the scan; start the dropped ones
+    // again (one already running answers first, the repeat is ignored).
+    for (const QString& root : listingsQueued) startListing(root);
+    emitProgress();
+
+    // isScanning() is already false here. The cache is not saved for a
+    // dropped job: its folder was not fully rescanned.
+    for (const auto& job : dropped) {
+        job->report.cancelled = true;
+        emit scanFinished(job->report);
+    }
+}
+
+void LibraryScanner::setConcurrencyLimit(const QString& path, int threads) {
+    poolFor(path)->setMaxThreadCount(std::max(1, threads));
+}
+
+// ========================= Volumes =========================
+QString LibraryScanner::volumeOf(const QString& path) {
+    const QStorageInfo info(path);
+    return info.isValid() ? info.rootPath() : QString();
+}
+
+int LibraryScanner::defaultConcurrency(const QString& volumeRoot) {
+    // Removable and network filesystems seek slowly or sit behind one link;
+    // more than two readers only makes them thrash.
+    const QByteArray fs = QStorageInfo(volumeRoot).fileSystemType().toLower();
+    static const QList<QByteArray> slow = {"vfat", "msdos", "exfat", "fuseblk", "ntfs", "nfs", "nfs4",
+                                           "cifs", "smbfs", "smb3", "9p", "sshfs", "fuse.sshfs"};
+    if (slow.contains(fs)) return 2;
+    return std::max(2, QThread::idealThreadCount());
+}
+
+QStringList LibraryScanner::mountRoots() {
+    QStringList roots;
+    for (const QStorageInfo& v : QStorageInfo::mountedVolumes())
+        if (v.isValid()) roots << v.rootPath();
+    std::sort(roots.begin(), roots.end(), [](const QString& a, const QString& b) { return a.size() > b.size(); });
+    return roots;
+}
+
+// The same answer as volumeOf(path) without a mount table read per path.
+QString LibraryScanner::volumeOf(const QString& path, const QStringList& roots) {
+    for (const QString& root : roots) {
+        if (!path.startsWith(root)) continue;
+        // "/media/usb" is not the root of "/media/usb2/a.flac".
+        if (root.endsWith('/') || path.size() == root.size() || path[root.size()] == '/') return root;
+    }
+    return QString();
+}
+
+QThreadPool* LibraryScanner::poolForVolume(const QString& volume) {
+    auto it = volumePools.find(volume);
+    if (it != volumePools.end()) return it->second.get();
+
+    auto p = std::make_unique<QThreadPool>();
+    p->setMaxThreadCount(volume.isEmpty() ? std::max(2, QThread::idealThreadCount()) : defaultConcurrency(volume));
+    return volumePools.emplace(volume, std::move(p)).first->second.get();
+}
+
+void LibraryScanner::dispatch(const JobPtr& job, const QStringList& paths) {
+    // Group by volume, keeping the order within each group; one mount
+    // table read covers the whole job.
+    const QStringList roots = mountRoots();
+    std::vector<std::pair<QString, QStringList>> groups;
+    for (const QString& p : paths) {
+        const QString volume = volumeOf(p, roots);
+        auto g = std::find_if(groups.begin(), groups.end(), [&](const auto& e) { return e.first == volume; });
+        if (g == groups.end()) g = groups.emplace(groups.end(), volume, QStringList());
+        g->second << p;
+    }
+
+    struct Slice {
+        QThreadPool* workers;
+        QStringList paths;
+    };
+    QVector<Slice> slices;
+    job->paths.clear();
+    for (const auto& [volume, group] : groups) {
+        QThreadPool* workers = poolForVolume(volume);
+        for (int from = 0; from < group.size(); from += kBatchSize) slices.push_back({workers, group.mid(from, kBatchSize)});
+        job->paths << group;
+    }
+    job->report.total = paths.size();
+    job->batchCount = slices.size();
+
+    if (job->batchCount == 0) {
+        jobs.removeOne(job);
+        persistCache(job);
+        emitProgress();
+        emit scanFinished(job->report);
+        return;
+    }
+
+    for (int b = 0; b < job->batchCount; ++b) {
+        const QStringList slice = slices[b].paths;
+
+        slices[b].workers->start([this, job, b, slice] {
+            cache->load();
+
+            QVector<ScannedTrack> tracks;
+            QStringList missing;
+            tracks.reserve(slice.size());
+
+            for (const auto& fullPath : slice) {
+                if (job->cancelled) return;
+
+                QFileInfo info(fullPath);
+                if (!info.exists()) {
+                    missing << info.fileName();
+                    continue;
+                }
+
+                // A cache hit costs three stats: the file and its two sidecar names.
+                const qint64 size = info.size();
+                const qint64 mtimeMs = info.lastModified().toMSecsSinceEpoch();
+                const qint64 lyricsMtimeMs = lyricsSidecarMtime(fullPath);
+
+                ScannedTrack t;
+                if (!cache->lookup(fullPath, size, mtimeMs, lyricsMtimeMs, t)) {
+                    t.path = fullPath;
+                    t.size = size;
+                    t.mtimeMs = mtimeMs;
+                    t.lyricsMtimeMs = lyricsMtimeMs;
+                    readTags(fullPath, info.completeBaseName(), t);
+                    t.lyrics = loadLyricsSidecar(fullPath);
+                    t.packedLyrics = LyricsStore::pack(t.lyrics);
+                    cache->insert(t);
+                } else {
+                    t.lyrics = LyricsStore::unpack(t.packedLyrics);
+                }
+                t.grams = SearchIndex::extractGrams(t.title, t.artist, t.lyrics);
+                t.sortKeys = CollationKey::forTrack(t.title, t.artist, t.album, t.path);
+                t.lyrics.clear(); // only the packed form travels on
+                tracks << t;
+            }
+
+            const int processed = slice.size();
+            QMetaObject::invokeMethod(this, [this, job, b, tracks, missing, processed] {
+                onBatchDone(job, b, tracks, missing, processed);
+            }, Qt::QueuedConnection);
+        });
+    }
+
+    emitProgress();
+}
+
+void LibraryScanner::onBatchDone(const JobPtr& job, int batchIndex, const QVector<ScannedTrack>& tracks,
+                                 const QStringList& missing, int processed) {
+    if (job->cancelled || !jobs.contains(job)) return; // stale result
+
+    job->done += processed;
+    job->report.missingNames << missing;
+    job->pending.insert(batchIndex, tracks);
+
+    // Hand batches to the UI strictly in order so rows keep the sorted order.
+    while (job->pending.contains(job->nextBatch)) {
+        const QVector<ScannedTrack> batch = job->pending.take(job->nextBatch);
+        job->nextBatch++;
+        if (!batch.isEmpty()) emit batchReady(batch);
+        if (job->cancelled) return; // a slot cancelled us
+    }
+
+    if (job->nextBatch == job->batchCount) {
+        jobs.removeOne(job);
+        persistCache(job);
+        emitProgress();
+        emit scanFinished(job->report);
+        return;
+    }
+
+    emitProgress();
+}
+
+void LibraryScanner::persistCache(const JobPtr& job) {
+    const QString folder = job->report.folder;
+    const QStringList paths = job->paths;
+    LibraryCache* c = cache.get(); // outlives the pool (see destructor)
+
+    pool.start([c, folder, paths] {
+        if (!folder.isEmpty()) {
+            // Forget files that disappeared from a folder we fully rescanned.
+            c->retainInFolder(folder, QSet<QString>(paths.cbegin(), paths.cend()));
+        }
+        c->save();
+    });
+}
+
+void LibraryScanner::storeLoudness(const QString& path, const TrackLoudness& loudness) {
+    cache->setLoudness(path, loudness);
+}
+
+void LibraryScanner::storePlayCount(const QString& path, quint32 count) {
+    cache->setPlayCount(path, count);
+}
+
+void LibraryScanner::storeContentHash(const QString& path, quint64 hash, qint64 size, qint64 mtimeMs) {
+    cache->setContentHash(path, hash, size, mtimeMs);
+}
+
+void LibraryScanner::renameCached(const QString& from, const QString& to) {
+    cache->rename(from, to);
+}
+
+SeekIndex LibraryScanner::seekIndexFor(const QString& path) const {
+    cache->load();
+    const QFileInfo info(path);
+    return SeekIndex::decode(cache->seekIndex(path, info.size(), info.lastModified().toMSecsSinceEpoch()));
+}
+
+void LibraryScanner::saveCache() {
+    LibraryCache* c = cache.get();
+    pool.start([c] { c->save(); });
+}
+
+void LibraryScanner::emitProgress() {
+    int done = 0, total = 0;
+    for (const auto& job : jobs) {
+        done += job->done;
+        total += job->report.total;
+    }
+    emit progress(done, total);
+}
+
+// Full-path order keeps each directory's tracks together; collation keys
+// put "2 Intro" before "10 Outro".
+void LibraryScanner::sortPaths(QStringList& paths) {
+    QVector<QByteArray> keys;
+    keys.reserve(paths.size());
+    for (const QString& p : paths) keys << CollationKey::make(p);
+
+    QVector<const QByteArray*> column;
+    column.reserve(keys.size());
+    for (const QByteArray& k : keys) column << &k;
+
+    QStringList sorted;
+    sorted.reserve(paths.size());
+    for (int from : CollationKey::order(column)) sorted << paths[from];
+    paths = std::move(sorted);
+}
+
+// ========================= Metadata =========================
+void LibraryScanner::readTags(const QString& path, const QString& fileNameNoExt, ScannedTrack& t) {
+    AudioTags tags;
+    TagReader::read(path, tags);
+    t.title = tags.title;
+    t.artist = tags.artist;
+    t.album = tags.album;
+    t.trackNumber = tags.trackNumber;
+    t.durationMs = tags.durationMs;
+
+    // Long FLAC files get a seek index unless they carry a good SEEKTABLE.
+    if (t.durationMs >= SeekIndex::kMinDurationMs && QFileInfo(path).suffix().compare("flac", Qt::CaseInsensitive) == 0)
+        t.seekIndex = SeekIndex::build(path).encode();
+
+    // Untagged files: fall back to "Artist - Title" in the file name.
+    if (t.title.isEmpty() || t.artist.isEmpty()) {
+        QString artist, title;
+        parseArtistTitleFromFilename(fileNameNoExt, artist, title);
+        if (t.title.isEmpty()) t.title = title;
+        if (t.artist.isEmpty()) t.artist = artist;
+    }
+}
+
+// ========================= Supported types =========================
+bool LibraryScanner::isSupportedAudio(const QString& path) {
+    QString ext = QFileInfo(path).suffix().toLower();
+    return (ext == "wav" || ext == "ogg" || ext == "flac" || ext == "aiff" || ext == "au");
+}
+
+// ========================= Lyrics =========================
+QString LibraryScanner::cleanLyricsText(QString s) {
+    static const QRegularExpression timestamps(R"(\[\d{1,2}:\d{2}(\.\d{1,2})?\])");
+    s.remove(timestamps);
+    return s;
+}
+
+QString LibraryScanner::loadLyricsSidecar(const QString& audioPath) {
+    QFileInfo fi(audioPath);
+    QDir dir(fi.absolutePath());
+    QString base = fi.completeBaseName();
+
+    QStringList candidates = {
+        dir.filePath(base + ".lrc"),
+        dir.filePath(base + ".txt")
+    };
+
+    for (const auto& p : candidates) {
+        QFile f(p);
+        if (f.open(QIODevice::ReadOnly | QIODevice::Text)) {
+            QString text = QString::fromUtf8(f.readAll());
+            return cleanLyricsText(text);
+        }
+    }
+    return "";
+}
+
+qint64 LibraryScanner::lyricsSidecarMtime(const QString& audioPath) {
+    // Same candidate order as loadLyricsSidecar().
+    QFileInfo fi(audioPath);
+    QDir dir(fi.absolutePath());
+    const QString base = fi.completeBaseName();
+
+    for (const QString& ext : {QStringLiteral(".lrc"), QStringLiteral(".txt")}) {
+        QFileInfo sidecar(dir.filePath(base + ext));
+        if (sidecar.exists()) return sidecar.lastModified().toMSecsSinceEpoch();
+    }
+    return -1;
+}
+
+// ========================= Filename parsing =========================
+void LibraryScanner::parseArtistTitleFromFilename(const QString& fileNameNoExt, QString& artist, QString& title) {
+    QString s = fileNameNoExt.trimmed();
+    const QStringList seps = {" - ", " – ", " — "};
+
+    for (const auto& sep : seps) {
+        int p = s.indexOf(sep);
+        if (p > 0) {
+            artist = s.left(p).trimmed();
+            title  = s.mid(p + sep.length()).trimmed();
+            if (!title.isEmpty()) return;
+        }
+    }
+
+    artist.clear();
+    title = s;
+}
@@ -0,0 +1,173 @@
+/*
+ * Author: Itoro Ifon, jason Hippolite, Prince Umeh
+ * Date: 2026-10-16
+ * Course/Assignment: C++ Project - Qt Music Player
+ * File: libraryscanner.h
+ * Purpose: Declares the LibraryScanner class, which walks folders and reads
+ *          per-track metadata on a worker pool so the GUI thread never blocks.
+ */
+#pragma once
+
+#include <QObject>
+#include <QString>
+#include <QStringList>
+#include <QVector>
+#include <QMap>
+#include <QList>
+#include <QSet>
+#include <QThreadPool>
+
+#include <atomic>
+#include <map>
+#include <memory>
+
+#include "collationkey.h"
+#include "loudnessmeter.h"
+#include "seekindex.h"
+
+class LibraryCache;
+
+// Struct: ScannedTrack
+// Purpose: Metadata produced by a scan worker for one audio file.
+struct ScannedTrack {
+    QString path;
+    QString title;
+    QString artist;
+    QString album;
+    int trackNumber = 0;
+    qint64 durationMs = 0;  // 0: unknown
+    QString lyrics;          // worker side only; cleared before delivery
+    QByteArray packedLyrics; // LyricsStore::pack() of the text, what the model and cache keep
+    QVector<quint64> grams; // SearchIndex trigrams, extracted on the worker
+    SortKeys sortKeys;      // CollationKey of title/artist/album/path, built on the worker
+    TrackLoudness loudness; // filled in later by LoudnessScanner, kept in the cache
+    QByteArray seekIndex;   // SeekIndex::encode() of long FLAC files, kept in the cache
+    quint32 playCount = 0;  // times played to the end; counted by the player, kept in the cache
+    quint64 contentHash = 0; // ContentHash of the audio payload, 0 until DuplicateScanner gets to it
+
+    // File identity, used to validate the on-disk library cache
+    qint64 size = 0;
+    qint64 mtimeMs = 0;
+    qint64 lyricsMtimeMs = -1; // -1: no sidecar
+};
+
+// Struct: ScanReport
+// Purpose: Summary handed to the UI when one scan job completes.
+struct ScanReport {
+    QString folder;              // empty when the job came from scanFiles()
+    bool background = false;     // scanFiles() on behalf of the library watcher
+    bool cancelled = false;      // dropped by cancel(); covers only what was delivered
+    int total = 0;               // supported files submitted to the workers
+    QStringList directories;     // every directory walked, `folder` included
+    QStringList unsupportedNames;
+    QStringList missingNames;
+};
+
+// Struct: TreeListing
+// Purpose: A directory tree walked by listTree(): its directories and the
+//          supported audio files in it, with their size and mtime.
+struct TreeListing {
+    QString root;
+    QStringList directories; // `root` included; symlinked ones are not followed
+    QStringList files;
+    QVector<qint64> sizes;    // of files[i]
+    QVector<qint64> mtimesMs; // of files[i]
+};
+
+// Class: LibraryScanner
+// Purpose: Runs recursive folder walks and metadata extraction on worker
+//          pools. Results are delivered on the GUI thread in submission
+//          order, in batches, so the model can start filling after the
+//          first batch.
+// Notes: cancel() drops every job in flight; late results are discarded,
+//        and each dropped job still gets its scanFinished(), flagged
+//        cancelled.
+//        Tags and duration come from TagReader; the filename fills in a
+//        missing title or artist.
+//        Each storage volume gets its own pool, so a slow USB disk and a
+//        fast SSD are scanned side by side, each at its own concurrency.
+//        A job's paths are grouped by volume (stable, in order of first
+//        appearance) and every batch holds paths from one volume only.
+//        Files whose size/mtime (and sidecar mtime) match the LibraryCache
+//        are taken from the cache without being re-read.
+class LibraryScanner : public QObject {
+    Q_OBJECT
+
+public:
+    explicit LibraryScanner(QObject* parent = nullptr);
+    ~LibraryScanner() override;
+
+    void scanFolder(const QString& folderPath);
+    void scanFiles(const QStringList& filePaths, bool background = false);
+    // Walks `root` on its volume's pool and answers with treeListed(). A
+    // listing survives cancel(); each request is answered once.
+    void listTree(const QString& root);
+    void cancel();
+
+    // Worker threads used for the volume holding `path` (default: see
+    // defaultConcurrency()). Applies to jobs started afterwards.
+    void setConcurrencyLimit(const QString& path, int threads);
+    bool isScanning() const { return !jobs.isEmpty(); }
+
+    // Helpers (thread-safe, used by workers and by the UI)
+    static bool isSupportedAudio(const QString& path);
+    static void parseArtistTitleFromFilename(const QString& fileNameNoExt, QString& artist, QString& title);
+    static QString loadLyricsSidecar(const QString& audioPath);
+    static qint64 lyricsSidecarMtime(const QString& audioPath);
+    static QString cleanLyricsText(QString s);
+    static void readTags(const QString& path, const QString& fileNameNoExt, ScannedTrack& t);
+    static void sortPaths(QStringList& paths); // delivery order of a folder scan
+
+    // Records analysis results in the cache (saved by saveCache() or on exit).
+    void storeLoudness(const QString& path, const TrackLoudness& loudness);
+    void storePlayCount(const QString& path, quint32 count);
+    // Kept only while the cached entry is for the same size/mtime.
+    void storeContentHash(const QString& path, quint64 hash, qint64 size, qint64 mtimeMs);
+    void renameCached(const QString& from, const QString& to);
+
+    // The cached seek index of `path` if the file is unchanged since it was
+    // built, else an empty one. Thread-safe (called from the playback pool).
+    SeekIndex seekIndexFor(const QString& path) const;
+    void saveCache();
+
+signals:
+    void batchReady(const QVector<ScannedTrack>& batch);
+    void progress(int done, int total);
+    void scanFinished(const ScanReport& report);
+    void treeListed(const TreeListing& listing);
+
+private:
+    struct Job {
+        std::atomic<bool> cancelled{false};
+        ScanReport report;
+        QStringList paths;       // supported files, in delivery order
+        int batchCount = 0;
+        int nextBatch = 0;       // next batch index to hand to the UI
+        int done = 0;            // files processed so far
+        QMap<int, QVector<ScannedTrack>> pending; // finished out of order
+    };
+    using JobPtr = std::shared_ptr<Job>;
+
+    void dispatch(const JobPtr& job, const QStringList& paths);
+    void onBatchDone(const JobPtr& job, int batchIndex, const QVector<ScannedTrack>& tracks,
+                     const QStringList& missing, int processed);
+    void emitProgress();
+
+    static constexpr int kBatchSize = 256;
+
+    void persistCache(const JobPtr& job);
+    void startListing(const QString& root);
+
+    QThreadPool* poolFor(const QString& path) { return poolForVolume(volumeOf(path)); }
+    QThreadPool* poolForVolume(const QString& volume);
+    static QString volumeOf(const QString& path);
+    static QStringList mountRoots(); // longest first
+    static QString volumeOf(const QString& path, const QStringList& roots);
+    static int defaultConcurrency(const QString& volumeRoot);
+
+    QThreadPool pool;  // cache I/O; scanning runs on the per-volume pools
+    std::map<QString, std::unique_ptr<QThreadPool>> volumePools;
+    QList<JobPtr> jobs;
+    QSet<QString> listingsQueued; // listTree() roots not answered yet
+    std::unique_ptr<LibraryCache> cache;
+};
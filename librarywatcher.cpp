@@ -0,0 +1,237 @@
+/*
+ * Author: Itoro Ifon, jason Hippolite, Prince Umeh
+ * Date: 2026-10-16
+ * Course/Assignment: C++ Project - Qt Music Player
+ * File: librarywatcher.cpp
+ * Purpose: Implements directory watching and the per-directory diffs behind
+ *          LibraryWatcher.
+ */
+#include "librarywatcher.h"
+
+#include <QDir>
+#include <QFileInfo>
+#include <QDateTime>
+
+#include <utility>
+
+// Editors and copy tools touch a directory many times in a row; diff once.
+static constexpr int kDebounceMs = 300;
+
+LibraryWatcher::LibraryWatcher(LibraryScanner* scanner, QObject* parent) : QObject(parent), scanner(scanner) {
+    debounce.setSingleShot(true);
+    debounce.setInterval(kDebounceMs);
+    connect(&debounce, &QTimer::timeout, this, &LibraryWatcher::flush);
+    connect(&fs, &QFileSystemWatcher::directoryChanged, this, &LibraryWatcher::onDirectoryChanged);
+    connect(scanner, &LibraryScanner::treeListed, this, &LibraryWatcher::onTreeListed);
+}
+
+// ========================= Roots =========================
+void LibraryWatcher::watchRoot(const QString& root, const QStringList& directories) {
+    const QString abs = QDir(root).absolutePath();
+    if (!rootList.contains(abs)) rootList << abs;
+
+    const QStringList current = fs.directories();
+    const QSet<QString> watched(current.cbegin(), current.cend());
+
+    QStringList toWatch;
+    for (const QString& d : directories) {
+        const QString dir = QDir(d).absolutePath();
+        subdirsByDir[dir]; // make sure leaf directories are known too
+        filesByDir[dir];
+        if (dir != abs) subdirsByDir[QFileInfo(dir).absolutePath()].insert(QFileInfo(dir).fileName());
+        if (!watched.contains(dir)) toWatch << dir;
+    }
+    if (!toWatch.isEmpty()) fs.addPaths(toWatch);
+}
+
+void LibraryWatcher::unwatchRoot(const QString& root) {
+    const QString abs = QDir(root).absolutePath();
+    rootList.removeAll(abs);
+
+    const QString prefix = abs + '/';
+    QStringList drop;
+    for (auto it = filesByDir.cbegin(); it != filesByDir.cend(); ++it)
+        if ((it.key() == abs || it.key().startsWith(prefix)) && !underRoot(it.key())) drop << it.key();
+
+    for (const QString& dir : drop) {
+        filesByDir.remove(dir);
+        subdirsByDir.remove(dir);
+        dirty.remove(dir);
+    }
+    if (!drop.isEmpty()) fs.removePaths(drop);
+
+    // Changes held for the root's files are no longer the library's.
+    if (!underRoot(abs)) {
+        dropListings(abs);
+        for (auto* held : {&heldAdded, &heldRemoved}) {
+            for (auto it = held->begin(); it != held->end();) {
+                if (it.key().startsWith(prefix)) it = held->erase(it);
+                else ++it;
+            }
+        }
+    }
+    if (listing.isEmpty()) report();
+}
+
+void LibraryWatcher::clear() {
+    debounce.stop();
+    dirty.clear();
+    heldAdded.clear();
+    heldRemoved.clear();
+    listing.clear(); // late listings are ignored
+    rootList.clear();
+    filesByDir.clear();
+    subdirsByDir.clear();
+    const QStringList watched = fs.directories();
+    if (!watched.isEmpty()) fs.removePaths(watched);
+}
+
+bool LibraryWatcher::underRoot(const QString& path) const {
+    for (const QString& r : rootList)
+        if (path == r || path.startsWith(r + '/')) return true;
+    return false;
+}
+
+void LibraryWatcher::learn(const QVector<ScannedTrack>& batch) {
+    for (const ScannedTrack& t : batch) {
+        const QFileInfo fi(t.path); // string work only, no stat
+        filesByDir[fi.absolutePath()].insert(fi.fileName(), {t.size, t.mtimeMs});
+    }
+}
+
+// ========================= Change handling =========================
+void LibraryWatcher::onDirectoryChanged(const QString& dir) {
+    dirty.insert(dir);
+    debounce.start(); // restart: wait for the burst to settle
+}
+
+void LibraryWatcher::flush() {
+    const QSet<QString> dirs = std::exchange(dirty, {});
+    for (const QString& dir : dirs) {
+        if (!filesByDir.contains(dir)) continue; // forgotten meanwhile
+        diffDirectory(dir, heldAdded, heldRemoved);
+    }
+    if (listing.isEmpty()) report();
+}
+
+void LibraryWatcher::report() {
+    QHash<QString, Identity> added = std::exchange(heldAdded, {});
+    QHash<QString, Identity> removed = std::exchange(heldRemoved, {});
+
+    // Pair vanished files with new ones of the same identity: renames and moves.
+    QHash<QString, QString> newByKey; // "size:mtime" -> added path (unique keys only)
+    QSet<QString> ambiguous;
+    for (auto it = added.cbegin(); it != added.cend(); ++it) {
+        const QString key = QString::number(it->size) + ':' + QString::number(it->mtimeMs);
+        if (newByKey.contains(key)) ambiguous.insert(key);
+        else newByKey.insert(key, it.key());
+    }
+
+    for (auto it = removed.begin(); it != removed.end();) {
+        const QString key = QString::number(it->size) + ':' + QString::number(it->mtimeMs);
+        if (it->size >= 0 && newByKey.contains(key) && !ambiguous.contains(key)) {
+            const QString to = newByKey.take(key);
+            added.remove(to);
+            emit fileRenamed(it.key(), to);
+            it = removed.erase(it);
+        } else {
+            ++it;
+        }
+    }
+
+    if (!removed.isEmpty()) emit filesRemoved(removed.keys());
+    if (!added.isEmpty()) emit filesAdded(added.keys());
+}
+
+void LibraryWatcher::diffDirectory(const QString& dir, QHash<QString, Identity>& added,
+                                   QHash<QString, Identity>& removed) {
+    QDir d(dir);
+    if (!d.exists()) {
+        // The directory itself went away; its parent's diff may already have
+        // handled it, in which case it is no longer known here.
+        forgetTree(dir, removed);
+        const QString parent = QFileInfo(dir).absolutePath();
+        if (subdirsByDir.contains(parent)) subdirsByDir[parent].remove(QFileInfo(dir).fileName());
+        return;
+    }
+
+    // Files: one listing, compared by name.
+    FileMap known = filesByDir.value(dir);
+    FileMap now;
+    const QFileInfoList files = d.entryInfoList(QDir::Files);
+    for (const QFileInfo& fi : files) {
+        if (!LibraryScanner::isSupportedAudio(fi.fileName())) continue;
+        const auto old = known.constFind(fi.fileName());
+        // Keep the scan's identity when we have it; a listing stat is the fallback.
+        now.insert(fi.fileName(), old != known.constEnd() ? old.value()
+                                                          : Identity{fi.size(), fi.lastModified().toMSecsSinceEpoch()});
+    }
+
+    for (auto it = known.cbegin(); it != known.cend(); ++it)
+        if (!now.contains(it.key())) removed.insert(d.filePath(it.key()), it.value());
+    for (auto it = now.cbegin(); it != now.cend(); ++it)
+        if (!known.contains(it.key())) added.insert(d.filePath(it.key()), it.value());
+    filesByDir[dir] = now;
+
+    // Subdirectories: new ones are adopted whole, vanished ones forgotten whole.
+    // (Copied: adopting and forgetting rehash subdirsByDir.)
+    const QSet<QString> knownSubs = subdirsByDir.value(dir);
+    const QStringList subs = d.entryList(QDir::Dirs | QDir::NoDotAndDotDot | QDir::NoSymLinks);
+    const QSet<QString> nowSubs(subs.cbegin(), subs.cend());
+
+    for (const QString& name : knownSubs)
+        if (!nowSubs.contains(name)) forgetTree(d.filePath(name), removed);
+    for (const QString& name : nowSubs) {
+        if (knownSubs.contains(name)) continue;
+        const QString sub = d.filePath(name);
+        listing.insert(sub);
+        scanner->listTree(sub); // adopted in onTreeListed()
+    }
+    subdirsByDir[dir] = nowSubs;
+}
+
+void LibraryWatcher::onTreeListed(const TreeListing& tree) {
+    if (!listing.remove(tree.root)) return; // forgotten or cleared meanwhile
+
+    for (const QString& dir : tree.directories) {
+        filesByDir[dir];
+        subdirsByDir[dir];
+        if (dir != tree.root) subdirsByDir[QFileInfo(dir).absolutePath()].insert(QFileInfo(dir).fileName());
+    }
+    for (int i = 0; i < tree.files.size(); ++i) {
+        const QFileInfo fi(tree.files[i]); // string work only, no stat
+        const Identity id{tree.sizes[i], tree.mtimesMs[i]};
+        filesByDir[fi.absolutePath()].insert(fi.fileName(), id);
+        heldAdded.insert(tree.files[i], id);
+    }
+    fs.addPaths(tree.directories);
+
+    if (listing.isEmpty()) report();
+}
+
+void LibraryWatcher::dropListings(const QString& root) {
+    const QString prefix = root + '/';
+    for (auto it = listing.begin(); it != listing.end();) {
+        if (*it == root || it->startsWith(prefix)) it = listing.erase(it);
+        else ++it;
+    }
+}
+
+void LibraryWatcher::forgetTree(const QString& root, QHash<QString, Identity>& removed) {
+    const QString prefix = root + '/';
+    QStringList drop;
+    for (auto it = filesByDir.cbegin(); it != filesByDir.cend(); ++it) {
+        if (it.key() != root && !it.key().startsWith(prefix)) continue;
+        drop << it.key();
+        const QDir d(it.key());
+        for (auto f = it->cbegin(); f != it->cend(); ++f) removed.insert(d.filePath(f.key()), f.value());
+    }
+
+    for (const QString& dir : drop) {
+        filesByDir.remove(dir);
+        subdirsByDir.remove(dir);
+        dirty.remove(dir);
+    }
+    if (!drop.isEmpty()) fs.removePaths(drop); // already-deleted paths are dropped by Qt
+    dropListings(root);
+}
@@ -0,0 +1,89 @@
+/*
+ * Author: Itoro Ifon, jason Hippolite, Prince Umeh
+ * Date: 2026-10-16
+ * Course/Assignment: C++ Project - Qt Music Player
+ * File: librarywatcher.h
+ * Purpose: Declares LibraryWatcher, which follows the library's root folders
+ *          on disk and reports added, removed and renamed audio files.
+ */
+#pragma once
+
+#include <QObject>
+#include <QString>
+#include <QStringList>
+#include <QHash>
+#include <QSet>
+#include <QVector>
+#include <QTimer>
+#include <QFileSystemWatcher>
+
+#include "libraryscanner.h"
+
+// Class: LibraryWatcher
+// Purpose: Watches every directory under each library root (directory
+//          notifications are not recursive) and turns change bursts into
+//          small diffs: filesAdded(), filesRemoved() and fileRenamed().
+//          A file that disappears and reappears elsewhere with the same size
+//          and mtime within one burst is reported as a rename, which covers
+//          renamed files and moved or renamed directories.
+// Notes: Knows a file's identity from the scan that found it (learn()) or
+//        from the directory listing that noticed it. Only directories that
+//        changed are re-listed, so a diff costs one readdir per directory.
+//        New directory trees are walked by LibraryScanner::listTree() off
+//        the GUI thread; a burst is held back until its trees are listed, so
+//        a directory moved into the library still pairs up as renames.
+class LibraryWatcher : public QObject {
+    Q_OBJECT
+
+public:
+    explicit LibraryWatcher(LibraryScanner* scanner, QObject* parent = nullptr);
+
+    // Starts (or refreshes) watching `root` with the directory list of a
+    // finished scan of it.
+    void watchRoot(const QString& root, const QStringList& directories);
+    void unwatchRoot(const QString& root);
+    void clear();
+    QStringList roots() const { return rootList; }
+
+    // Records size/mtime of scanned files so renames can be recognised.
+    void learn(const QVector<ScannedTrack>& batch);
+
+signals:
+    void filesAdded(const QStringList& paths);
+    void filesRemoved(const QStringList& paths);
+    void fileRenamed(const QString& from, const QString& to);
+
+private:
+    // Size and mtime; cheap enough to keep per file, distinctive enough to
+    // pair a vanished file with a new one.
+    struct Identity {
+        qint64 size = -1;
+        qint64 mtimeMs = 0;
+        bool operator==(const Identity& o) const { return size == o.size && mtimeMs == o.mtimeMs; }
+    };
+    using FileMap = QHash<QString, Identity>; // file name -> identity
+
+    void onDirectoryChanged(const QString& dir);
+    void onTreeListed(const TreeListing& listing); // adopts the tree
+    void flush();
+    void report(); // the held burst, once no listing is outstanding
+
+    void diffDirectory(const QString& dir, QHash<QString, Identity>& added, QHash<QString, Identity>& removed);
+    void forgetTree(const QString& dir, QHash<QString, Identity>& removed);
+    void dropListings(const QString& root); // `root` and everything under it
+    bool underRoot(const QString& path) const;
+
+    LibraryScanner* scanner;
+    QFileSystemWatcher fs;
+    QTimer debounce;
+    QSet<QString> dirty;
+
+    // Changes seen but not reported yet (absolute path -> identity)
+    QHash<QString, Identity> heldAdded;
+    QHash<QString, Identity> heldRemoved;
+    QSet<QString> listing; // new trees the scanner is walking
+
+    QStringList rootList;
+    QHash<QString, FileMap> filesByDir;            // absolute dir -> its audio files
+    QHash<QString, QSet<QString>> subdirsByDir;    // absolute dir -> child dir names
+};
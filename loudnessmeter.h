@@ -0,0 +1,86 @@
+/*
+ * Author: Itoro Ifon, jason Hippolite, Prince Umeh
+ * Date: 2026-10-16
+ * Course/Assignment: C++ Project - Qt Music Player
+ * File: loudnessmeter.h
+ * Purpose: Declares LoudnessMeter, an EBU R128 / ITU-R BS.1770 integrated
+ *          loudness and true-peak meter, and the per-track result stored in
+ *          the library.
+ */
+#pragma once
+
+#include <QVector>
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+// Struct: TrackLoudness
+// Purpose: Analysis result kept with each track (store, cache).
+struct TrackLoudness {
+    bool analyzed = false;
+    float lufs = -70.0f;         // integrated loudness; -70 when nothing passed the gate
+    float truePeakDb = -70.0f;   // dBTP (4x oversampled below 96 kHz)
+    float gatedSeconds = 0.0f;   // audio that passed both gates; weights album pooling
+};
+
+// Class: LoudnessMeter
+// Purpose: Feeds interleaved 16-bit PCM through the K-weighting filter,
+//          gates 400 ms blocks (75 % overlap) at -70 LUFS absolute and
+//          -10 LU relative, and tracks the true peak.
+// Notes: Samples are de-interleaved into planar float buffers so the
+//        per-sample loops (energy sums, the 4x polyphase peak filter) are
+//        plain contiguous loops the compiler vectorizes. The K-weighting
+//        biquads are recursive and run per channel in double precision.
+//        Not thread-safe; use one meter per track.
+class LoudnessMeter {
+public:
+    LoudnessMeter(unsigned sampleRate, unsigned channels);
+
+    void addFrames(const std::int16_t* interleaved, std::size_t frames);
+    TrackLoudness result() const;
+
+    // ReplayGain-style gain to reach `targetLufs`, lowered when needed so
+    // the true peak stays at or below 0 dBTP.
+    static double gainDb(const TrackLoudness& l, double targetLufs = kTargetLufs);
+
+    // Album loudness: power mean of the tracks weighted by gated duration.
+    // Exact for the absolute gate, a close approximation for the relative one.
+    static TrackLoudness combine(const QVector<TrackLoudness>& tracks);
+
+    static constexpr double kTargetLufs = -18.0; // ReplayGain 2.0 reference level
+
+private:
+    struct Biquad {
+        double b0, b1, b2, a1, a2;
+    };
+    struct ChannelState {
+        double s1[2] = {0.0, 0.0}; // transposed direct form II, one per stage
+        double s2[2] = {0.0, 0.0};
+        float history[11] = {};    // previous input samples for the peak filter
+    };
+
+    void filterChannel(ChannelState& st, const float* in, float* out, std::size_t n) const;
+    float channelTruePeak(ChannelState& st, const float* in, std::size_t n);
+
+    unsigned rate;
+    unsigned channelCount;
+    bool oversample;
+    Biquad shelf{};
+    Biquad highPass{};
+    std::vector<double> weights;
+    std::vector<ChannelState> state;
+
+    std::size_t hopFrames;            // 100 ms
+    std::size_t hopFill = 0;
+    double hopEnergy = 0.0;
+    std::vector<double> hops;         // weighted sum of squares per 100 ms hop
+    float peak = 0.0f;                // linear, true peak
+
+    // Scratch, reused between calls
+    std::vector<float> planar;
+    std::vector<float> filtered;
+    std::vector<double> frameEnergy;
+    std::vector<float> padded;
+    std::vector<float> phaseOut;
+};
@@ -0,0 +1,186 @@
+/*
+ * Author: Itoro Ifon, jason Hippolite, Prince Umeh
+ * Date: 2026-10-16
+ * Course/Assignment: C++ Project - Qt Music Player
+ * File: loudnessscanner.cpp
+ * Purpose: Implements the parallel background loudness analysis.
+ */
+#include "loudnessscanner.h"
+#include "playbackengine.h"
+#include "tracer.h"
+
+#include <QMutexLocker>
+#include <QThread>
+
+#include <algorithm>
+#include <vector>
+
+LoudnessScanner::LoudnessScanner(QObject* parent) : QObject(parent) {
+    pool.setMaxThreadCount(QThread::idealThreadCount());
+    pool.setThreadPriority(QThread::LowPriority); // playback and the UI come first
+}
+
+LoudnessScanner::~LoudnessScanner() {
+    cancel();
+    pool.waitForDone();
+}
+
+// ========================= Queue =========================
+void LoudnessScanner::analyze(const QStringList& paths) {
+    {
+        QMutexLocker guard(&lock);
+        if (running == 0 && queue.empty()) {
+            totals = LoudnessStats();
+            wall.start();
+        }
+        for (const QString& p : paths) {
+            if (queued.contains(p)) continue;
+            queued.insert(p);
+            queue.push_back(p);
+            ++totals.queued;
+        }
+    }
+    startWorkers();
+}
+
+void LoudnessScanner::prioritize(const QString& path) {
+    {
+        QMutexLocker guard(&lock);
+        if (queued.contains(path)) {
+            auto it = std::find(queue.begin(), queue.end(), path);
+            if (it == queue.end()) return; // already being measured
+            queue.erase(it);
+        } else {
+            if (running == 0 && queue.empty()) {
+                totals = LoudnessStats();
+                wall.start();
+            }
+            queued.insert(path);
+            ++totals.queued;
+        }
+        queue.push_front(path);
+    }
+    startWorkers();
+}
+
+void LoudnessScanner::cancel() {
+    ++generation;
+    QMutexLocker guard(&lock);
+    queue.clear();
+    queued.clear();
+    outbox.clear();
+}
+
+LoudnessStats LoudnessScanner::stats() const {
+    QMutexLocker guard(&lock);
+    LoudnessStats s = totals;
+    s.threads = pool.maxThreadCount();
+    s.wallSeconds = wall.isValid() ? double(wall.elapsed()) / 1000.0 : 0.0;
+    return s;
+}
+
+void LoudnessScanner::startWorkers() {
+    const quint64 gen = generation;
+    int wanted = 0;
+    {
+        QMutexLocker guard(&lock);
+        wanted = std::min(int(queue.size()), pool.maxThreadCount() - running.load());
+    }
+    for (int i = 0; i < wanted; ++i) {
+        ++running;
+        pool.start([this, gen] { worker(gen); });
+    }
+}
+
+// ========================= Workers =========================
+void LoudnessScanner::worker(quint64 gen) {
+    QElapsedTimer busy;
+    for (;;) {
+        QString path;
+        {
+            QMutexLocker guard(&lock);
+            if (gen != generation || queue.empty()) break;
+            path = queue.front();
+            queue.pop_front();
+        }
+
+        busy.start();
+        TrackLoudness l;
+        double seconds = 0.0;
+        const bool ok = measure(path, l, seconds);
+        const double spent = double(busy.nsecsElapsed()) / 1e9;
+
+        bool flush = false;
+        {
+            QMutexLocker guard(&lock);
+            if (gen != generation) break;
+            queued.remove(path);
+            totals.busySeconds += spent;
+            if (ok) {
+                ++totals.done;
+                totals.audioSeconds += seconds;
+                outbox.push_back({path, l});
+            } else {
+                ++totals.failed;
+            }
+            flush = outbox.size() >= kDeliverEvery;
+        }
+        if (flush) deliver(gen, false);
+    }
+
+    const bool last = --running == 0;
+    deliver(gen, last);
+}
+
+// Hands the outbox to the GUI thread; the last worker out also reports the
+// run's throughput.
+void LoudnessScanner::deliver(quint64 gen, bool final) {
+    QVector<LoudnessResult> batch;
+    LoudnessStats s;
+    {
+        QMutexLocker guard(&lock);
+        if (gen != generation) return;
+        batch.swap(outbox);
+        final = final && queue.empty();
+    }
+    if (final) s = stats();
+
+    QMetaObject::invokeMethod(this, [this, gen, batch, final, s] {
+        if (gen != generation) return;
+        if (!batch.isEmpty()) emit resultsReady(batch);
+
+        const LoudnessStats now = stats();
+        emit progress(now.done + now.failed, now.queued);
+        if (final && !isRunning()) {
+            TRACE_COUNTER("loudness.tracksPerSecondPerCore", s.tracksPerSecondPerCore());
+            emit finished(s);
+        }
+    }, Qt::QueuedConnection);
+}
+
+bool LoudnessScanner::measure(const QString& path, TrackLoudness& out, double& audioSeconds) {
+    TRACE_SCOPE("LoudnessScanner::measure");
+    auto file = PlaybackEngine::openFile(path);
+    if (!file) return false;
+
+    const unsigned channels = file->getChannelCount();
+    const unsigned rate = file->getSampleRate();
+    if (channels == 0 || rate == 0) return false;
+
+    LoudnessMeter meter(rate, channels);
+    std::vector<std::int16_t> buffer(std::size_t(rate / 2) * channels); // 500 ms per read
+    std::uint64_t frames = 0;
+
+    for (;;) {
+        const std::uint64_t got = file->read(buffer.data(), buffer.size());
+        if (got == 0) break;
+        const std::size_t n = std::size_t(got / channels);
+        meter.addFrames(buffer.data(), n);
+        frames += n;
+        if (got < buffer.size()) break;
+    }
+
+    out = meter.result();
+    audioSeconds = double(frames) / double(rate);
+    return true;
+}
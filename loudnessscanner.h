@@ -0,0 +1,93 @@
+/*
+ * Author: Itoro Ifon, jason Hippolite, Prince Umeh
+ * Date: 2026-10-16
+ * Course/Assignment: C++ Project - Qt Music Player
+ * File: loudnessscanner.h
+ * Purpose: Declares LoudnessScanner, which decodes tracks on every core in
+ *          the background and measures their loudness for normalization.
+ */
+#pragma once
+
+#include <QObject>
+#include <QString>
+#include <QStringList>
+#include <QVector>
+#include <QSet>
+#include <QMutex>
+#include <QThreadPool>
+#include <QElapsedTimer>
+
+#include <atomic>
+#include <deque>
+
+#include "loudnessmeter.h"
+
+// Struct: LoudnessResult
+// Purpose: One analyzed track, delivered to the GUI thread.
+struct LoudnessResult {
+    QString path;
+    TrackLoudness loudness;
+};
+
+// Struct: LoudnessStats
+// Purpose: Throughput of the current analysis run, for sizing big libraries.
+struct LoudnessStats {
+    int done = 0;
+    int failed = 0;
+    int queued = 0;
+    int threads = 0;
+    double audioSeconds = 0.0;   // decoded
+    double busySeconds = 0.0;    // summed over workers (≈ core time)
+    double wallSeconds = 0.0;
+
+    double tracksPerSecondPerCore() const { return busySeconds > 0.0 ? done / busySeconds : 0.0; }
+    double realtimePerCore() const { return busySeconds > 0.0 ? audioSeconds / busySeconds : 0.0; }
+};
+
+// Class: LoudnessScanner
+// Purpose: Work queue of paths drained by one worker per core at low thread
+//          priority. Each worker decodes a whole file with SFML into a
+//          LoudnessMeter; results are batched back to the GUI thread.
+// Notes: analyze() skips paths already queued; prioritize() moves a path
+//        (e.g. the track about to play) to the front. cancel() drops the
+//        queue and discards results still in flight.
+class LoudnessScanner : public QObject {
+    Q_OBJECT
+
+public:
+    explicit LoudnessScanner(QObject* parent = nullptr);
+    ~LoudnessScanner() override;
+
+    void analyze(const QStringList& paths);
+    void prioritize(const QString& path);
+    void cancel();
+
+    bool isRunning() const { return running > 0; }
+    LoudnessStats stats() const;
+
+    // Decodes and measures one file (any thread). False if it can't be read.
+    static bool measure(const QString& path, TrackLoudness& out, double& audioSeconds);
+
+signals:
+    void resultsReady(const QVector<LoudnessResult>& results);
+    void progress(int done, int total);
+    void finished(const LoudnessStats& stats);
+
+private:
+    void startWorkers();
+    void worker(quint64 generation);
+    void deliver(quint64 generation, bool final);
+
+    static constexpr int kDeliverEvery = 32;
+
+    QThreadPool pool;
+    std::atomic<quint64> generation{0};
+    std::atomic<int> running{0};
+
+    mutable QMutex lock;              // guards everything below
+    std::deque<QString> queue;
+    QSet<QString> queued;
+    QVector<LoudnessResult> outbox;
+    LoudnessStats totals;
+    QElapsedTimer wall;
+};
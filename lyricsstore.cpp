@@ -0,0 +1,94 @@
+/*
+ * Author: Itoro Ifon, jason Hippolite, Prince Umeh
+ * Date: 2026-10-16
+ * Course/Assignment: C++ Project - Qt Music Player
+ * File: lyricsstore.cpp
+ * Purpose: Implements the compressed, spill-to-disk lyrics pool.
+ */
+#include "lyricsstore.h"
+
+#include <QDir>
+#include <QStandardPaths>
+#include <QtEndian>
+
+// ========================= Packing =========================
+QByteArray LyricsStore::pack(const QString& text) {
+    if (text.isEmpty()) return {};
+    return qCompress(text.toUtf8());
+}
+
+QString LyricsStore::unpack(const QByteArray& packed) {
+    if (packed.isEmpty()) return {};
+    return QString::fromUtf8(qUncompress(packed));
+}
+
+// ========================= Storage =========================
+LyricsStore::~LyricsStore() {
+    clear();
+}
+
+LyricsRef LyricsStore::add(const QByteArray& packed) {
+    if (packed.size() < 4) return {};
+
+    // qCompress() leads with the big-endian UTF-8 length.
+    const quint32 utf8Bytes = qFromBigEndian<quint32>(packed.constData());
+    unpackedBytes += qint64(sizeof(QArrayData)) + qint64(utf8Bytes + 1) * qint64(sizeof(QChar)); // ~ASCII lyrics
+
+    if (tail.size() + packed.size() > kSegmentBytes && !tail.isEmpty()) sealTail();
+    const LyricsRef ref{quint32(segments.size()), quint32(tail.size()), quint32(packed.size())};
+    tail.append(packed);
+    return ref;
+}
+
+QString LyricsStore::text(const LyricsRef& ref) const {
+    if (ref.size == 0) return {};
+    const char* base = int(ref.segment) < segments.size() ? segments[ref.segment].data : tail.constData();
+    // Non-owning view; qUncompress() copies out of it.
+    return unpack(QByteArray::fromRawData(base + ref.offset, qsizetype(ref.size)));
+}
+
+void LyricsStore::sealTail() {
+    Segment seg;
+    if (!spillFailed && !spill.isOpen()) {
+        // Disk-backed, like WaveformProvider's cache; /tmp may live in RAM.
+        const QString dir = QStandardPaths::writableLocation(QStandardPaths::CacheLocation);
+        spill.setFileTemplate(QDir(dir).filePath("lyrics-XXXXXX"));
+        spillFailed = !QDir().mkpath(dir) || !spill.open();
+    }
+
+    if (!spillFailed) {
+        const qint64 at = spill.size();
+        uchar* view = nullptr;
+        if (spill.seek(at) && spill.write(tail) == tail.size() && spill.flush())
+            view = spill.map(at, tail.size());
+        if (view) {
+            seg.data = reinterpret_cast<const char*>(view);
+            mapped += tail.size();
+        } else {
+            spillFailed = true;
+        }
+    }
+    if (!seg.data) {
+        seg.held = tail;
+        seg.data = seg.held.constData();
+    }
+
+    segments.append(seg);
+    tail = QByteArray();
+}
+
+void LyricsStore::clear() {
+    for (const Segment& seg : segments)
+        if (seg.held.isNull()) spill.unmap(reinterpret_cast<uchar*>(const_cast<char*>(seg.data)));
+    segments.clear();
+    if (spill.isOpen()) spill.resize(0);
+    tail = QByteArray();
+    unpackedBytes = 0;
+    mapped = 0;
+}
+
+qint64 LyricsStore::residentBytes() const {
+    qint64 bytes = tail.capacity() + segments.capacity() * qint64(sizeof(Segment));
+    for (const Segment& seg : segments) bytes += seg.held.capacity();
+    return bytes;
+}
@@ -0,0 +1,74 @@
+/*
+ * Author: Itoro Ifon, jason Hippolite, Prince Umeh
+ * Date: 2026-10-16
+ * Course/Assignment: C++ Project - Qt Music Player
+ * File: lyricsstore.h
+ * Purpose: Declares LyricsStore, where the playlist keeps lyrics compressed
+ *          and (once there is enough of it) memory-mapped instead of as
+ *          resident text.
+ */
+#pragma once
+
+#include <QByteArray>
+#include <QString>
+#include <QTemporaryFile>
+#include <QVector>
+
+// Struct: LyricsRef
+// Purpose: Where one track's compressed lyrics live. size 0: no lyrics.
+struct LyricsRef {
+    quint32 segment = 0;
+    quint32 offset = 0;
+    quint32 size = 0;
+};
+
+// Class: LyricsStore
+// Purpose: Append-only pool of compressed lyrics. Texts are packed on the
+//          scan workers (pack()) and only unpacked when something needs the
+//          words: search confirming a trigram candidate, or display.
+// Notes: GUI thread only, except the static pack()/unpack(). New texts
+//        collect in an in-memory tail; every kSegmentBytes the tail moves
+//        to a temporary file in the cache directory (not the temp
+//        directory, which is often tmpfs and would keep the pages in RAM)
+//        and is read back through a mapping, so the OS can drop the pages
+//        nobody touches. If the file cannot be created or
+//        mapped the segment just stays in memory. Space of removed tracks is
+//        only reclaimed by clear().
+class LyricsStore {
+public:
+    LyricsStore() = default;
+    ~LyricsStore();
+    LyricsStore(const LyricsStore&) = delete;
+    LyricsStore& operator=(const LyricsStore&) = delete;
+
+    // zlib over UTF-8; empty text packs to an empty array.
+    static QByteArray pack(const QString& text);
+    static QString unpack(const QByteArray& packed);
+
+    LyricsRef add(const QByteArray& packed);
+    QString text(const LyricsRef& ref) const;
+    void clear();
+
+    // What the lyrics would cost as resident QStrings, what they cost here,
+    // and how much of that is mapped (reclaimable) rather than heap.
+    qint64 textBytes() const { return unpackedBytes; }
+    qint64 residentBytes() const;
+    qint64 mappedBytes() const { return mapped; }
+
+    static constexpr int kSegmentBytes = 4 * 1024 * 1024;
+
+private:
+    struct Segment {
+        const char* data = nullptr;
+        QByteArray held; // used when the segment could not be mapped
+    };
+
+    void sealTail();
+
+    QVector<Segment> segments;
+    QByteArray tail;
+    QTemporaryFile spill;
+    bool spillFailed = false;
+    qint64 unpackedBytes = 0;
+    qint64 mapped = 0;
+};
@@ -1,28 +1,37 @@
-/*
- * Author: Itoro Ifon, jason Hippolite, Prince Umeh
- * Date: 2026-01-22
- * Course/Assignment: C++ Project - Qt Music Player
- * File: main.cpp
- * Purpose: Application entry point. Creates the Qt application object and
- *          launches the main window.
- */
-#include <QApplication>
-#include "mainwindow.h"
-/*
- * Function: main
- * Purpose: Creates the QApplication instance and displays the main window.
- * Parameters:
- *   - argc: number of command-line arguments
- *   - argv: array of command-line argument strings
- * Returns:
- *   - int: application exit code (0 means successful exit)
- */
-
-int main(int argc, char *argv[])
-{
-    QApplication app(argc, argv);
-    MainWindow w;
-    w.setWindowTitle("Qt Music Player");
-    w.show();
-    return app.exec();
-}
+/*
+ * Author: Itoro Ifon, jason Hippolite, Prince Umeh
+ * Date: 2026-01-22
+ * Course/Assignment: C++ Project - Qt Music Player
+ * File: main.cpp
+ * Purpose: Application entry point. Creates the Qt application object and
+ *          launches the main window.
+ */
+#include <QApplication>
+#include "mainwindow.h"
+#include "tracer.h"
+/*
+ * Function: main
+ * Purpose: Creates the QApplication instance and displays the main window.
+ * Parameters:
+ *   - argc: number of command-line arguments
+ *   - argv: array of command-line argument strings
+ * Returns:
+ *   - int: application exit code (0 means successful exit)
+ */
+
+int main(int argc, char *argv[])
+{
+    QApplication app(argc, argv);
+
+    // QTMUSICPLAYER_TRACE=<file>: record from startup, write the trace on exit.
+    const QString tracePath = qEnvironmentVariable("QTMUSICPLAYER_TRACE");
+    if (!tracePath.isEmpty()) Tracer::setEnabled(true);
+
+    MainWindow w;
+    w.setWindowTitle("Qt Music Player");
+    w.show();
+    const int rc = app.exec();
+
+    if (!tracePath.isEmpty()) Tracer::writeChromeTrace(tracePath);
+    return rc;
+}
@@ -1,839 +1,1383 @@
-/*
- * Author: Itoro Ifon, jason Hippolite, Prince Umeh
- * Date: 2026-01-22
- * Course/Assignment: C++ Project - Qt Music Player
- * File: MainWindow.h
- * Purpose: Declares the MainWindow class, which provides the user interface
- *          and connects UI actions to music playback logic.
- */
-#include "mainwindow.h"
-
-#include <QVBoxLayout>
-#include <QHBoxLayout>
-#include <QFileDialog>
-#include <QMessageBox>
-#include <QDirIterator>
-#include <QFileInfo>
-#include <QHeaderView>
-#include <QWidget>
-#include <QStyle>
-#include <QRegularExpression>
-#include <QMenu>
-#include <QDesktopServices>
-#include <QUrl>
-#include <QDragEnterEvent>
-#include <QDropEvent>
-#include <QMimeData>
-#include <QFile>
-#include <QDir>
-
-#include <QSettings>     //  session persistence
-#include <QCloseEvent>   //  closeEvent override
-
-#include <algorithm>
-
-// Class: MusicPlayerWindow
-// Purpose: Main UI window for the music player. Handles user interactions,
-//          playlist display, searching, and controlling audio playback.
-// Function: addSongs()
-// Purpose: Opens a file dialog to let the user select audio files, validates
-//          supported formats, then adds valid tracks to the playlist/list.
-// Parameters: None
-// Returns: void
-// Notes: Currently supports WAV only.
-
-
-// Source model columns
-static constexpr int COL_TITLE  = 0;
-static constexpr int COL_ARTIST = 1;
-static constexpr int COL_LYRICS = 2; // hidden but searchable
-static constexpr int COL_PATH   = 3; // hidden
-
-static void showError(QWidget* parent, const QString& title, const QString& msg) {
-    QMessageBox::warning(parent, title, msg);
-}
-
-// ===== Filter Title OR Artist OR Lyrics =====
-bool TrackFilterModel::filterAcceptsRow(int row, const QModelIndex& parent) const {
-    auto re = filterRegularExpression();
-    if (!re.isValid() || re.pattern().isEmpty()) return true;
-
-    for (int col : {COL_TITLE, COL_ARTIST, COL_LYRICS}) {
-        QModelIndex idx = sourceModel()->index(row, col, parent);
-        const QString text = sourceModel()->data(idx).toString();
-        if (text.contains(re)) return true;
-    }
-    return false;
-}
-
-MainWindow::MainWindow(QWidget *parent) : QMainWindow(parent) {
-    setAcceptDrops(true);
-
-    buildUI();
-    applyThemeLite();
-
-    music.setVolume(70.f);
-    volumeSlider->setValue(70);
-
-    timer = new QTimer(this);
-    connect(timer, &QTimer::timeout, this, &MainWindow::tick);
-    timer->start(200);
-
-    refreshPlayPauseIcon();
-    updateCountLabel();
-
-    // ✅ Restore last session (folder + track + position)
-    restoreLastSession();
-}
-
-// ========================= UI =========================
-void MainWindow::buildUI() {
-    auto* central = new QWidget(this);
-    setCentralWidget(central);
-
-    openBtn = new QPushButton("Open Folder");
-    openBtn->setIcon(style()->standardIcon(QStyle::SP_DirOpenIcon));
-    connect(openBtn, &QPushButton::clicked, this, &MainWindow::openFolder);
-
-    searchBox = new QLineEdit();
-    searchBox->setPlaceholderText("Search by song name, artist, or lyrics…");
-    searchBox->setClearButtonEnabled(true);
-
-    countLabel = new QLabel("0 songs");
-    countLabel->setAlignment(Qt::AlignRight | Qt::AlignVCenter);
-
-    auto* topRow = new QHBoxLayout();
-    topRow->addWidget(openBtn);
-    topRow->addSpacing(10);
-    topRow->addWidget(new QLabel("Search:"));
-    topRow->addWidget(searchBox, 1);
-    topRow->addWidget(countLabel);
-
-    model = new QStandardItemModel(this);
-    model->setColumnCount(4);
-    model->setHeaderData(COL_TITLE,  Qt::Horizontal, "Title");
-    model->setHeaderData(COL_ARTIST, Qt::Horizontal, "Artist");
-    model->setHeaderData(COL_LYRICS, Qt::Horizontal, "Lyrics");
-    model->setHeaderData(COL_PATH,   Qt::Horizontal, "Path");
-
-    proxy = new TrackFilterModel(this);
-    proxy->setSourceModel(model);
-    proxy->setFilterCaseSensitivity(Qt::CaseInsensitive);
-
-    table = new QTableView();
-    table->setModel(proxy);
-    table->setSelectionBehavior(QAbstractItemView::SelectRows);
-    table->setSelectionMode(QAbstractItemView::SingleSelection);
-    table->setEditTriggers(QAbstractItemView::NoEditTriggers);
-    table->setShowGrid(false);
-    table->setAlternatingRowColors(true);
-    table->verticalHeader()->setVisible(false);
-    table->horizontalHeader()->setStretchLastSection(true);
-    table->horizontalHeader()->setHighlightSections(false);
-    table->verticalHeader()->setDefaultSectionSize(30);
-
-    table->setColumnHidden(COL_LYRICS, true);
-    table->setColumnHidden(COL_PATH, true);
-
-    connect(table, &QTableView::doubleClicked, this, &MainWindow::onDoubleClick);
-
-    table->setContextMenuPolicy(Qt::CustomContextMenu);
-    connect(table, &QTableView::customContextMenuRequested, this, &MainWindow::onContextMenu);
-
-    connect(searchBox, &QLineEdit::textChanged, this, [this](const QString& text) {
-        QRegularExpression re(QRegularExpression::escape(text),
-                              QRegularExpression::CaseInsensitiveOption);
-        proxy->setFilterRegularExpression(re);
-        updateCountLabel();
-    });
-
-    // ===== Mini Player Bar =====
-    playerBar = new QFrame();
-    playerBar->setObjectName("playerBar");
-
-    artLabel = new QLabel();
-    artLabel->setFixedSize(56, 56);
-
-    bigTitleLabel = new QLabel("No song selected");
-    bigTitleLabel->setObjectName("bigTitle");
-
-    bigArtistLabel = new QLabel("—");
-    bigArtistLabel->setObjectName("bigArtist");
-
-    auto* metaCol = new QVBoxLayout();
-    metaCol->setSpacing(2);
-    metaCol->addWidget(bigTitleLabel);
-    metaCol->addWidget(bigArtistLabel);
-
-    prevBtn = new QPushButton();
-    prevBtn->setIcon(style()->standardIcon(QStyle::SP_MediaSkipBackward));
-    connect(prevBtn, &QPushButton::clicked, this, &MainWindow::prev);
-
-    playPauseBtn = new QPushButton();
-    connect(playPauseBtn, &QPushButton::clicked, this, &MainWindow::togglePlayPause);
-
-    stopBtn = new QPushButton();
-    stopBtn->setIcon(style()->standardIcon(QStyle::SP_MediaStop));
-    connect(stopBtn, &QPushButton::clicked, this, &MainWindow::stop);
-
-    nextBtn = new QPushButton();
-    nextBtn->setIcon(style()->standardIcon(QStyle::SP_MediaSkipForward));
-    connect(nextBtn, &QPushButton::clicked, this, &MainWindow::next);
-
-    auto* controlsRow = new QHBoxLayout();
-    controlsRow->setSpacing(8);
-    controlsRow->addWidget(prevBtn);
-    controlsRow->addWidget(playPauseBtn);
-    controlsRow->addWidget(stopBtn);
-    controlsRow->addWidget(nextBtn);
-
-    seekSlider = new QSlider(Qt::Horizontal);
-    seekSlider->setRange(0, 1000);
-    connect(seekSlider, &QSlider::sliderPressed, this, &MainWindow::seekPressed);
-    connect(seekSlider, &QSlider::sliderReleased, this, &MainWindow::seekReleased);
-
-    timeLabel = new QLabel("0:00 / 0:00");
-    timeLabel->setMinimumWidth(90);
-    timeLabel->setAlignment(Qt::AlignRight | Qt::AlignVCenter);
-
-    auto* seekRow = new QHBoxLayout();
-    seekRow->addWidget(seekSlider, 1);
-    seekRow->addWidget(timeLabel);
-
-    volumeSlider = new QSlider(Qt::Horizontal);
-    volumeSlider->setRange(0, 100);
-    connect(volumeSlider, &QSlider::valueChanged, this, &MainWindow::volumeChanged);
-
-    auto* volRow = new QHBoxLayout();
-    volRow->addWidget(new QLabel("Volume"));
-    volRow->addWidget(volumeSlider, 1);
-
-    auto* rightCol = new QVBoxLayout();
-    rightCol->setSpacing(8);
-    rightCol->addLayout(controlsRow);
-    rightCol->addLayout(seekRow);
-    rightCol->addLayout(volRow);
-
-    auto* barLayout = new QHBoxLayout(playerBar);
-    barLayout->setContentsMargins(14, 12, 14, 12);
-    barLayout->setSpacing(12);
-    barLayout->addWidget(artLabel);
-    barLayout->addLayout(metaCol, 1);
-    barLayout->addLayout(rightCol, 2);
-
-    auto* layout = new QVBoxLayout(central);
-    layout->setSpacing(12);
-    layout->setContentsMargins(14, 14, 14, 14);
-    layout->addLayout(topRow);
-    layout->addWidget(table, 1);
-    layout->addWidget(playerBar);
-
-    resize(980, 620);
-    setArtworkPixmap(QPixmap());
-}
-
-void MainWindow::applyThemeLite() {
-    setStyleSheet(R"(
-QMainWindow { background: #1a2130; color: #eef2ff; }
-QLabel { color: #eef2ff; }
-QLineEdit {
-    background: #232c3e;
-    border: 1px solid #3b4a66;
-    padding: 8px 10px;
-    border-radius: 10px;
-    color: #eef2ff;
-}
-QPushButton {
-    background: #273149;
-    border: 1px solid #3b4a66;
-    padding: 8px 12px;
-    border-radius: 10px;
-    color: #eef2ff;
-}
-QPushButton:hover { background: #2d3954; }
-QPushButton:pressed { background: #20283b; }
-QTableView {
-    background: #1f2740;
-    border: 1px solid #3b4a66;
-    border-radius: 14px;
-    selection-background-color: #3b82f6;
-    selection-color: white;
-}
-QHeaderView::section {
-    background: #232c3e;
-    color: #dbe3ff;
-    padding: 10px;
-    border: none;
-}
-QTableView::item { padding: 8px; }
-QFrame#playerBar {
-    background: #232c3e;
-    border: 1px solid #3b4a66;
-    border-radius: 18px;
-}
-QLabel#bigTitle { font-size: 16px; font-weight: 600; color: #f3f6ff; }
-QLabel#bigArtist { font-size: 12px; color: #b8c3e6; }
-QSlider::groove:horizontal { background: #3b4a66; height: 6px; border-radius: 3px; }
-QSlider::handle:horizontal { background: #3b82f6; width: 14px; margin: -6px 0; border-radius: 7px; }
-)");
-}
-
-void MainWindow::refreshPlayPauseIcon() {
-    if (music.getStatus() == sf::Sound::Status::Playing)
-        playPauseBtn->setIcon(style()->standardIcon(QStyle::SP_MediaPause));
-    else
-        playPauseBtn->setIcon(style()->standardIcon(QStyle::SP_MediaPlay));
-}
-
-// ========================= Drag & Drop =========================
-void MainWindow::dragEnterEvent(QDragEnterEvent* e) {
-    if (e->mimeData()->hasUrls()) e->acceptProposedAction();
-}
-
-void MainWindow::dropEvent(QDropEvent* e) {
-    if (!e->mimeData()->hasUrls()) return;
-
-    QStringList files;
-    QString folder;
-    QStringList unsupported;
-
-    for (const auto& url : e->mimeData()->urls()) {
-        const QString path = url.toLocalFile();
-        if (path.isEmpty()) continue;
-
-        QFileInfo fi(path);
-        if (fi.isDir()) folder = path;
-        else if (fi.isFile()) {
-            if (isSupportedAudio(path)) files << path;
-            else unsupported << fi.fileName();
-        }
-    }
-
-    if (!unsupported.isEmpty()) {
-        showError(this, "Unsupported files dropped",
-                  "These files are not supported and were ignored:\n- " + unsupported.join("\n- ")
-                      + "\n\nSupported: .wav .ogg .flac .aiff .au");
-    }
-
-    if (!folder.isEmpty()) { loadFolder(folder); return; }
-    if (!files.isEmpty())  { addFiles(files); return; }
-}
-
-// ========================= Supported types =========================
-bool MainWindow::isSupportedAudio(const QString& path) {
-    QString ext = QFileInfo(path).suffix().toLower();
-    return (ext == "wav" || ext == "ogg" || ext == "flac" || ext == "aiff" || ext == "au");
-}
-
-// ========================= Folder load =========================
-void MainWindow::openFolder() {
-    QString dir = QFileDialog::getExistingDirectory(this, "Select Music Folder");
-    if (!dir.isEmpty()) loadFolder(dir);
-}
-
-void MainWindow::loadFolder(const QString& folderPath) {
-    lastLoadedFolder = folderPath; // ✅ remember folder
-
-    stoppedByUser = true;
-    wasPlaying = false;
-    music.stop();
-    currentIndex = -1;
-
-    playlistFullPaths.clear();
-    model->removeRows(0, model->rowCount());
-    searchBox->clear();
-
-    bigTitleLabel->setText("No song selected");
-    bigArtistLabel->setText("—");
-    timeLabel->setText("0:00 / 0:00");
-    seekSlider->setValue(0);
-    setArtworkPixmap(QPixmap());
-    refreshPlayPauseIcon();
-
-    QDirIterator it(folderPath, QDir::Files);
-    QStringList supportedPaths;
-    QStringList unsupportedNames;
-
-    while (it.hasNext()) {
-        QString path = it.next();
-        if (isSupportedAudio(path)) supportedPaths << path;
-        else unsupportedNames << QFileInfo(path).fileName();
-    }
-
-    if (supportedPaths.isEmpty()) {
-        showError(this, "No supported audio files",
-                  "No supported audio files found in:\n" + folderPath +
-                      "\n\nSupported: .wav .ogg .flac .aiff .au");
-        updateCountLabel();
-        return;
-    }
-
-    std::sort(supportedPaths.begin(), supportedPaths.end(), [](const QString& a, const QString& b) {
-        return a.toLower() < b.toLower();
-    });
-
-    addFiles(supportedPaths);
-
-    if (!unsupportedNames.isEmpty()) {
-        QMessageBox::information(this, "Some files ignored",
-                                 "Ignored unsupported files in this folder (examples):\n- "
-                                     + unsupportedNames.mid(0, 12).join("\n- ")
-                                     + (unsupportedNames.size() > 12 ? "\n..." : "")
-                                     + "\n\nSupported: .wav .ogg .flac .aiff .au");
-    }
-
-    if (!playlistFullPaths.isEmpty()) {
-        currentIndex = 0;
-        QModelIndex srcIdx = model->index(0, 0);
-        QModelIndex pxIdx = proxy->mapFromSource(srcIdx);
-        if (pxIdx.isValid()) table->selectRow(pxIdx.row());
-        updateNowPlaying();
-        updateTimeUI();
-    }
-}
-
-// ========================= Lyrics =========================
-QString MainWindow::cleanLyricsText(QString s) {
-    s.remove(QRegularExpression(R"(\[\d{1,2}:\d{2}(\.\d{1,2})?\])"));
-    return s;
-}
-
-QString MainWindow::loadLyricsSidecar(const QString& audioPath) {
-    QFileInfo fi(audioPath);
-    QDir dir(fi.absolutePath());
-    QString base = fi.completeBaseName();
-
-    QStringList candidates = {
-        dir.filePath(base + ".lrc"),
-        dir.filePath(base + ".txt")
-    };
-
-    for (const auto& p : candidates) {
-        QFile f(p);
-        if (f.open(QIODevice::ReadOnly | QIODevice::Text)) {
-            QString text = QString::fromUtf8(f.readAll());
-            return cleanLyricsText(text);
-        }
-    }
-    return "";
-}
-
-// ========================= Add files =========================
-void MainWindow::addFiles(const QStringList& filePaths) {
-    QStringList failedToAdd;
-
-    for (const auto& fullPath : filePaths) {
-        if (!isSupportedAudio(fullPath)) continue;
-        if (playlistFullPaths.contains(fullPath)) continue;
-
-        if (!QFileInfo::exists(fullPath)) {
-            failedToAdd << QFileInfo(fullPath).fileName();
-            continue;
-        }
-
-        QFileInfo info(fullPath);
-        QString baseName = info.completeBaseName();
-
-        QString artist, title;
-        parseArtistTitleFromFilename(baseName, artist, title);
-
-        QString lyricsText = loadLyricsSidecar(fullPath);
-
-        QList<QStandardItem*> row;
-        row << new QStandardItem(title);
-        row << new QStandardItem(artist);
-        row << new QStandardItem(lyricsText);
-        row << new QStandardItem(fullPath);
-
-        model->appendRow(row);
-        playlistFullPaths << fullPath;
-    }
-
-    updateCountLabel();
-
-    if (!failedToAdd.isEmpty()) {
-        showError(this, "Some files couldn't be added",
-                  "These files were missing or inaccessible:\n- " + failedToAdd.join("\n- "));
-    }
-}
-
-// ========================= Load a track =========================
-bool MainWindow::loadIndex(int sourceRow) {
-    if (sourceRow < 0 || sourceRow >= playlistFullPaths.size()) return false;
-
-    const QString path = playlistFullPaths[sourceRow];
-
-    if (!QFileInfo::exists(path)) {
-        showError(this, "File missing",
-                  "This file no longer exists:\n" + path +
-                      "\n\nRemove it from playlist or reload folder.");
-        return false;
-    }
-
-    music.stop();
-    currentIndex = sourceRow;
-
-    if (!music.openFromFile(path.toStdString())) {
-        showError(this, "Playback failed",
-                  "SFML could not open this file:\n" + path +
-                      "\n\nPossible reasons:\n"
-                      "- File is corrupted\n"
-                      "- Unsupported codec inside the container\n"
-                      "- Permission issues\n"
-                      "\nTry converting it to WAV/OGG/FLAC again.");
-        return false;
-    }
-
-    QModelIndex srcIdx = model->index(sourceRow, 0);
-    QModelIndex pxIdx = proxy->mapFromSource(srcIdx);
-    if (pxIdx.isValid()) table->selectRow(pxIdx.row());
-
-    updateNowPlaying();
-    updateTimeUI();
-    return true;
-}
-
-// ========================= Playlist actions =========================
-void MainWindow::onDoubleClick(const QModelIndex& index) {
-    if (!index.isValid()) return;
-
-    int sourceRow = proxy->mapToSource(index).row();
-    if (!loadIndex(sourceRow)) return;
-
-    music.play();
-    stoppedByUser = false;
-    refreshPlayPauseIcon();
-}
-
-void MainWindow::onContextMenu(const QPoint& pos) {
-    QModelIndex proxyIdx = table->indexAt(pos);
-    if (!proxyIdx.isValid()) return;
-
-    int sourceRow = proxy->mapToSource(proxyIdx).row();
-    if (sourceRow < 0 || sourceRow >= playlistFullPaths.size()) return;
-
-    QMenu menu(this);
-    QAction* actPlay     = menu.addAction("Play");
-    QAction* actPlayNext = menu.addAction("Play Next");
-    menu.addSeparator();
-    QAction* actReveal   = menu.addAction("Reveal in Explorer");
-    QAction* actRemove   = menu.addAction("Remove from Playlist");
-
-    QAction* chosen = menu.exec(table->viewport()->mapToGlobal(pos));
-    if (!chosen) return;
-
-    if (chosen == actPlay) {
-        if (!loadIndex(sourceRow)) return;
-        music.play();
-        stoppedByUser = false;
-        refreshPlayPauseIcon();
-        return;
-    }
-
-    if (chosen == actPlayNext) {
-        if (currentIndex < 0) return;
-        if (sourceRow == currentIndex || sourceRow == currentIndex + 1) return;
-
-        QList<QStandardItem*> rowItems = model->takeRow(sourceRow);
-        QString path = playlistFullPaths.takeAt(sourceRow);
-
-        int insertPos = currentIndex + 1;
-        if (insertPos > model->rowCount()) insertPos = model->rowCount();
-
-        model->insertRow(insertPos, rowItems);
-        playlistFullPaths.insert(insertPos, path);
-
-        if (sourceRow < currentIndex) currentIndex -= 1;
-
-        updateCountLabel();
-        return;
-    }
-
-    if (chosen == actReveal) {
-        QString path = playlistFullPaths[sourceRow];
-        QDesktopServices::openUrl(QUrl::fromLocalFile(QFileInfo(path).absolutePath()));
-        return;
-    }
-
-    if (chosen == actRemove) {
-        if (sourceRow == currentIndex) {
-            stop();
-            currentIndex = -1;
-            bigTitleLabel->setText("No song selected");
-            bigArtistLabel->setText("—");
-            setArtworkPixmap(QPixmap());
-        } else if (sourceRow < currentIndex) {
-            currentIndex -= 1;
-        }
-
-        model->removeRow(sourceRow);
-        playlistFullPaths.removeAt(sourceRow);
-        updateCountLabel();
-        return;
-    }
-}
-
-// ========================= Controls =========================
-void MainWindow::togglePlayPause() {
-    if (playlistFullPaths.isEmpty()) {
-        showError(this, "No songs", "Load a folder or drop audio files first.");
-        return;
-    }
-
-    if (currentIndex < 0) {
-        if (!loadIndex(0)) return;
-    }
-
-    if (music.getStatus() == sf::Sound::Status::Playing) {
-        music.pause();
-        stoppedByUser = false;
-    } else {
-        music.play();
-        stoppedByUser = false;
-    }
-
-    refreshPlayPauseIcon();
-    saveSession(true); // save immediately on play/pause
-}
-
-void MainWindow::stop() {
-    music.stop();
-    stoppedByUser = true;
-    wasPlaying = false;
-    refreshPlayPauseIcon();
-    updateTimeUI();
-    saveSession(true);
-}
-
-void MainWindow::next() {
-    if (playlistFullPaths.isEmpty()) return;
-
-    int last = playlistFullPaths.size() - 1;
-    int nxt = std::min(currentIndex + 1, last);
-
-    if (!loadIndex(nxt)) return;
-    music.play();
-    stoppedByUser = false;
-    refreshPlayPauseIcon();
-    saveSession(true);
-}
-
-void MainWindow::prev() {
-    if (playlistFullPaths.isEmpty()) return;
-
-    int prv = std::max(currentIndex - 1, 0);
-
-    if (!loadIndex(prv)) return;
-    music.play();
-    stoppedByUser = false;
-    refreshPlayPauseIcon();
-    saveSession(true);
-}
-
-// ========================= Seek/Volume =========================
-void MainWindow::seekPressed() { userSeeking = true; }
-
-void MainWindow::seekReleased() {
-    float dur = music.getDuration().asSeconds();
-    if (dur <= 0.f) { userSeeking = false; return; }
-
-    float target = (seekSlider->value() / 1000.f) * dur;
-    music.setPlayingOffset(sf::seconds(target));
-
-    userSeeking = false;
-    updateTimeUI();
-    saveSession(true);
-}
-
-void MainWindow::volumeChanged(int v) { music.setVolume((float)v); }
-
-// ========================= Timer tick =========================
-void MainWindow::tick() {
-    auto st = music.getStatus();
-    if (st == sf::Sound::Status::Playing) wasPlaying = true;
-
-    // Auto-next when song ends naturally
-    if (!playlistFullPaths.isEmpty() && currentIndex >= 0) {
-        if (st == sf::Sound::Status::Stopped && !stoppedByUser && wasPlaying) {
-            wasPlaying = false;
-
-            if (currentIndex + 1 < playlistFullPaths.size()) {
-                if (loadIndex(currentIndex + 1)) {
-                    music.play();
-                    refreshPlayPauseIcon();
-                } else {
-                    stoppedByUser = true;
-                    refreshPlayPauseIcon();
-                }
-            } else {
-                refreshPlayPauseIcon();
-            }
-        }
-    }
-
-    updateTimeUI();
-
-    // ✅ Save session occasionally while playing (every ~1s here: 200ms * 5)
-    tickCounter++;
-    if (tickCounter >= 5) {
-        tickCounter = 0;
-        saveSession(false);
-    }
-}
-
-// ========================= Counts & time =========================
-void MainWindow::updateCountLabel() {
-    int total = model->rowCount();
-    int shown = proxy->rowCount();
-    countLabel->setText(QString("Showing %1 of %2").arg(shown).arg(total));
-}
-
-QString MainWindow::formatTime(float seconds) {
-    if (seconds < 0) seconds = 0;
-    int total = (int)(seconds + 0.5f);
-    int mins = total / 60;
-    int secs = total % 60;
-    return QString("%1:%2").arg(mins).arg(secs, 2, 10, QChar('0'));
-}
-
-void MainWindow::updateNowPlaying() {
-    if (currentIndex < 0 || currentIndex >= playlistFullPaths.size()) return;
-
-    QFileInfo info(playlistFullPaths[currentIndex]);
-    QString baseName = info.completeBaseName();
-
-    QString artist, title;
-    parseArtistTitleFromFilename(baseName, artist, title);
-
-    bigTitleLabel->setText(title.isEmpty() ? "Unknown Title" : title);
-    bigArtistLabel->setText(artist.isEmpty() ? "Unknown Artist" : artist);
-
-    setArtworkPixmap(loadArtworkForTrack(playlistFullPaths[currentIndex]));
-}
-
-void MainWindow::updateTimeUI() {
-    float dur = music.getDuration().asSeconds();
-    float pos = music.getPlayingOffset().asSeconds();
-
-    if (dur < 0) dur = 0;
-    if (pos < 0) pos = 0;
-    if (pos > dur) pos = dur;
-
-    timeLabel->setText(formatTime(pos) + " / " + formatTime(dur));
-
-    if (!userSeeking && dur > 0.f) {
-        int v = (int)((pos / dur) * 1000.f);
-        v = std::max(0, std::min(1000, v));
-        seekSlider->setValue(v);
-    }
-}
-
-// ========================= Artwork =========================
-QPixmap MainWindow::loadArtworkForTrack(const QString& audioPath) const {
-    QFileInfo fi(audioPath);
-    QDir dir(fi.absolutePath());
-
-    QStringList coverNames = {"cover.jpg", "cover.jpeg", "cover.png", "folder.jpg", "folder.png"};
-    for (const auto& name : coverNames) {
-        QString p = dir.filePath(name);
-        if (QFileInfo::exists(p)) {
-            QPixmap px(p);
-            if (!px.isNull()) return px;
-        }
-    }
-
-    QString base = fi.completeBaseName();
-    QStringList exts = {"jpg", "jpeg", "png"};
-    for (const auto& ext : exts) {
-        QString p = dir.filePath(base + "." + ext);
-        if (QFileInfo::exists(p)) {
-            QPixmap px(p);
-            if (!px.isNull()) return px;
-        }
-    }
-
-    return QPixmap();
-}
-
-void MainWindow::setArtworkPixmap(const QPixmap& px) {
-    if (px.isNull()) {
-        QPixmap placeholder(56, 56);
-        placeholder.fill(QColor("#2b3754"));
-        artLabel->setPixmap(placeholder);
-        return;
-    }
-
-    QPixmap scaled = px.scaled(56, 56, Qt::KeepAspectRatioByExpanding, Qt::SmoothTransformation);
-    artLabel->setPixmap(scaled);
-}
-
-// ========================= Filename parsing =========================
-void MainWindow::parseArtistTitleFromFilename(const QString& fileNameNoExt, QString& artist, QString& title) {
-    QString s = fileNameNoExt.trimmed();
-    const QStringList seps = {" - ", " – ", " — "};
-
-    for (const auto& sep : seps) {
-        int p = s.indexOf(sep);
-        if (p > 0) {
-            artist = s.left(p).trimmed();
-            title  = s.mid(p + sep.length()).trimmed();
-            if (!title.isEmpty()) return;
-        }
-    }
-
-    artist.clear();
-    title = s;
-}
-
-// ========================= Session persistence =========================
-void MainWindow::restoreLastSession() {
-    QSettings s("NileUniversity", "QtMusicPlayer");
-
-    const QString folder = s.value("player/lastFolder", "").toString();
-    const int index      = s.value("player/lastIndex", -1).toInt();
-    const double offset  = s.value("player/lastOffsetSeconds", 0.0).toDouble();
-    const bool playNow   = s.value("player/wasPlaying", false).toBool();
-
-    if (folder.isEmpty()) return;
-    if (!QFileInfo::exists(folder)) return;
-
-    loadFolder(folder);
-
-    if (index >= 0 && index < playlistFullPaths.size()) {
-        if (loadIndex(index)) {
-            music.setPlayingOffset(sf::seconds(static_cast<float>(offset)));
-
-            // If it was playing when user closed, resume. Otherwise keep paused.
-            if (playNow) {
-                stoppedByUser = false;
-                music.play();
-            } else {
-                music.pause();
-            }
-
-            refreshPlayPauseIcon();
-            updateTimeUI();
-        }
-    }
-}
-
-void MainWindow::saveSession(bool force) {
-    // Need a folder to restore from
-    if (lastLoadedFolder.isEmpty()) return;
-
-    bool playing = (music.getStatus() == sf::Sound::Status::Playing);
-
-    // If not forced, save only while playing (reduces registry writes)
-    if (!force && !playing) return;
-
-    QSettings s("NileUniversity", "QtMusicPlayer");
-    s.setValue("player/lastFolder", lastLoadedFolder);
-    s.setValue("player/lastIndex", currentIndex);
-    s.setValue("player/lastOffsetSeconds", static_cast<double>(music.getPlayingOffset().asSeconds()));
-    s.setValue("player/wasPlaying", playing);
-}
-
-void MainWindow::closeEvent(QCloseEvent* e) {
-    saveSession(true);
-    QMainWindow::closeEvent(e);
-}
+/*
+ * Author: Itoro Ifon, jason Hippolite, Prince Umeh
+ * Date: 2026-01-22
+ * Course/Assignment: C++ Project - Qt Music Player
+ * File: MainWindow.h
+ * Purpose: Declares the MainWindow class, which provides the user interface
+ *          and connects UI actions to music playback logic.
+ */
+#include "mainwindow.h"
+#include "tracepanel.h"
+
+#include <QVBoxLayout>
+#include <QHBoxLayout>
+#include <QFileDialog>
+#include <QMessageBox>
+#include <QFileInfo>
+#include <QHeaderView>
+#include <QWidget>
+#include <QStyle>
+#include <QMenu>
+#include <QDesktopServices>
+#include <QUrl>
+#include <QDragEnterEvent>
+#include <QDropEvent>
+#include <QMimeData>
+#include <QFile>
+#include <QDir>
+#include <QElapsedTimer>
+
+#include <QSettings>     //  one-time migration into the session journal
+#include <QCloseEvent>   //  closeEvent override
+#include <QShowEvent>
+#include <QHideEvent>
+#include <QShortcut>
+
+#include <algorithm>
+#include <functional>
+
+// Class: MusicPlayerWindow
+// Purpose: Main UI window for the music player. Handles user interactions,
+//          playlist display, searching, and controlling audio playback.
+// Function: addSongs()
+// Purpose: Opens a file dialog to let the user select audio files, validates
+//          supported formats, then adds valid tracks to the playlist/list.
+// Parameters: None
+// Returns: void
+// Notes: Currently supports WAV only.
+
+
+static void showError(QWidget* parent, const QString& title, const QString& msg) {
+    QMessageBox::warning(parent, title, msg);
+}
+
+// A resume position this close to the end starts the track over instead.
+static constexpr qint64 kResumeTailMs = 10000;
+// How often the playing position is journaled.
+static constexpr int kSessionSaveMs = 1000;
+
+MainWindow::MainWindow(QWidget *parent) : QMainWindow(parent) {
+    setAcceptDrops(true);
+
+    scanner = new LibraryScanner(this);
+    connect(scanner, &LibraryScanner::batchReady, this, &MainWindow::onScanBatch);
+    connect(scanner, &LibraryScanner::progress, this, &MainWindow::onScanProgress);
+    connect(scanner, &LibraryScanner::scanFinished, this, &MainWindow::onScanFinished);
+    // The engine's open pool asks for seek indexes; `music` is destroyed
+    // (and its pool drained) before the scanner, which is a child.
+    music.setSeekIndexSource([library = scanner](const QString& path) { return library->seekIndexFor(path); });
+
+    watcher = new LibraryWatcher(scanner, this);
+    connect(watcher, &LibraryWatcher::filesAdded, this, &MainWindow::onFilesAdded);
+    connect(watcher, &LibraryWatcher::filesRemoved, this, &MainWindow::onFilesRemoved);
+    connect(watcher, &LibraryWatcher::fileRenamed, this, &MainWindow::onFileRenamed);
+
+    loudness = new LoudnessScanner(this);
+    connect(loudness, &LoudnessScanner::resultsReady, this, &MainWindow::onLoudnessResults);
+    connect(loudness, &LoudnessScanner::progress, this, &MainWindow::onLoudnessProgress);
+    connect(loudness, &LoudnessScanner::finished, this, &MainWindow::onLoudnessFinished);
+
+    duplicates = new DuplicateScanner(this);
+    connect(duplicates, &DuplicateScanner::resultsReady, this, &MainWindow::onHashResults);
+    connect(duplicates, &DuplicateScanner::finished, this, &MainWindow::onHashFinished);
+
+    waveforms = new WaveformProvider(this);
+    connect(waveforms, &WaveformProvider::ready, this, &MainWindow::onWaveformReady);
+
+    buildUI();
+    applyThemeLite();
+
+    connect(&music, &PlaybackEngine::advancedToNext, this, &MainWindow::onAdvancedToNext);
+    connect(&music, &PlaybackEngine::openFinished, this, &MainWindow::onTrackOpened);
+    music.setVolume(70.f);
+    volumeSlider->setValue(70);
+
+    // Time label/slider refresh; only runs while playing and visible.
+    uiTimer = new QTimer(this);
+    connect(uiTimer, &QTimer::timeout, this, &MainWindow::tick);
+    // Session position journal; runs while playing, visible or not.
+    sessionTimer = new QTimer(this);
+    sessionTimer->setInterval(kSessionSaveMs);
+    connect(sessionTimer, &QTimer::timeout, this, [this] { saveSession(false); });
+    connect(&music, &PlaybackEngine::statusChanged, this, &MainWindow::onPlaybackStatusChanged);
+    connect(&music, &PlaybackEngine::trackFinished, this, &MainWindow::onTrackFinished);
+
+    // Diagnostics: the stall detector only beats while tracing is on.
+    stallDetector = new StallDetector(this);
+    stallDetector->setActive(Tracer::enabled());
+    auto* traceShortcut = new QShortcut(QKeySequence("Ctrl+Shift+D"), this);
+    connect(traceShortcut, &QShortcut::activated, this, &MainWindow::showTracePanel);
+
+    refreshPlayPauseIcon();
+    updateCountLabel();
+
+    // ✅ Restore last session (folder + track + position)
+    restoreLastSession();
+}
+
+// ========================= UI =========================
+void MainWindow::buildUI() {
+    auto* central = new QWidget(this);
+    setCentralWidget(central);
+
+    openBtn = new QPushButton("Open Folder");
+    openBtn->setIcon(style()->standardIcon(QStyle::SP_DirOpenIcon));
+    connect(openBtn, &QPushButton::clicked, this, &MainWindow::openFolder);
+
+    addFolderBtn = new QPushButton("Add Folder");
+    addFolderBtn->setIcon(style()->standardIcon(QStyle::SP_FileDialogNewFolder));
+    addFolderBtn->setToolTip("Add another folder to the library (scanned recursively and watched for changes)");
+    connect(addFolderBtn, &QPushButton::clicked, this, &MainWindow::addFolder);
+
+    searchBox = new QLineEdit();
+    searchBox->setPlaceholderText("Search by song name, artist, or lyrics…");
+    searchBox->setClearButtonEnabled(true);
+
+    countLabel = new QLabel("0 songs");
+    countLabel->setAlignment(Qt::AlignRight | Qt::AlignVCenter);
+
+    scanProgress = new QProgressBar();
+    scanProgress->setMaximumWidth(160);
+    scanProgress->setTextVisible(false);
+    scanProgress->hide();
+
+    cancelScanBtn = new QPushButton("Cancel");
+    cancelScanBtn->hide();
+    connect(cancelScanBtn, &QPushButton::clicked, scanner, &LibraryScanner::cancel);
+
+    duplicatesBtn = new QPushButton();
+    duplicatesBtn->hide(); // until hashing finds a group
+    connect(duplicatesBtn, &QPushButton::clicked, this, &MainWindow::showDuplicates);
+
+    auto* topRow = new QHBoxLayout();
+    topRow->addWidget(openBtn);
+    topRow->addWidget(addFolderBtn);
+    topRow->addSpacing(10);
+    topRow->addWidget(new QLabel("Search:"));
+    topRow->addWidget(searchBox, 1);
+    topRow->addWidget(scanProgress);
+    topRow->addWidget(cancelScanBtn);
+    topRow->addWidget(duplicatesBtn);
+    topRow->addWidget(countLabel);
+
+    model = new LibraryModel(this);
+    queue = std::make_unique<PlayQueue>(model->store());
+
+    proxy = new TrackFilterModel(this);
+    proxy->setSourceModel(model);
+
+    table = new QTableView();
+    table->setModel(proxy);
+    table->setSelectionBehavior(QAbstractItemView::SelectRows);
+    table->setSelectionMode(QAbstractItemView::SingleSelection);
+    table->setEditTriggers(QAbstractItemView::NoEditTriggers);
+    table->setShowGrid(false);
+    table->setAlternatingRowColors(true);
+    table->verticalHeader()->setVisible(false);
+    table->horizontalHeader()->setStretchLastSection(true);
+    table->horizontalHeader()->setHighlightSections(false);
+    table->verticalHeader()->setDefaultSectionSize(30);
+    // Fixed sizes: nothing measures rows, so inserts and scrolling cost the
+    // same at a million tracks as at a hundred. The model hands rows over in
+    // fetch batches as the view scrolls (LibraryModel::fetchMore()).
+    table->verticalHeader()->setSectionResizeMode(QHeaderView::Fixed);
+
+    // Header clicks reorder the playlist itself (LibraryModel::sort()), not
+    // the proxy, which would compare strings on every step.
+    table->horizontalHeader()->setSectionsClickable(true);
+    table->horizontalHeader()->setSortIndicatorShown(true);
+    table->horizontalHeader()->setSortIndicator(-1, Qt::AscendingOrder);
+    connect(table->horizontalHeader(), &QHeaderView::sortIndicatorChanged, this, &MainWindow::onSortRequested);
+
+    table->setColumnHidden(LibraryModel::ColLyrics, true);
+    table->setColumnHidden(LibraryModel::ColPath, true);
+    table->horizontalHeader()->setSectionResizeMode(LibraryModel::ColDuration, QHeaderView::Fixed);
+    table->horizontalHeader()->resizeSection(LibraryModel::ColDuration,
+                                             table->fontMetrics().horizontalAdvance("00:00:00") + 16);
+
+    connect(table, &QTableView::doubleClicked, this, &MainWindow::onDoubleClick);
+
+    table->setContextMenuPolicy(Qt::CustomContextMenu);
+    connect(table, &QTableView::customContextMenuRequested, this, &MainWindow::onContextMenu);
+
+    connect(searchBox, &QLineEdit::textChanged, proxy, &TrackFilterModel::setQuery);
+    connect(proxy, &TrackFilterModel::queryApplied, this, &MainWindow::onQueryApplied);
+
+    // ===== Mini Player Bar =====
+    playerBar = new QFrame();
+    playerBar->setObjectName("playerBar");
+
+    artLabel = new QLabel();
+    artLabel->setFixedSize(56, 56);
+
+    bigTitleLabel = new QLabel("No song selected");
+    bigTitleLabel->setObjectName("bigTitle");
+
+    bigArtistLabel = new QLabel("—");
+    bigArtistLabel->setObjectName("bigArtist");
+
+    auto* metaCol = new QVBoxLayout();
+    metaCol->setSpacing(2);
+    metaCol->addWidget(bigTitleLabel);
+    metaCol->addWidget(bigArtistLabel);
+
+    prevBtn = new QPushButton();
+    prevBtn->setIcon(style()->standardIcon(QStyle::SP_MediaSkipBackward));
+    connect(prevBtn, &QPushButton::clicked, this, &MainWindow::prev);
+
+    playPauseBtn = new QPushButton();
+    connect(playPauseBtn, &QPushButton::clicked, this, &MainWindow::togglePlayPause);
+
+    stopBtn = new QPushButton();
+    stopBtn->setIcon(style()->standardIcon(QStyle::SP_MediaStop));
+    connect(stopBtn, &QPushButton::clicked, this, &MainWindow::stop);
+
+    nextBtn = new QPushButton();
+    nextBtn->setIcon(style()->standardIcon(QStyle::SP_MediaSkipForward));
+    connect(nextBtn, &QPushButton::clicked, this, &MainWindow::next);
+
+    repeatBtn = new QPushButton();
+    connect(repeatBtn, &QPushButton::clicked, this, &MainWindow::cycleRepeat);
+    refreshRepeatButton();
+
+    // Index 0 is off; the rest follow ShuffleOrder::Mode.
+    shuffleBox = new QComboBox();
+    shuffleBox->addItems({"Shuffle off", "Shuffle", "Least played", "Spread artists"});
+    shuffleBox->setToolTip("Shuffle: plain, favoring rarely played tracks, or keeping artists apart");
+    connect(shuffleBox, &QComboBox::currentIndexChanged, this, &MainWindow::onShuffleChanged);
+
+    auto* controlsRow = new QHBoxLayout();
+    controlsRow->setSpacing(8);
+    controlsRow->addWidget(prevBtn);
+    controlsRow->addWidget(playPauseBtn);
+    controlsRow->addWidget(stopBtn);
+    controlsRow->addWidget(nextBtn);
+    controlsRow->addWidget(repeatBtn);
+    controlsRow->addWidget(shuffleBox);
+
+    seekSlider = new WaveformSeekBar();
+    connect(seekSlider, &QSlider::sliderPressed, this, &MainWindow::seekPressed);
+    connect(seekSlider, &QSlider::sliderReleased, this, &MainWindow::seekReleased);
+    connect(seekSlider, &WaveformSeekBar::viewChanged, this, &MainWindow::updateUiTimer);
+
+    timeLabel = new QLabel("0:00 / 0:00");
+    timeLabel->setMinimumWidth(90);
+    timeLabel->setAlignment(Qt::AlignRight | Qt::AlignVCenter);
+
+    auto* seekRow = new QHBoxLayout();
+    seekRow->addWidget(seekSlider, 1);
+    seekRow->addWidget(timeLabel);
+
+    volumeSlider = new QSlider(Qt::Horizontal);
+    volumeSlider->setRange(0, 100);
+    connect(volumeSlider, &QSlider::valueChanged, this, &MainWindow::volumeChanged);
+
+    normalizeBox = new QComboBox();
+    normalizeBox->addItems({"Off", "Track", "Album"});
+    normalizeBox->setCurrentIndex(NormalizeTrack);
+    normalizeBox->setToolTip("Loudness normalization (EBU R128, -18 LUFS)");
+    connect(normalizeBox, &QComboBox::currentIndexChanged, this, &MainWindow::onNormalizationChanged);
+
+    eqBtn = new QPushButton("EQ");
+    eqBtn->setToolTip("Preamp, equalizer and limiter");
+    connect(eqBtn, &QPushButton::clicked, this, &MainWindow::showEqualizer);
+
+    auto* volRow = new QHBoxLayout();
+    volRow->addWidget(new QLabel("Volume"));
+    volRow->addWidget(volumeSlider, 1);
+    volRow->addWidget(new QLabel("Normalize"));
+    volRow->addWidget(normalizeBox);
+    volRow->addWidget(eqBtn);
+
+    auto* rightCol = new QVBoxLayout();
+    rightCol->setSpacing(8);
+    rightCol->addLayout(controlsRow);
+    rightCol->addLayout(seekRow);
+    rightCol->addLayout(volRow);
+
+    auto* barLayout = new QHBoxLayout(playerBar);
+    barLayout->setContentsMargins(14, 12, 14, 12);
+    barLayout->setSpacing(12);
+    barLayout->addWidget(artLabel);
+    barLayout->addLayout(metaCol, 1);
+    barLayout->addLayout(rightCol, 2);
+
+    auto* layout = new QVBoxLayout(central);
+    layout->setSpacing(12);
+    layout->setContentsMargins(14, 14, 14, 14);
+    layout->addLayout(topRow);
+    layout->addWidget(table, 1);
+    layout->addWidget(playerBar);
+
+    resize(980, 620);
+    setArtworkPixmap(QPixmap());
+}
+
+void MainWindow::applyThemeLite() {
+    setStyleSheet(R"(
+QMainWindow { background: #1a2130; color: #eef2ff; }
+QLabel { color: #eef2ff; }
+QLineEdit {
+    background: #232c3e;
+    border: 1px solid #3b4a66;
+    padding: 8px 10px;
+    border-radius: 10px;
+    color: #eef2ff;
+}
+QPushButton {
+    background: #273149;
+    border: 1px solid #3b4a66;
+    padding: 8px 12px;
+    border-radius: 10px;
+    color: #eef2ff;
+}
+QPushButton:hover { background: #2d3954; }
+QPushButton:pressed { background: #20283b; }
+QTableView {
+    background: #1f2740;
+    border: 1px solid #3b4a66;
+    border-radius: 14px;
+    selection-background-color: #3b82f6;
+    selection-color: white;
+}
+QHeaderView::section {
+    background: #232c3e;
+    color: #dbe3ff;
+    padding: 10px;
+    border: none;
+}
+QTableView::item { padding: 8px; }
+QFrame#playerBar {
+    background: #232c3e;
+    border: 1px solid #3b4a66;
+    border-radius: 18px;
+}
+QLabel#bigTitle { font-size: 16px; font-weight: 600; color: #f3f6ff; }
+QLabel#bigArtist { font-size: 12px; color: #b8c3e6; }
+QSlider::groove:horizontal { background: #3b4a66; height: 6px; border-radius: 3px; }
+QSlider::handle:horizontal { background: #3b82f6; width: 14px; margin: -6px 0; border-radius: 7px; }
+)");
+}
+
+void MainWindow::refreshPlayPauseIcon() {
+    if (music.getStatus() == sf::Sound::Status::Playing)
+        playPauseBtn->setIcon(style()->standardIcon(QStyle::SP_MediaPause));
+    else
+        playPauseBtn->setIcon(style()->standardIcon(QStyle::SP_MediaPlay));
+}
+
+// ========================= Drag & Drop =========================
+void MainWindow::dragEnterEvent(QDragEnterEvent* e) {
+    if (e->mimeData()->hasUrls()) e->acceptProposedAction();
+}
+
+void MainWindow::dropEvent(QDropEvent* e) {
+    if (!e->mimeData()->hasUrls()) return;
+
+    QStringList files;
+    QString folder;
+    QStringList unsupported;
+
+    for (const auto& url : e->mimeData()->urls()) {
+        const QString path = url.toLocalFile();
+        if (path.isEmpty()) continue;
+
+        QFileInfo fi(path);
+        if (fi.isDir()) folder = path;
+        else if (fi.isFile()) {
+            if (LibraryScanner::isSupportedAudio(path)) files << path;
+            else unsupported << fi.fileName();
+        }
+    }
+
+    if (!unsupported.isEmpty()) {
+        showError(this, "Unsupported files dropped",
+                  "These files are not supported and were ignored:\n- " + unsupported.join("\n- ")
+                      + "\n\nSupported: .wav .ogg .flac .aiff .au");
+    }
+
+    if (!folder.isEmpty()) { loadFolder(folder); return; }
+    if (!files.isEmpty())  { addFiles(files); return; }
+}
+
+// ========================= Folder load =========================
+void MainWindow::openFolder() {
+    QString dir = QFileDialog::getExistingDirectory(this, "Select Music Folder");
+    if (!dir.isEmpty()) loadFolder(dir);
+}
+
+void MainWindow::addFolder() {
+    QString dir = QFileDialog::getExistingDirectory(this, "Add Music Folder");
+    if (!dir.isEmpty()) addLibraryRoot(dir);
+}
+
+// Replaces the whole library with one root folder.
+void MainWindow::loadFolder(const QString& folderPath) {
+    TRACE_SCOPE("MainWindow::loadFolder");
+    libraryRoots = {QDir(folderPath).absolutePath()}; // ✅ remember folder
+    // First, so the reports of the dropped scans land before the state
+    // they would touch is reset below.
+    scanner->cancel();
+    watcher->clear();
+    loudness->cancel();
+    duplicates->cancel();
+    duplicatesBtn->hide();
+    albumLoudness.clear();
+    albumMembers.clear();
+    albumsIndexed = false;
+    artwork.forgetDirectory(folderPath); // reloading picks up new or replaced covers
+
+    music.stop();
+    currentIndex = -1;
+    queue->clear();
+    preloadNextTrack();
+
+    model->clear();
+    searchBox->clear();
+
+    bigTitleLabel->setText("No song selected");
+    bigArtistLabel->setText("—");
+    timeLabel->setText("0:00 / 0:00");
+    seekSlider->setValue(0);
+    seekSlider->setPeaks(nullptr);
+    setArtworkPixmap(QPixmap());
+    refreshPlayPauseIcon();
+    updateCountLabel();
+
+    // Walking, parsing and lyrics loading happen on the scanner's pool;
+    // rows arrive through onScanBatch() as each batch completes.
+    scanner->scanFolder(folderPath);
+}
+
+// Adds a root next to the existing ones; rows already present are kept.
+void MainWindow::addLibraryRoot(const QString& folderPath) {
+    const QString root = QDir(folderPath).absolutePath();
+
+    // Already covered by a root: rescan that root instead.
+    for (const QString& r : libraryRoots) {
+        if (root == r || root.startsWith(r + '/')) {
+            scanner->scanFolder(r);
+            return;
+        }
+    }
+
+    // Roots inside the new one become part of it.
+    for (int i = libraryRoots.size() - 1; i >= 0; --i) {
+        if (libraryRoots[i].startsWith(root + '/')) {
+            watcher->unwatchRoot(libraryRoots[i]);
+            libraryRoots.removeAt(i);
+        }
+    }
+
+    libraryRoots << root;
+    artwork.forgetDirectory(root);
+    saveSession(true);
+    scanner->scanFolder(root);
+}
+
+// ========================= Add files =========================
+void MainWindow::addFiles(const QStringList& filePaths) {
+    TRACE_SCOPE("MainWindow::addFiles");
+    scanner->scanFiles(filePaths);
+}
+
+void MainWindow::addScannedTracks(const QVector<ScannedTrack>& batch) {
+    TRACE_SCOPE("MainWindow::addScannedTracks"); // includes the proxy filtering the new rows
+    const int before = tracks().size();
+    model->appendTracks(batch); // skips paths already in the playlist; new rows go last
+    for (int r = before; r < tracks().size(); ++r) indexAlbum(r);
+    updateCountLabel();
+}
+
+// ========================= Scan results =========================
+void MainWindow::onScanBatch(const QVector<ScannedTrack>& batch) {
+    const bool wasEmpty = tracks().isEmpty();
+    watcher->learn(batch); // size/mtime, for rename detection
+    addScannedTracks(batch);
+
+    // Show the first track as soon as the first batch lands, like the old
+    // synchronous load did once everything was in.
+    if (wasEmpty && !pendingRestore.active) showFirstTrack();
+}
+
+void MainWindow::showFirstTrack() {
+    if (tracks().isEmpty() || currentIndex >= 0) return;
+    currentIndex = 0;
+    QModelIndex srcIdx = model->index(0, 0);
+    QModelIndex pxIdx = proxy->mapFromSource(srcIdx);
+    if (pxIdx.isValid()) table->selectRow(pxIdx.row());
+    updateNowPlaying();
+    updateTimeUI();
+}
+
+void MainWindow::onScanProgress(int done, int total) {
+    TRACE_COUNTER("scan.done", done);
+    TRACE_COUNTER("scan.total", total);
+    const bool busy = total > 0 && done < total;
+    scanProgress->setVisible(busy);
+    cancelScanBtn->setVisible(busy);
+    if (busy) {
+        scanProgress->setRange(0, total);
+        scanProgress->setValue(done);
+    }
+}
+
+void MainWindow::onScanFinished(const ScanReport& report) {
+    // Memory accounting walks every row, so refresh it once per scan only.
+    const LyricsStore& lyrics = tracks().lyricsPool();
+    countLabel->setToolTip(QString("Library memory: ~%1 bytes per track (%2 KiB total)\n"
+                                   "Lyrics: %3 KiB resident, %4 KiB mapped (%5 KiB as plain text)")
+                               .arg(model->bytesPerTrack())
+                               .arg(model->memoryUsage() / 1024)
+                               .arg(lyrics.residentBytes() / 1024)
+                               .arg(lyrics.mappedBytes() / 1024)
+                               .arg(lyrics.textBytes() / 1024));
+    TRACE_COUNTER("library.lyricsSavedKiB", (lyrics.textBytes() - lyrics.residentBytes()) / 1024);
+    TRACE_COUNTER("library.bytesPerTrack", model->bytesPerTrack());
+
+    // A cancelled scan never delivers the rest of the library, so a restore
+    // waiting for it would fire on some later, unrelated scan.
+    if (report.cancelled && pendingRestore.active) {
+        pendingRestore = PendingRestore();
+        showFirstTrack();
+    }
+
+    if (pendingRestore.active && !scanner->isScanning()) {
+        const PendingRestore r = pendingRestore;
+        pendingRestore = PendingRestore();
+
+        int row = r.path.isEmpty() ? -1 : tracks().rowOf(tracks().idOfPath(r.path));
+        if (row < 0 && r.path.isEmpty()) row = r.index;
+
+        // If it was playing when user closed, resume. Otherwise keep paused.
+        if (row >= 0 && row < tracks().size() && loadIndex(row, r.playNow, r.offset))
+            queue->played(kNoTrack, tracks().idAt(row));
+    }
+
+    // Measure and hash whatever the cache had nothing for, once scanning settles.
+    if (!scanner->isScanning()) {
+        analyzeLoudness();
+        hashContent();
+    }
+
+    if (report.background) return; // watcher diffs stay quiet
+
+    // Watch the root from now on; the scan already listed its directories,
+    // unless it was cancelled before the walk was done.
+    if (!report.folder.isEmpty() && libraryRoots.contains(QDir(report.folder).absolutePath()))
+        watcher->watchRoot(report.folder, report.directories.isEmpty() ? QStringList{report.folder} : report.directories);
+
+    if (report.cancelled) return; // the counts are partial; nothing to complain about
+
+    if (!report.folder.isEmpty() && report.total == 0) {
+        showError(this, "No supported audio files",
+                  "No supported audio files found in:\n" + report.folder +
+                      "\n\nSupported: .wav .ogg .flac .aiff .au");
+        return;
+    }
+
+    if (!report.missingNames.isEmpty()) {
+        showError(this, "Some files couldn't be added",
+                  "These files were missing or inaccessible:\n- " + report.missingNames.join("\n- "));
+    }
+
+    if (!report.unsupportedNames.isEmpty()) {
+        if (report.folder.isEmpty()) {
+            showError(this, "Unsupported files dropped",
+                      "These files are not supported and were ignored:\n- " + report.unsupportedNames.join("\n- ")
+                          + "\n\nSupported: .wav .ogg .flac .aiff .au");
+        } else {
+            QMessageBox::information(this, "Some files ignored",
+                                     "Ignored unsupported files in this folder (examples):\n- "
+                                         + report.unsupportedNames.mid(0, 12).join("\n- ")
+                                         + (report.unsupportedNames.size() > 12 ? "\n..." : "")
+                                         + "\n\nSupported: .wav .ogg .flac .aiff .au");
+        }
+    }
+}
+
+// ========================= Load a track =========================
+// Starts opening the track in the background; onTrackOpened() finishes the
+// job. Returns false only when the request could not be made.
+bool MainWindow::loadIndex(int sourceRow, bool autoPlay, double startOffset) {
+    TRACE_SCOPE("MainWindow::loadIndex");
+    if (sourceRow < 0 || sourceRow >= tracks().size()) return false;
+
+    const QString path = tracks().pathAt(sourceRow);
+
+    if (!QFileInfo::exists(path)) {
+        showError(this, "File missing",
+                  "This file no longer exists:\n" + path +
+                      "\n\nRemove it from playlist or reload folder.");
+        return false;
+    }
+
+    // Leaving a track part-way keeps its place; opening one picks it up
+    // again unless the caller asked for a position or it was nearly over.
+    if (sourceRow != currentIndex) {
+        if (currentIndex >= 0 && currentIndex < tracks().size())
+            session.setResumePosition(tracks().pathAt(currentIndex), music.getPlayingOffset().asSeconds());
+        const double resume = session.resumePosition(path);
+        const qint64 durationMs = tracks().durationMsAt(sourceRow);
+        if (startOffset <= 0.0 && (durationMs == 0 || resume * 1000.0 < durationMs - kResumeTailMs))
+            startOffset = resume;
+    }
+
+    currentIndex = sourceRow;
+    pendingOpen.play = autoPlay;
+    pendingOpen.offset = startOffset;
+
+    // Unanalyzed tracks jump the analysis queue; the gain is applied when
+    // the result lands, even mid-track.
+    if (!tracks().loudnessAt(sourceRow).analyzed) loudness->prioritize(path);
+    music.setTrackGain(normalizationGainDb(sourceRow));
+
+    // Stops the old track now; a later request cancels this one.
+    music.openAsync(path);
+
+    model->exposeUpTo(sourceRow);
+    QModelIndex srcIdx = model->index(sourceRow, 0);
+    QModelIndex pxIdx = proxy->mapFromSource(srcIdx);
+    if (pxIdx.isValid()) table->selectRow(pxIdx.row());
+
+    updateNowPlaying();
+    updateTimeUI(); // shows the loading state
+    refreshPlayPauseIcon();
+    return true;
+}
+
+void MainWindow::onTrackOpened(const QString& path, bool ok) {
+    if (!ok) {
+        refreshPlayPauseIcon();
+        updateTimeUI();
+        showError(this, "Playback failed",
+                  "SFML could not open this file:\n" + path +
+                      "\n\nPossible reasons:\n"
+                      "- File is corrupted\n"
+                      "- Unsupported codec inside the container\n"
+                      "- Permission issues\n"
+                      "\nTry converting it to WAV/OGG/FLAC again.");
+        return;
+    }
+
+    if (pendingOpen.offset > 0.0)
+        music.setPlayingOffset(sf::seconds(static_cast<float>(pendingOpen.offset)));
+
+    if (pendingOpen.play) {
+        music.play();
+    } else {
+        music.pause(); // keeps the restored position
+    }
+
+    refreshPlayPauseIcon();
+    updateTimeUI();
+    preloadNextTrack();
+    updateCountLabel(); // the track may have come off the queue
+    saveSession(true);
+}
+
+// Opens the track the queue plays next ahead of time so the engine can
+// splice it in without a gap. Called whenever the current track changes.
+void MainWindow::preloadNextTrack() {
+    preloadedId = kNoTrack;
+
+    const TrackId next = currentIndex >= 0 ? queue->peek(currentId(), PlayQueue::Step::Auto) : kNoTrack;
+    const int nextRow = tracks().rowOf(next);
+    if (nextRow < 0) {
+        music.clearNext();
+        return;
+    }
+
+    music.setNextTrackGain(normalizationGainDb(nextRow));
+    music.preloadNextAsync(tracks().pathAt(nextRow));
+    waveforms->prefetch(tracks().pathAt(nextRow));
+    preloadedId = next;
+}
+
+void MainWindow::countPlay(int sourceRow) {
+    if (sourceRow < 0 || sourceRow >= tracks().size()) return;
+    const quint32 count = tracks().playCountAt(sourceRow) + 1;
+    model->setPlayCount(sourceRow, count);
+    scanner->storePlayCount(tracks().pathAt(sourceRow), count); // saved with the cache
+}
+
+// After the order changed (queue, repeat, sort, removals): only reopen the
+// next track if it is a different one.
+void MainWindow::refreshPreload() {
+    const TrackId next = currentIndex >= 0 ? queue->peek(currentId(), PlayQueue::Step::Auto) : kNoTrack;
+    if (next != preloadedId) preloadNextTrack();
+}
+
+void MainWindow::onSortRequested(int column, Qt::SortOrder order) {
+    TRACE_SCOPE("MainWindow::onSortRequested");
+    const TrackId current = currentIndex >= 0 ? tracks().idAt(currentIndex) : kNoTrack;
+    model->sort(column, order);
+    if (current == kNoTrack) return;
+
+    currentIndex = tracks().rowOf(current);
+    model->exposeUpTo(currentIndex);
+    const QModelIndex pxIdx = proxy->mapFromSource(model->index(currentIndex, 0));
+    if (pxIdx.isValid()) {
+        table->selectRow(pxIdx.row());
+        table->scrollTo(pxIdx);
+    }
+
+    refreshPreload(); // the library order may have changed which track is next
+    saveSession(false);
+}
+
+void MainWindow::onQueryApplied() {
+    // Clearing the search hands unfetched rows back to the library; keep the
+    // current track's row and selection.
+    if (proxy->query().isEmpty() && currentIndex >= 0) {
+        model->exposeUpTo(currentIndex);
+        const QModelIndex pxIdx = proxy->mapFromSource(model->index(currentIndex, 0));
+        if (pxIdx.isValid()) {
+            table->selectRow(pxIdx.row());
+            table->scrollTo(pxIdx);
+        }
+    }
+    updateCountLabel();
+}
+
+void MainWindow::onAdvancedToNext() {
+    countPlay(currentIndex);
+    if (currentIndex >= 0) session.setResumePosition(tracks().pathAt(currentIndex), 0.0); // played to the end
+    queue->played(currentId(), preloadedId);
+    const int row = tracks().rowOf(preloadedId);
+    if (row >= 0) currentIndex = row;
+
+    model->exposeUpTo(currentIndex);
+    QModelIndex pxIdx = proxy->mapFromSource(model->index(currentIndex, 0));
+    if (pxIdx.isValid()) table->selectRow(pxIdx.row());
+
+    timeLabel->setToolTip(QString("Last track transition gap: %1 ms").arg(music.lastGapMs(), 0, 'f', 1));
+
+    updateNowPlaying();
+    updateTimeUI();
+    preloadNextTrack();
+    updateCountLabel();
+    refreshPlayPauseIcon();
+    updateUiTimer(); // new duration, new refresh interval
+    saveSession(true);
+}
+
+// ========================= Loudness =========================
+void MainWindow::analyzeLoudness() {
+    QStringList pending;
+    for (int r = 0; r < tracks().size(); ++r)
+        if (!tracks().loudnessAt(r).analyzed) pending << tracks().pathAt(r);
+    if (!pending.isEmpty()) loudness->analyze(pending);
+}
+
+void MainWindow::onLoudnessResults(const QVector<LoudnessResult>& results) {
+    // Album gain depends on every track of the album, so a result for any
+    // member of the playing tracks' albums moves it too.
+    const int preloadRow = tracks().rowOf(preloadedId);
+    const QString currentAlbum = albumKeyAt(currentIndex);
+    const QString preloadAlbum = albumKeyAt(preloadRow);
+    const bool byAlbum = normalizeBox->currentIndex() == NormalizeAlbum;
+
+    bool touchesPlayback = false;
+    for (const LoudnessResult& r : results) {
+        const int row = tracks().rowOf(tracks().idOfPath(r.path));
+        scanner->storeLoudness(r.path, r.loudness);
+        if (row < 0) continue;
+        model->setLoudness(row, r.loudness);
+        if (row == currentIndex || row == preloadRow) touchesPlayback = true;
+
+        const QString album = albumKeyAt(row);
+        if (album.isEmpty()) continue;
+        albumLoudness.remove(album);
+        if (byAlbum && (album == currentAlbum || album == preloadAlbum)) touchesPlayback = true;
+    }
+
+    if (touchesPlayback) applyNormalization();
+}
+
+void MainWindow::onLoudnessProgress(int done, int total) {
+    if (done < total)
+        normalizeBox->setToolTip(QString("Loudness normalization (EBU R128, -18 LUFS)\nAnalyzing: %1 of %2")
+                                     .arg(done).arg(total));
+}
+
+void MainWindow::onLoudnessFinished(const LoudnessStats& stats) {
+    scanner->saveCache();
+    normalizeBox->setToolTip(QString("Loudness normalization (EBU R128, -18 LUFS)\n"
+                                     "Analyzed %1 tracks (%2 unreadable) in %3 s on %4 threads:\n"
+                                     "%5 tracks/s per core, %6x realtime per core")
+                                 .arg(stats.done)
+                                 .arg(stats.failed)
+                                 .arg(stats.wallSeconds, 0, 'f', 1)
+                                 .arg(stats.threads)
+                                 .arg(stats.tracksPerSecondPerCore(), 0, 'f', 2)
+                                 .arg(stats.realtimePerCore(), 0, 'f', 0));
+}
+
+void MainWindow::onNormalizationChanged(int mode) {
+    session.setValue("player/normalization", mode, SessionStore::Urgency::Soon);
+    applyNormalization();
+}
+
+// Gain for a row under the current mode; 0 dB until the track is analyzed.
+double MainWindow::normalizationGainDb(int sourceRow) {
+    if (sourceRow < 0 || sourceRow >= tracks().size()) return 0.0;
+    const int mode = normalizeBox->currentIndex();
+    if (mode == NormalizeOff) return 0.0;
+
+    const TrackLoudness& own = tracks().loudnessAt(sourceRow);
+    const QString key = albumKeyAt(sourceRow);
+    if (mode == NormalizeTrack || key.isEmpty()) return LoudnessMeter::gainDb(own);
+
+    // One pass over the library the first time album gain is asked for;
+    // adds, removals and renames keep the index current after that.
+    if (!albumsIndexed) {
+        albumsIndexed = true;
+        for (int r = 0; r < tracks().size(); ++r) indexAlbum(r);
+    }
+
+    auto it = albumLoudness.constFind(key);
+    if (it == albumLoudness.constEnd()) {
+        QVector<TrackLoudness> members;
+        for (TrackId id : albumMembers.value(key)) {
+            const int r = tracks().rowOf(id);
+            if (r >= 0) members << tracks().loudnessAt(r);
+        }
+        it = albumLoudness.insert(key, LoudnessMeter::combine(members));
+    }
+    return LoudnessMeter::gainDb(it.value());
+}
+
+// Album = same album tag in the same folder.
+QString MainWindow::albumKeyAt(int sourceRow) const {
+    if (sourceRow < 0 || sourceRow >= tracks().size()) return QString();
+    const QString& album = tracks().albumAt(sourceRow);
+    if (album.isEmpty()) return QString();
+    const QString& path = tracks().pathAt(sourceRow);
+    return path.left(path.lastIndexOf('/') + 1) + '\n' + album;
+}
+
+void MainWindow::indexAlbum(int sourceRow) {
+    const QString key = albumKeyAt(sourceRow);
+    if (key.isEmpty()) return;
+    albumLoudness.remove(key);
+    if (albumsIndexed) albumMembers[key] << tracks().idAt(sourceRow);
+}
+
+void MainWindow::unindexAlbum(int sourceRow) {
+    const QString key = albumKeyAt(sourceRow);
+    if (key.isEmpty()) return;
+    albumLoudness.remove(key);
+    if (!albumsIndexed) return;
+    auto it = albumMembers.find(key);
+    if (it == albumMembers.end()) return;
+    it->removeOne(tracks().idAt(sourceRow));
+    if (it->isEmpty()) albumMembers.erase(it);
+}
+
+void MainWindow::applyNormalization() {
+    if (currentIndex >= 0) music.setTrackGain(normalizationGainDb(currentIndex));
+    if (preloadedId != kNoTrack) music.setNextTrackGain(normalizationGainDb(tracks().rowOf(preloadedId)));
+}
+
+// ========================= Duplicates =========================
+void MainWindow::hashContent() {
+    QStringList pending;
+    for (int r = 0; r < tracks().size(); ++r)
+        if (tracks().contentHashAt(r) == 0) pending << tracks().pathAt(r);
+    if (!pending.isEmpty()) duplicates->analyze(pending);
+}
+
+void MainWindow::onHashResults(const QVector<ContentHashResult>& results) {
+    for (const ContentHashResult& r : results) {
+        scanner->storeContentHash(r.path, r.hash, r.size, r.mtimeMs);
+        model->setContentHash(tracks().rowOf(tracks().idOfPath(r.path)), r.hash);
+    }
+}
+
+void MainWindow::onHashFinished(const HashStats& stats) {
+    scanner->saveCache();
+    const QVector<QVector<TrackId>> groups = tracks().duplicateGroups();
+    int extra = 0;
+    for (const auto& g : groups) extra += g.size() - 1;
+
+    duplicatesBtn->setVisible(!groups.isEmpty());
+    duplicatesBtn->setText(QString("Duplicates (%1)").arg(extra));
+    duplicatesBtn->setToolTip(QString("%1 songs have more than one copy in the library\n"
+                                      "Hashed %2 tracks (%3 unreadable) in %4 s, %5 MB/s on %6 threads, %7 reads at a time")
+                                  .arg(groups.size())
+                                  .arg(stats.done)
+                                  .arg(stats.failed)
+                                  .arg(stats.wallSeconds, 0, 'f', 1)
+                                  .arg(stats.megabytesPerSecond(), 0, 'f', 0)
+                                  .arg(stats.threads)
+                                  .arg(stats.readSlots));
+}
+
+void MainWindow::showDuplicates() {
+    const QVector<QVector<TrackId>> groups = tracks().duplicateGroups();
+    if (groups.isEmpty()) {
+        duplicatesBtn->hide();
+        return;
+    }
+
+    constexpr int kListed = 20;
+    QStringList lines;
+    for (int g = 0; g < std::min(int(groups.size()), kListed); ++g) {
+        for (TrackId id : groups[g]) lines << tracks().pathAt(tracks().rowOf(id));
+        lines << QString();
+    }
+    if (groups.size() > kListed) lines << QString("... and %1 more groups").arg(groups.size() - kListed);
+
+    QMessageBox::information(this, "Duplicate tracks",
+                             QString("These files have the same audio (tags ignored):\n\n") + lines.join('\n'));
+}
+
+// ========================= Playlist actions =========================
+void MainWindow::onDoubleClick(const QModelIndex& index) {
+    if (!index.isValid()) return;
+
+    int sourceRow = proxy->mapToSource(index).row();
+    const TrackId from = currentId();
+    if (loadIndex(sourceRow)) queue->played(from, tracks().idAt(sourceRow));
+}
+
+void MainWindow::onContextMenu(const QPoint& pos) {
+    QModelIndex proxyIdx = table->indexAt(pos);
+    if (!proxyIdx.isValid()) return;
+
+    int sourceRow = proxy->mapToSource(proxyIdx).row();
+    if (sourceRow < 0 || sourceRow >= tracks().size()) return;
+
+    QMenu menu(this);
+    QAction* actPlay     = menu.addAction("Play");
+    QAction* actPlayNext = menu.addAction("Play Next");
+    QAction* actEnqueue  = menu.addAction("Add to Queue");
+    QAction* actClearQueue = nullptr;
+    if (!queue->queued().empty())
+        actClearQueue = menu.addAction(QString("Clear Queue (%1)").arg(int(queue->queued().size())));
+    menu.addSeparator();
+    QAction* actReveal   = menu.addAction("Reveal in Explorer");
+    QAction* actRemove   = menu.addAction("Remove from Playlist");
+
+    QAction* chosen = menu.exec(table->viewport()->mapToGlobal(pos));
+    if (!chosen) return;
+
+    if (chosen == actPlay) {
+        const TrackId from = currentId();
+        if (loadIndex(sourceRow)) queue->played(from, tracks().idAt(sourceRow));
+        return;
+    }
+
+    // The queue holds IDs; the library rows stay where they are.
+    if (chosen == actPlayNext || chosen == actEnqueue || (actClearQueue && chosen == actClearQueue)) {
+        if (chosen == actPlayNext) queue->playNext(tracks().idAt(sourceRow));
+        else if (chosen == actEnqueue) queue->enqueue(tracks().idAt(sourceRow));
+        else queue->clearQueue();
+        refreshPreload();
+        updateCountLabel();
+        return;
+    }
+
+    if (chosen == actReveal) {
+        QString path = tracks().pathAt(sourceRow);
+        QDesktopServices::openUrl(QUrl::fromLocalFile(QFileInfo(path).absolutePath()));
+        return;
+    }
+
+    if (chosen == actRemove) {
+        removeRow(sourceRow);
+        return;
+    }
+}
+
+void MainWindow::removeRows(const QVector<int>& sourceRows) {
+    QVector<int> rows = sourceRows;
+    std::sort(rows.begin(), rows.end(), std::greater<int>());
+    rows.erase(std::unique(rows.begin(), rows.end()), rows.end());
+    if (rows.isEmpty()) return;
+
+    // Last row first, so an anchor stepped back off one removed track does
+    // not land on another.
+    const TrackId current = currentId();
+    for (int row : rows) {
+        queue->forget(tracks().idAt(row));
+        unindexAlbum(row);
+        if (row == currentIndex) {
+            stop();
+            currentIndex = -1;
+            bigTitleLabel->setText("No song selected");
+            bigArtistLabel->setText("—");
+            setArtworkPixmap(QPixmap());
+        }
+    }
+
+    model->removeTracks(rows);
+    if (currentIndex >= 0) currentIndex = tracks().rowOf(current);
+    refreshPreload();
+    updateCountLabel();
+}
+
+// ========================= Library changes on disk =========================
+void MainWindow::onFilesAdded(const QStringList& paths) {
+    // Through the scanner: tags, lyrics and the cache, off the GUI thread.
+    scanner->scanFiles(paths, true);
+}
+
+void MainWindow::onFilesRemoved(const QStringList& paths) {
+    QVector<int> rows;
+    rows.reserve(paths.size());
+    for (const QString& p : paths) {
+        const int row = tracks().rowOf(tracks().idOfPath(p));
+        if (row >= 0) rows << row;
+    }
+    removeRows(rows); // one pass over the store for the whole batch
+}
+
+void MainWindow::onFileRenamed(const QString& from, const QString& to) {
+    const int row = tracks().rowOf(tracks().idOfPath(from));
+    if (row < 0) return;
+    unindexAlbum(row); // the file may have moved to another folder
+    model->renameTrack(row, to);
+    indexAlbum(row);
+    scanner->renameCached(from, to); // loudness, play count and seek index move along
+    if (row == currentIndex) saveSession(true);
+}
+
+// ========================= Controls =========================
+void MainWindow::togglePlayPause() {
+    if (tracks().isEmpty()) {
+        showError(this, "No songs", "Load a folder or drop audio files first.");
+        return;
+    }
+
+    if (music.isOpening()) {
+        // Still opening: flip what happens once it is ready.
+        pendingOpen.play = !pendingOpen.play;
+        return;
+    }
+
+    if (currentIndex < 0) {
+        next(); // the queue, or where the library order left off
+        return;
+    }
+
+    if (music.getStatus() == sf::Sound::Status::Playing) {
+        music.pause();
+    } else {
+        music.play();
+    }
+
+    refreshPlayPauseIcon();
+    saveSession(true); // save immediately on play/pause
+}
+
+void MainWindow::stop() {
+    pendingOpen.play = false; // an open still in flight should not start playing
+    music.stop();
+    refreshPlayPauseIcon();
+    updateTimeUI();
+    saveSession(true);
+}
+
+void MainWindow::next() {
+    if (tracks().isEmpty()) return;
+
+    const TrackId nxt = queue->advance(currentId(), PlayQueue::Step::Skip);
+    if (nxt == kNoTrack) return; // end of the library, repeat off
+
+    loadIndex(tracks().rowOf(nxt)); // plays and saves the session once opened
+}
+
+void MainWindow::prev() {
+    if (tracks().isEmpty()) return;
+
+    // Back through what actually played; at the start, replay the current track.
+    const TrackId prv = queue->back(currentId());
+    loadIndex(prv != kNoTrack ? tracks().rowOf(prv) : std::max(currentIndex, 0));
+}
+
+void MainWindow::cycleRepeat() {
+    switch (queue->repeat()) {
+    case PlayQueue::Repeat::Off: queue->setRepeat(PlayQueue::Repeat::All); break;
+    case PlayQueue::Repeat::All: queue->setRepeat(PlayQueue::Repeat::One); break;
+    case PlayQueue::Repeat::One: queue->setRepeat(PlayQueue::Repeat::Off); break;
+    }
+    session.setValue("player/repeat", int(queue->repeat()), SessionStore::Urgency::Soon);
+    refreshRepeatButton();
+    refreshPreload();
+}
+
+void MainWindow::onShuffleChanged(int index) {
+    queue->setShuffle(index > 0);
+    if (index > 0) queue->setShuffleMode(ShuffleOrder::Mode(index - 1));
+    session.setValue("player/shuffle", index, SessionStore::Urgency::Soon);
+    refreshPreload();
+}
+
+void MainWindow::refreshRepeatButton() {
+    switch (queue->repeat()) {
+    case PlayQueue::Repeat::Off: repeatBtn->setText("Repeat: Off"); break;
+    case PlayQueue::Repeat::All: repeatBtn->setText("Repeat: All"); break;
+    case PlayQueue::Repeat::One: repeatBtn->setText("Repeat: One"); break;
+    }
+}
+
+// ========================= Seek/Volume =========================
+void MainWindow::seekPressed() { userSeeking = true; }
+
+void MainWindow::seekReleased() {
+    float dur = music.getDuration().asSeconds();
+    if (dur <= 0.f) { userSeeking = false; return; }
+
+    float target = (float(seekSlider->value()) / seekSlider->maximum()) * dur;
+    if (music.switchPending()) {
+        // The next track is already spliced in behind the last few hundred
+        // milliseconds of this one; reopen this one at the target instead.
+        userSeeking = false;
+        loadIndex(currentIndex, music.getStatus() == sf::SoundSource::Status::Playing, target);
+        return;
+    }
+    music.setPlayingOffset(sf::seconds(target));
+
+    userSeeking = false;
+    updateTimeUI();
+    saveSession(true);
+}
+
+void MainWindow::volumeChanged(int v) { music.setVolume((float)v); }
+
+// ========================= Playback events =========================
+void MainWindow::onPlaybackStatusChanged() {
+    refreshPlayPauseIcon();
+    updateTimeUI();
+    updateUiTimer();
+}
+
+void MainWindow::onTrackFinished() {
+    // Auto-next when song ends naturally and no gapless successor was ready
+    countPlay(currentIndex);
+    if (currentIndex >= 0) {
+        session.setResumePosition(tracks().pathAt(currentIndex), 0.0); // played to the end
+        const TrackId nxt = queue->advance(currentId(), PlayQueue::Step::Auto);
+        if (nxt != kNoTrack && loadIndex(tracks().rowOf(nxt))) return;
+    }
+    refreshPlayPauseIcon();
+    updateTimeUI();
+    saveSession(true);
+}
+
+// Refreshes about once per slider pixel, between 10 Hz and 1 Hz, and not at
+// all while paused, stopped, hidden or minimized. The session journal keeps
+// its own timer, which only depends on playback.
+void MainWindow::updateUiTimer() {
+    const bool playing = music.getStatus() == sf::Sound::Status::Playing;
+    const bool visible = isVisible() && !isMinimized();
+
+    if (!playing) sessionTimer->stop();
+    else if (!sessionTimer->isActive()) sessionTimer->start();
+
+    if (!playing || !visible) {
+        uiTimer->stop();
+        return;
+    }
+
+    const int durationMs = music.getDuration().asMilliseconds();
+    const int pixels = std::max(1, seekSlider->width());
+    const int visibleMs = int(durationMs * seekSlider->visibleSpan()); // zoomed waveform: finer steps
+    const int interval = std::clamp(visibleMs / pixels, 100, 1000);
+
+    if (!uiTimer->isActive() || uiTimer->interval() != interval) uiTimer->start(interval);
+}
+
+void MainWindow::changeEvent(QEvent* e) {
+    QMainWindow::changeEvent(e);
+    if (e->type() == QEvent::WindowStateChange) updateUiTimer();
+}
+
+void MainWindow::showEvent(QShowEvent* e) {
+    QMainWindow::showEvent(e);
+    updateUiTimer();
+}
+
+void MainWindow::hideEvent(QHideEvent* e) {
+    QMainWindow::hideEvent(e);
+    updateUiTimer();
+}
+
+// ========================= Timer tick =========================
+void MainWindow::tick() {
+    TRACE_SCOPE("MainWindow::tick");
+    updateTimeUI();
+    TRACE_COUNTER("dsp.blockMaxUs", music.dspStats().maxUs);
+}
+
+// ========================= Counts & time =========================
+void MainWindow::updateCountLabel() {
+    int total = tracks().size();
+    // Unfiltered, rows not fetched yet count as not shown; a search counts
+    // all its matches, fetched or not.
+    int shown = proxy->query().isEmpty() ? proxy->rowCount() : std::max(proxy->rowCount(), proxy->matchCount());
+    QString text = QString("Showing %1 of %2").arg(shown).arg(total);
+    if (!queue->queued().empty()) text += QString(", %1 queued").arg(int(queue->queued().size()));
+    countLabel->setText(text);
+    TRACE_COUNTER("library.tracks", total);
+    TRACE_COUNTER("filter.shown", shown);
+}
+
+QString MainWindow::formatTime(float seconds) {
+    if (seconds < 0) seconds = 0;
+    int total = (int)(seconds + 0.5f);
+    int mins = total / 60;
+    int secs = total % 60;
+    return QString("%1:%2").arg(mins).arg(secs, 2, 10, QChar('0'));
+}
+
+void MainWindow::updateNowPlaying() {
+    if (currentIndex < 0 || currentIndex >= tracks().size()) return;
+
+    const QString& title = tracks().titleAt(currentIndex);
+    const QString& artist = tracks().artistAt(currentIndex);
+
+    bigTitleLabel->setText(title.isEmpty() ? "Unknown Title" : title);
+    bigArtistLabel->setText(artist.isEmpty() ? "Unknown Artist" : artist);
+
+    setArtworkPixmap(artwork.thumbnailFor(tracks().pathAt(currentIndex)));
+
+    // Cached peaks show at once; otherwise onWaveformReady() fills them in.
+    seekSlider->setPeaks(waveforms->request(tracks().pathAt(currentIndex)));
+}
+
+void MainWindow::onWaveformReady(const QString& path, PeakPyramidPtr peaks) {
+    if (currentIndex < 0 || currentIndex >= tracks().size()) return;
+    if (tracks().pathAt(currentIndex) == path) seekSlider->setPeaks(std::move(peaks));
+}
+
+void MainWindow::updateTimeUI() {
+    if (music.isOpening()) {
+        timeLabel->setText("Loading…");
+        return;
+    }
+
+    float dur = music.getDuration().asSeconds();
+    float pos = music.getPlayingOffset().asSeconds();
+
+    if (dur < 0) dur = 0;
+    if (pos < 0) pos = 0;
+    if (pos > dur) pos = dur;
+
+    timeLabel->setText(formatTime(pos) + " / " + formatTime(dur));
+
+    if (!userSeeking && dur > 0.f) {
+        const int steps = seekSlider->maximum();
+        int v = (int)((pos / dur) * steps);
+        v = std::max(0, std::min(steps, v));
+        seekSlider->setValue(v);
+    }
+}
+
+// ========================= Artwork =========================
+void MainWindow::setArtworkPixmap(const QPixmap& px) {
+    if (px.isNull()) {
+        QPixmap placeholder(56, 56);
+        placeholder.fill(QColor("#2b3754"));
+        artLabel->setPixmap(placeholder);
+        return;
+    }
+
+    artLabel->setPixmap(px); // already thumbnail-sized by ArtworkCache
+}
+
+// ========================= Diagnostics =========================
+void MainWindow::showTracePanel() {
+    if (!tracePanel) tracePanel = new TracePanel(stallDetector, this);
+    tracePanel->show();
+    tracePanel->raise();
+    tracePanel->activateWindow();
+}
+
+void MainWindow::showEqualizer() {
+    if (!equalizerPanel) {
+        equalizerPanel = new EqualizerPanel(&music, this);
+        connect(equalizerPanel, &EqualizerPanel::paramsChanged, this, [this](const DspParams& p) {
+            session.setValue("player/dsp", EqualizerPanel::toVariant(p), SessionStore::Urgency::Soon);
+        });
+    }
+    equalizerPanel->show();
+    equalizerPanel->raise();
+    equalizerPanel->activateWindow();
+}
+
+// ========================= Session persistence =========================
+void MainWindow::restoreLastSession() {
+    if (!session.load()) {
+        // First run with the journal: carry over what QSettings remembered.
+        QSettings old("NileUniversity", "QtMusicPlayer");
+        for (const QString& key : old.allKeys())
+            if (key.startsWith("player/")) session.setValue(key, old.value(key));
+    }
+
+    normalizeBox->setCurrentIndex(session.value("player/normalization", int(NormalizeTrack)).toInt());
+    music.setDspParams(EqualizerPanel::fromVariant(session.value("player/dsp").toMap()));
+    queue->setRepeat(PlayQueue::Repeat(session.value("player/repeat", 0).toInt()));
+    refreshRepeatButton();
+    shuffleBox->setCurrentIndex(session.value("player/shuffle", 0).toInt());
+
+    QStringList roots = session.value("player/roots").toStringList();
+    if (roots.isEmpty()) {
+        const QString folder = session.value("player/lastFolder", "").toString(); // older sessions
+        if (!folder.isEmpty()) roots << folder;
+    }
+    const QString path   = session.value("player/lastPath", "").toString();
+    const int index      = session.value("player/lastIndex", -1).toInt();
+    const double offset  = session.value("player/lastOffsetSeconds", 0.0).toDouble();
+    const bool playNow   = session.value("player/wasPlaying", false).toBool();
+
+    roots.erase(std::remove_if(roots.begin(), roots.end(), [](const QString& r) { return !QFileInfo::exists(r); }),
+                roots.end());
+    if (roots.isEmpty()) return;
+
+    loadFolder(roots.takeFirst()); // cancels scans, so the restore is armed after it
+
+    // The scans are asynchronous; onScanFinished() applies the saved track
+    // once the last one is done.
+    pendingRestore.active = true;
+    pendingRestore.path = path;
+    pendingRestore.index = index;
+    pendingRestore.offset = offset;
+    pendingRestore.playNow = playNow;
+
+    for (const QString& r : roots) addLibraryRoot(r);
+}
+
+// Only updates SessionStore's in-memory state; the store coalesces the
+// changes and journals them on its writer thread.
+void MainWindow::saveSession(bool force) {
+    TRACE_SCOPE("MainWindow::saveSession");
+    // Need a folder to restore from
+    if (libraryRoots.isEmpty()) return;
+
+    bool playing = (music.getStatus() == sf::Sound::Status::Playing);
+
+    // If not forced, save only while playing
+    if (!force && !playing) return;
+
+    // Forced saves follow user actions; get those to disk quickly.
+    const auto urgency = force ? SessionStore::Urgency::Soon : SessionStore::Urgency::Lazy;
+    const QString path = currentIndex >= 0 ? tracks().pathAt(currentIndex) : QString();
+    const double offset = static_cast<double>(music.getPlayingOffset().asSeconds());
+
+    session.setValue("player/roots", libraryRoots, urgency);
+    session.setValue("player/lastFolder", libraryRoots.first(), urgency);
+    session.setValue("player/lastIndex", currentIndex, urgency);
+    session.setValue("player/lastPath", path, urgency);
+    session.setValue("player/lastOffsetSeconds", offset, urgency);
+    session.setValue("player/wasPlaying", playing, urgency);
+    if (!path.isEmpty()) session.setResumePosition(path, offset);
+}
+
+void MainWindow::closeEvent(QCloseEvent* e) {
+    saveSession(true);
+    session.flushAndWait(); // the one synchronous write
+    QMainWindow::closeEvent(e);
+}
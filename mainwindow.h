@@ -1,144 +1,258 @@
-/*
- * Author: Itoro Ifon, jason Hippolite, Prince Umeh
- * Date: 2026-01-22
- * Course/Assignment: C++ Project - Qt Music Player
- * File: MainWindow.h
- * Purpose: Declares the MainWindow class, which provides the user interface
- *          and connects UI actions to music playback logic.
- */
-#pragma once
-
-#include <QMainWindow>
-#include <QLineEdit>
-#include <QTableView>
-#include <QPushButton>
-#include <QSlider>
-#include <QLabel>
-#include <QTimer>
-#include <QStandardItemModel>
-#include <QSortFilterProxyModel>
-#include <QFrame>
-#include <QStringList>
-#include <QPixmap>
-
-#include <SFML/Audio.hpp>
-
-// Class: MusicPlayerWindow
-// Purpose: Main UI window for the music player. Handles user interactions,
-//          playlist display, searching, and controlling audio playback.
-// Function: addSongs()
-// Purpose: Opens a file dialog to let the user select audio files, validates
-//          supported formats, then adds valid tracks to the playlist/list.
-// Parameters: None
-// Returns: void
-// Notes: Currently supports WAV only.
-
-class TrackFilterModel : public QSortFilterProxyModel {
-    Q_OBJECT
-public:
-    using QSortFilterProxyModel::QSortFilterProxyModel;
-
-protected:
-    bool filterAcceptsRow(int row, const QModelIndex& parent) const override;
-};
-
-class MainWindow : public QMainWindow {
-    Q_OBJECT
-
-public:
-    explicit MainWindow(QWidget *parent = nullptr);
-
-protected:
-    void dragEnterEvent(QDragEnterEvent* e) override;
-    void dropEvent(QDropEvent* e) override;
-    void closeEvent(QCloseEvent* e) override; // ✅ save on exit
-
-private slots:
-    void openFolder();
-    void onDoubleClick(const QModelIndex& index);
-    void onContextMenu(const QPoint& pos);
-
-    void togglePlayPause();
-    void stop();
-    void next();
-    void prev();
-
-    void seekPressed();
-    void seekReleased();
-    void volumeChanged(int v);
-    void tick();
-
-private:
-    // UI
-    void buildUI();
-    void applyThemeLite();
-    void refreshPlayPauseIcon();
-
-    // Library
-    void loadFolder(const QString& folderPath);
-    void addFiles(const QStringList& filePaths);
-    bool loadIndex(int sourceRow);
-
-    // UI updates
-    void updateNowPlaying();
-    void updateTimeUI();
-    void updateCountLabel();
-
-    // Helpers
-    static QString formatTime(float seconds);
-    static void parseArtistTitleFromFilename(const QString& fileNameNoExt, QString& artist, QString& title);
-    static bool isSupportedAudio(const QString& path);
-
-    static QString loadLyricsSidecar(const QString& audioPath);
-    static QString cleanLyricsText(QString s);
-
-    QPixmap loadArtworkForTrack(const QString& audioPath) const;
-    void setArtworkPixmap(const QPixmap& px);
-
-    // ✅ Session persistence
-    void restoreLastSession();
-    void saveSession(bool force = false);
-
-    // ===== Widgets =====
-    QPushButton* openBtn = nullptr;
-    QLineEdit* searchBox = nullptr;
-    QLabel* countLabel = nullptr;
-
-    QTableView* table = nullptr;
-    QStandardItemModel* model = nullptr;
-    TrackFilterModel* proxy = nullptr;
-
-    QFrame* playerBar = nullptr;
-    QLabel* artLabel = nullptr;
-    QLabel* bigTitleLabel = nullptr;
-    QLabel* bigArtistLabel = nullptr;
-
-    QPushButton* prevBtn = nullptr;
-    QPushButton* playPauseBtn = nullptr;
-    QPushButton* stopBtn = nullptr;
-    QPushButton* nextBtn = nullptr;
-
-    QSlider* seekSlider = nullptr;
-    QLabel* timeLabel = nullptr;
-
-    QSlider* volumeSlider = nullptr;
-    QTimer* timer = nullptr;
-
-    // ===== Audio =====
-    sf::Music music;
-
-    // Data: aligns with SOURCE model rows
-    QStringList playlistFullPaths;
-
-    // Playback state
-    int currentIndex = -1;
-    bool userSeeking = false;
-    bool stoppedByUser = false;
-    bool wasPlaying = false;
-
-    // ✅ Keep track of folder we loaded (for session restore/save)
-    QString lastLoadedFolder;
-
-    // ✅ Throttle session saves
-    int tickCounter = 0;
-};
+/*
+ * Author: Itoro Ifon, jason Hippolite, Prince Umeh
+ * Date: 2026-01-22
+ * Course/Assignment: C++ Project - Qt Music Player
+ * File: MainWindow.h
+ * Purpose: Declares the MainWindow class, which provides the user interface
+ *          and connects UI actions to music playback logic.
+ */
+#pragma once
+
+#include <QMainWindow>
+#include <QLineEdit>
+#include <QTableView>
+#include <QPushButton>
+#include <QSlider>
+#include <QLabel>
+#include <QTimer>
+#include <QFrame>
+#include <QStringList>
+#include <QPixmap>
+#include <QProgressBar>
+#include <QComboBox>
+#include <QHash>
+
+#include <memory>
+
+#include <SFML/Audio.hpp>
+
+#include "libraryscanner.h"
+#include "librarymodel.h"
+#include "trackfiltermodel.h"
+#include "playbackengine.h"
+#include "artworkcache.h"
+#include "librarywatcher.h"
+#include "sessionstore.h"
+#include "tracer.h"
+#include "loudnessscanner.h"
+#include "duplicatescanner.h"
+#include "waveformprovider.h"
+#include "waveformseekbar.h"
+#include "equalizerpanel.h"
+#include "playqueue.h"
+
+class TracePanel;
+
+// Class: MusicPlayerWindow
+// Purpose: Main UI window for the music player. Handles user interactions,
+//          playlist display, searching, and controlling audio playback.
+// Function: addSongs()
+// Purpose: Opens a file dialog to let the user select audio files, validates
+//          supported formats, then adds valid tracks to the playlist/list.
+// Parameters: None
+// Returns: void
+// Notes: Currently supports WAV only.
+
+class MainWindow : public QMainWindow {
+    Q_OBJECT
+
+public:
+    explicit MainWindow(QWidget *parent = nullptr);
+
+protected:
+    void dragEnterEvent(QDragEnterEvent* e) override;
+    void dropEvent(QDropEvent* e) override;
+    void closeEvent(QCloseEvent* e) override; // ✅ save on exit
+    void changeEvent(QEvent* e) override;     // minimize/restore pauses UI refresh
+    void showEvent(QShowEvent* e) override;
+    void hideEvent(QHideEvent* e) override;
+
+private slots:
+    void openFolder();
+    void addFolder();
+    void onDoubleClick(const QModelIndex& index);
+    void onContextMenu(const QPoint& pos);
+    void onSortRequested(int column, Qt::SortOrder order); // header click
+    void onQueryApplied();
+
+    void togglePlayPause();
+    void stop();
+    void next();
+    void prev();
+    void cycleRepeat();
+    void onShuffleChanged(int index);
+
+    void seekPressed();
+    void seekReleased();
+    void volumeChanged(int v);
+    void tick();
+
+    // Background scan results
+    void onScanBatch(const QVector<ScannedTrack>& batch);
+    void onScanProgress(int done, int total);
+    void onScanFinished(const ScanReport& report);
+
+    // Library roots changed on disk
+    void onFilesAdded(const QStringList& paths);
+    void onFilesRemoved(const QStringList& paths);
+    void onFileRenamed(const QString& from, const QString& to);
+
+    // Gapless playback moved on to the preloaded track
+    void onAdvancedToNext();
+    void onTrackOpened(const QString& path, bool ok);
+    void onPlaybackStatusChanged();
+    void onTrackFinished();
+
+    void showTracePanel();
+    void showEqualizer();
+
+    // Loudness analysis and normalization
+    void onLoudnessResults(const QVector<LoudnessResult>& results);
+    void onLoudnessProgress(int done, int total);
+    void onLoudnessFinished(const LoudnessStats& stats);
+    void onNormalizationChanged(int mode);
+
+    // Content hashing and duplicate groups
+    void onHashResults(const QVector<ContentHashResult>& results);
+    void onHashFinished(const HashStats& stats);
+    void showDuplicates();
+
+    // Waveform peaks finished loading
+    void onWaveformReady(const QString& path, PeakPyramidPtr peaks);
+
+private:
+    // UI
+    void buildUI();
+    void applyThemeLite();
+    void refreshPlayPauseIcon();
+    void updateUiTimer();
+
+    // Library
+    void loadFolder(const QString& folderPath);
+    void addLibraryRoot(const QString& folderPath);
+    void removeRow(int sourceRow) { removeRows({sourceRow}); }
+    void removeRows(const QVector<int>& sourceRows);
+    void addFiles(const QStringList& filePaths);
+    void addScannedTracks(const QVector<ScannedTrack>& batch);
+    void showFirstTrack(); // selects row 0 when nothing is current
+    bool loadIndex(int sourceRow, bool autoPlay = true, double startOffset = 0.0);
+    void preloadNextTrack();
+    void countPlay(int sourceRow); // played to the end: feeds the least-played shuffle
+    void refreshPreload(); // preloads again only if the next track changed
+    void analyzeLoudness();          // queues every track not analyzed yet
+    void hashContent();              // queues every track not hashed yet
+    double normalizationGainDb(int sourceRow);
+    void applyNormalization();       // re-applies gains to the current and next track
+    QString albumKeyAt(int sourceRow) const; // folder + album tag; empty without a tag
+    void indexAlbum(int sourceRow);   // the row joined its album (call after adding)
+    void unindexAlbum(int sourceRow); // the row leaves its album (call before removing)
+
+    // UI updates
+    void updateNowPlaying();
+    void updateTimeUI();
+    void updateCountLabel();
+    void refreshRepeatButton();
+
+    // Helpers
+    static QString formatTime(float seconds);
+
+    void setArtworkPixmap(const QPixmap& px);
+
+    // ✅ Session persistence
+    void restoreLastSession();
+    void saveSession(bool force = false);
+
+    // ===== Widgets =====
+    QPushButton* openBtn = nullptr;
+    QPushButton* addFolderBtn = nullptr;
+    QLineEdit* searchBox = nullptr;
+    QLabel* countLabel = nullptr;
+    QProgressBar* scanProgress = nullptr;
+    QPushButton* cancelScanBtn = nullptr;
+    QPushButton* duplicatesBtn = nullptr;
+
+    QTableView* table = nullptr;
+    LibraryModel* model = nullptr;
+    TrackFilterModel* proxy = nullptr;
+
+    QFrame* playerBar = nullptr;
+    QLabel* artLabel = nullptr;
+    QLabel* bigTitleLabel = nullptr;
+    QLabel* bigArtistLabel = nullptr;
+
+    QPushButton* prevBtn = nullptr;
+    QPushButton* playPauseBtn = nullptr;
+    QPushButton* stopBtn = nullptr;
+    QPushButton* nextBtn = nullptr;
+    QPushButton* repeatBtn = nullptr;
+    QComboBox* shuffleBox = nullptr;
+
+    WaveformSeekBar* seekSlider = nullptr;
+    QLabel* timeLabel = nullptr;
+
+    QSlider* volumeSlider = nullptr;
+    QComboBox* normalizeBox = nullptr;
+    QPushButton* eqBtn = nullptr;
+    QTimer* uiTimer = nullptr;
+    QTimer* sessionTimer = nullptr;
+
+    // Thumbnail cache for the 56x56 artLabel
+    ArtworkCache artwork{QSize(56, 56)};
+
+    // ===== Audio =====
+    PlaybackEngine music;
+    TrackId preloadedId = kNoTrack; // track opened ahead for gapless playback
+
+    // ===== Library =====
+    LibraryScanner* scanner = nullptr;
+    LibraryWatcher* watcher = nullptr;
+    LoudnessScanner* loudness = nullptr;
+    DuplicateScanner* duplicates = nullptr;
+    WaveformProvider* waveforms = nullptr;
+
+    // Normalization: Off / per track / per album (folder + album tag)
+    enum Normalization { NormalizeOff = 0, NormalizeTrack, NormalizeAlbum };
+    QHash<QString, TrackLoudness> albumLoudness;   // memo per album key, dropped when a member changes
+    QHash<QString, QVector<TrackId>> albumMembers; // album key -> tracks, built on first use
+    bool albumsIndexed = false;
+
+    // Data: the model owns the track rows; this is a read-only shortcut
+    const TrackStore& tracks() const { return model->store(); }
+    TrackId currentId() const { return currentIndex >= 0 ? tracks().idAt(currentIndex) : kNoTrack; }
+
+    // Play order: queue, history and repeat over track IDs; created with the model
+    std::unique_ptr<PlayQueue> queue;
+
+    // Playback state
+    int currentIndex = -1;
+    bool userSeeking = false;
+
+    // ✅ Session state; written behind by a journal (see SessionStore)
+    SessionStore session;
+
+    // Diagnostics (Ctrl+Shift+D): tracing is off unless enabled there or
+    // through QTMUSICPLAYER_TRACE
+    StallDetector* stallDetector = nullptr;
+    TracePanel* tracePanel = nullptr;
+
+    // Preamp / EQ / limiter window, created on first use
+    EqualizerPanel* equalizerPanel = nullptr;
+
+    // ✅ Library root folders, scanned recursively (for session restore/save)
+    QStringList libraryRoots;
+
+    // What to do once the engine finishes opening the requested track
+    struct PendingOpen {
+        bool play = true;
+        double offset = 0.0;
+    } pendingOpen;
+
+    // Session restore waits for every root's scan to finish
+    struct PendingRestore {
+        bool active = false;
+        QString path;  // preferred: row order across roots depends on scan timing
+        int index = -1;
+        double offset = 0.0;
+        bool playNow = false;
+    } pendingRestore;
+};
@@ -0,0 +1,484 @@
+/*
+ * Author: Itoro Ifon, jason Hippolite, Prince Umeh
+ * Date: 2026-10-16
+ * Course/Assignment: C++ Project - Qt Music Player
+ * File: playbackengine.cpp
+ * Purpose: Implements the gapless PlaybackStream and the PlaybackEngine that
+ *          drives it from the GUI thread.
+ */
+#include "playbackengine.h"
+#include "tracer.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <filesystem>
+#include <optional>
+
+// ========================= TrackFile =========================
+namespace {
+
+// Class: IndexedFlacStream
+// Purpose: Presents a FLAC file with its metadata replaced by
+//          SeekIndex::flacPrefix(): the prefix comes from memory, the
+//          frames from the file, unchanged.
+class IndexedFlacStream : public sf::InputStream {
+public:
+    bool open(const std::filesystem::path& path, QByteArray header, qint64 audioOffset) {
+        if (header.isEmpty() || audioOffset <= 0 || !file.open(path)) return false;
+        const std::optional<std::size_t> fileSize = file.getSize();
+        if (!fileSize || *fileSize <= std::size_t(audioOffset)) return false;
+        prefix = std::move(header);
+        audioStart = std::size_t(audioOffset);
+        total = std::size_t(prefix.size()) + (*fileSize - audioStart);
+        return true;
+    }
+
+    std::optional<std::size_t> read(void* data, std::size_t size) override {
+        auto* out = static_cast<char*>(data);
+        const std::size_t prefixSize = std::size_t(prefix.size());
+        std::size_t done = 0;
+        if (pos < prefixSize) {
+            done = std::min(size, prefixSize - pos);
+            std::memcpy(out, prefix.constData() + pos, done);
+            pos += done;
+        }
+        if (done < size && pos < total) {
+            const std::size_t at = audioStart + (pos - prefixSize);
+            if (at != filePos && file.seek(at) != at) return std::nullopt;
+            const std::optional<std::size_t> got = file.read(out + done, size - done);
+            if (!got) return std::nullopt;
+            filePos = at + *got;
+            pos += *got;
+            done += *got;
+        }
+        return done;
+    }
+
+    std::optional<std::size_t> seek(std::size_t position) override {
+        pos = std::min(position, total);
+        return pos;
+    }
+
+    std::optional<std::size_t> tell() override { return pos; }
+    std::optional<std::size_t> getSize() override { return total; }
+
+private:
+    sf::FileInputStream file;
+    QByteArray prefix;
+    std::size_t audioStart = 0;
+    std::size_t total = 0;
+    std::size_t pos = 0;     // in the presented stream
+    std::size_t filePos = 0; // where `file` is positioned
+};
+
+} // namespace
+
+bool TrackFile::open(const QString& path, const SeekIndex& index) {
+    const std::filesystem::path fsPath(path.toStdU16String());
+    if (!index.isEmpty()) {
+        auto view = std::make_unique<IndexedFlacStream>();
+        if (view->open(fsPath, index.flacPrefix(path), index.audioOffset()) && openFromStream(*view)) {
+            source = std::move(view);
+            return true;
+        }
+        // Stale or unreadable index: fall back to the plain file.
+    }
+    return openFromFile(fsPath);
+}
+
+// ========================= PlaybackStream =========================
+static std::uint64_t formatOf(const sf::InputSoundFile& f) {
+    return (std::uint64_t(f.getSampleRate()) << 16) | f.getChannelCount();
+}
+
+PlaybackStream::~PlaybackStream() {
+    // The audio thread calls back into this object; stop it before members go.
+    stop();
+    delete next.exchange(nullptr);
+    delete retired.exchange(nullptr);
+}
+
+bool PlaybackStream::sameFormat(const sf::InputSoundFile& a, const sf::InputSoundFile& b) {
+    return a.getSampleRate() == b.getSampleRate() && a.getChannelCount() == b.getChannelCount();
+}
+
+void PlaybackStream::setCurrent(std::unique_ptr<TrackFile> file, float fileGain) {
+    stop(); // from here on the audio thread is idle
+
+    current = std::move(file);
+    gain = fileGain;
+    delete next.exchange(nullptr);
+    delete retired.exchange(nullptr);
+    seekTarget = -1;
+    samplesFed = 0;
+    boundarySample = 0;
+    pendingSwitch = false;
+    endOfData = false;
+    serviceRequested = false;
+    channels = 0;
+    samplesPerSecond = 0.0;
+
+    if (!current) return;
+
+    channels = current->getChannelCount();
+    const unsigned rate = current->getSampleRate();
+    samplesPerSecond = double(rate) * channels;
+
+    // ~100 ms per chunk, a whole number of frames. All allocation for the
+    // audio thread happens here, while it is stopped.
+    buffer.assign(std::size_t(rate / 10) * channels, 0);
+    chain.prepare(rate, channels, rate / 10);
+
+    if (channels > 0) initialize(channels, rate, current->getChannelMap());
+}
+
+void PlaybackStream::setNext(std::unique_ptr<TrackFile> file, float fileGain) {
+    nextGain = fileGain;
+    nextFormat = file ? formatOf(*file) : 0;
+    delete next.exchange(file.release()); // the audio thread never holds a file it has not taken
+}
+
+std::unique_ptr<TrackFile> PlaybackStream::takeNext() {
+    nextFormat = 0;
+    return std::unique_ptr<TrackFile>(next.exchange(nullptr));
+}
+
+sf::Time PlaybackStream::boundary() const {
+    if (samplesPerSecond <= 0.0) return sf::Time::Zero;
+    return sf::seconds(float(double(boundarySample) / samplesPerSecond));
+}
+
+sf::Time PlaybackStream::fedUpTo() const {
+    if (samplesPerSecond <= 0.0) return sf::Time::Zero;
+    return sf::seconds(float(double(samplesFed) / samplesPerSecond));
+}
+
+sf::Time PlaybackStream::chunkDuration() const {
+    // `buffer` is only resized in setCurrent(), while the audio thread is idle.
+    if (samplesPerSecond <= 0.0) return sf::Time::Zero;
+    return sf::seconds(float(double(buffer.size()) / samplesPerSecond));
+}
+
+void PlaybackStream::acknowledgeSwitch() {
+    releaseRetired(); // the next splice may reuse the slot once this is cleared
+    pendingSwitch = false;
+}
+
+std::chrono::steady_clock::time_point PlaybackStream::endTime() const {
+    return std::chrono::steady_clock::time_point(std::chrono::steady_clock::duration(endTicks.load()));
+}
+
+void PlaybackStream::releaseRetired() {
+    // Closes the file here, on the calling (GUI) thread.
+    std::unique_ptr<TrackFile> old(retired.exchange(nullptr));
+}
+
+// Audio thread: the current file ran out after `filled` samples. Takes the
+// next file if its format matches and continues the chunk from it.
+bool PlaybackStream::spliceNext(std::uint64_t filled) {
+    // Only this thread fills `retired`, and only while it is empty, so a
+    // retired file is never overwritten. Until the GUI thread has freed it
+    // there is no splice; the stream runs dry and service() restarts it.
+    if (pendingSwitch || retired.load() || nextFormat.load() != formatOf(*current)) return false;
+
+    TrackFile* taken = next.exchange(nullptr);
+    if (!taken) return false;
+    if (!sameFormat(*current, *taken)) {
+        // Replaced between the format check and the exchange: put it back,
+        // or retire it if an even newer file is already there.
+        TrackFile* expected = nullptr;
+        if (!next.compare_exchange_strong(expected, taken)) {
+            retired.store(taken);
+            serviceRequested = true; // to have it freed
+        }
+        return false;
+    }
+
+    boundarySample = samplesFed + filled;
+    retired.store(current.release());
+    current.reset(taken);
+    gain = nextGain.load();
+    nextGain = 1.0f;
+    return true;
+}
+
+bool PlaybackStream::onGetData(Chunk& data) {
+    if (!current || buffer.empty()) return false;
+
+    const std::int64_t seekUs = seekTarget.exchange(-1);
+    if (seekUs >= 0) {
+        current->seek(sf::microseconds(seekUs));
+        samplesFed = current->getSampleOffset();
+    }
+
+    std::uint64_t filled = current->read(buffer.data(), buffer.size());
+    chain.process(buffer.data(), std::size_t(filled / channels), gain);
+
+    // Current track ran out mid-chunk: continue straight into the next one.
+    bool spliced = false;
+    if (filled < buffer.size() && spliceNext(filled)) {
+        const std::uint64_t more = current->read(buffer.data() + filled, buffer.size() - filled);
+        chain.process(buffer.data() + filled, std::size_t(more / channels), gain);
+        filled += more;
+        pendingSwitch = true;
+        spliced = true;
+    }
+
+    samplesFed += filled;
+    data.samples = buffer.data();
+    data.sampleCount = static_cast<std::size_t>(filled);
+
+    bool more = true;
+    if (filled < buffer.size()) {
+        endTicks = std::chrono::steady_clock::now().time_since_epoch().count();
+        endOfData = true;
+        more = false; // SFML still plays the samples handed over here
+    }
+
+    if (spliced || !more) serviceRequested = true;
+    return more;
+}
+
+// May run on any thread, so only the request is recorded; the decoder moves
+// at the start of the next onGetData().
+void PlaybackStream::onSeek(sf::Time timeOffset) {
+    const std::int64_t us = std::max<std::int64_t>(0, timeOffset.asMicroseconds());
+    samplesFed = std::uint64_t(double(us) / 1e6 * samplesPerSecond) / std::max(1u, channels) * channels;
+    seekTarget = us;
+    endOfData = false;
+}
+
+// ========================= PlaybackEngine =========================
+PlaybackEngine::PlaybackEngine(QObject* parent) : QObject(parent) {
+    // Two threads: one current-track open and one preload can overlap.
+    pool.setMaxThreadCount(2);
+
+    serviceTimer.setSingleShot(true);
+    serviceTimer.setTimerType(Qt::PreciseTimer);
+    connect(&serviceTimer, &QTimer::timeout, this, &PlaybackEngine::service);
+
+    // Single-shot and precise: a coarse timer may fire 5% late, which is
+    // seconds when it is armed for the end of a long track.
+    pollTimer.setSingleShot(true);
+    pollTimer.setTimerType(Qt::PreciseTimer);
+    connect(&pollTimer, &QTimer::timeout, this, &PlaybackEngine::poll);
+}
+
+PlaybackEngine::~PlaybackEngine() {
+    stream.stop();
+    ++openGeneration;
+    ++preloadGeneration;
+    pool.clear();
+    pool.waitForDone();
+    stream.stop();
+}
+
+std::unique_ptr<TrackFile> PlaybackEngine::openFile(const QString& path, const SeekIndex& index) {
+    TRACE_SCOPE("sf::InputSoundFile::openFromFile"); // pool thread
+    auto file = std::make_unique<TrackFile>();
+    if (!file->open(path, index)) return nullptr;
+    return file;
+}
+
+void PlaybackEngine::openAsync(const QString& path) {
+    const quint64 ticket = ++openGeneration;
+    ++preloadGeneration; // a preload for the old track is no longer wanted
+
+    halt(); // the caller picked this track; a pending splice is dropped
+    clearNext();
+    opening = true;
+    serviceTimer.stop();
+
+    pool.start([this, path, ticket] {
+        if (ticket != openGeneration) return; // superseded before it started
+
+        const SeekIndex index = seekIndexSource ? seekIndexSource(path) : SeekIndex();
+        FileHolder holder = std::make_shared<std::unique_ptr<TrackFile>>(openFile(path, index));
+        if (ticket != openGeneration) return; // superseded while opening
+
+        QMetaObject::invokeMethod(this, [this, path, ticket, holder] {
+            if (ticket != openGeneration) return;
+            opening = false;
+
+            std::unique_ptr<TrackFile> file = std::move(*holder);
+            if (!file) {
+                emit openFinished(path, false);
+                return;
+            }
+
+            duration = file->getDuration();
+            nextDuration = sf::Time::Zero;
+            trackStart = sf::Time::Zero;
+            stream.setCurrent(std::move(file), trackGain);
+            emit openFinished(path, true);
+            emit statusChanged();
+        }, Qt::QueuedConnection);
+    });
+}
+
+void PlaybackEngine::preloadNextAsync(const QString& path) {
+    const quint64 ticket = ++preloadGeneration;
+    clearNext();
+
+    pool.start([this, path, ticket] {
+        if (ticket != preloadGeneration) return;
+
+        const SeekIndex index = seekIndexSource ? seekIndexSource(path) : SeekIndex();
+        FileHolder holder = std::make_shared<std::unique_ptr<TrackFile>>(openFile(path, index));
+        if (ticket != preloadGeneration || !*holder) return;
+
+        QMetaObject::invokeMethod(this, [this, ticket, holder] {
+            if (ticket != preloadGeneration || opening) return;
+            nextDuration = (*holder)->getDuration();
+            stream.setNext(std::move(*holder), nextGain);
+        }, Qt::QueuedConnection);
+    });
+}
+
+static float dbToLinear(double db) {
+    return float(std::pow(10.0, db / 20.0));
+}
+
+void PlaybackEngine::setTrackGain(double gainDb) {
+    trackGain = dbToLinear(gainDb);
+    stream.setGain(trackGain);
+}
+
+void PlaybackEngine::setNextTrackGain(double gainDb) {
+    nextGain = dbToLinear(gainDb);
+    stream.setNextGain(nextGain);
+}
+
+void PlaybackEngine::clearNext() {
+    stream.setNext(nullptr);
+    nextDuration = sf::Time::Zero;
+}
+
+void PlaybackEngine::play() {
+    stream.play();
+    armPoll();
+    service(); // re-arm boundary timers that pause() let lapse
+    emit statusChanged();
+}
+
+void PlaybackEngine::pause() {
+    stream.pause();
+    pollTimer.stop();
+    serviceTimer.stop();
+    emit statusChanged();
+}
+
+void PlaybackEngine::stop() {
+    // A splice that is buffered but not yet audible still counts as a switch.
+    if (stream.switchPending()) finishSwitch(0.0);
+    halt();
+}
+
+// Stops without announcing a pending splice: the caller is replacing the
+// track, so no advancedToNext() may reach MainWindow in between.
+void PlaybackEngine::halt() {
+    stream.stop();
+    stream.acknowledgeSwitch();
+    stream.acknowledgeEnd();
+    pollTimer.stop();
+    serviceTimer.stop();
+    trackStart = sf::Time::Zero;
+    emit statusChanged();
+}
+
+sf::Time PlaybackEngine::getPlayingOffset() const {
+    sf::Time t = stream.getPlayingOffset() - trackStart;
+    if (t < sf::Time::Zero) t = sf::Time::Zero;
+    if (t > duration) t = duration;
+    return t;
+}
+
+void PlaybackEngine::setPlayingOffset(sf::Time offset) {
+    if (stream.switchPending()) finishSwitch(0.0);
+    stream.setPlayingOffset(offset);
+    trackStart = sf::Time::Zero;
+    if (stream.getStatus() == sf::SoundSource::Status::Playing) armPoll();
+    service(); // a seek can move the end of data closer or further away
+}
+
+// GUI thread, while playing. The status is read before the flag, so a flag
+// raised just before the stream stopped is still seen.
+void PlaybackEngine::poll() {
+    const bool playing = stream.getStatus() == sf::SoundSource::Status::Playing;
+    if (stream.takeServiceRequest()) service();
+    if (playing) armPoll(); // the end of data is followed by serviceTimer
+}
+
+// Next check: one chunk before the decoder is due to run out of the current
+// file, or one chunk from now once that is close (or a splice is pending,
+// when `current` is already the next file).
+void PlaybackEngine::armPoll() {
+    const sf::Time chunk = std::max(stream.chunkDuration(), sf::milliseconds(100));
+    sf::Time wait = chunk;
+    if (!stream.switchPending() && !stream.reachedEnd()) {
+        const sf::Time untilDry = duration - (stream.fedUpTo() - trackStart);
+        wait = std::max(chunk, untilDry - chunk);
+    }
+    pollTimer.start(int(wait.asMilliseconds()));
+}
+
+// Runs when the stream reports a splice or end of data, and again from
+// serviceTimer when that moment is due to become audible.
+void PlaybackEngine::service() {
+    serviceTimer.stop();
+    const auto status = stream.getStatus();
+
+    // Spliced switch: the next track is audible once the clock passes the boundary.
+    if (stream.switchPending()) {
+        const sf::Time left = stream.boundary() - stream.getPlayingOffset();
+        if (left <= sf::Time::Zero) finishSwitch(0.0);
+        else if (status == sf::SoundSource::Status::Playing) scheduleService(left);
+    }
+
+    if (stream.reachedEnd()) {
+        if (status == sf::SoundSource::Status::Playing) {
+            // Buffered audio is still draining; look again when it should be done.
+            scheduleService(stream.fedUpTo() - stream.getPlayingOffset());
+        } else if (status == sf::SoundSource::Status::Stopped) {
+            stream.acknowledgeEnd();
+
+            if (stream.hasNext()) {
+                // Formats differed, so the stream ran dry; restart it on the next file.
+                const auto endedAt = stream.endTime();
+                trackGain = nextGain;
+                stream.setCurrent(stream.takeNext(), trackGain);
+                stream.play();
+                armPoll();
+
+                trackStart = sf::Time::Zero;
+                duration = nextDuration;
+                nextDuration = sf::Time::Zero;
+                gapMs = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - endedAt).count();
+                emit advancedToNext();
+                emit statusChanged();
+            } else {
+                emit statusChanged();
+                emit trackFinished();
+            }
+        }
+    }
+
+    stream.releaseRetired();
+}
+
+void PlaybackEngine::scheduleService(sf::Time delay) {
+    // Small floor so a drain that SFML has not flagged yet is re-checked soon.
+    const int ms = std::max(5, int(delay.asMilliseconds()) + 1);
+    serviceTimer.start(ms);
+}
+
+void PlaybackEngine::finishSwitch(double measuredGapMs) {
+    trackGain = nextGain; // the stream switched gains at the splice
+    trackStart = stream.boundary();
+    stream.acknowledgeSwitch();
+    duration = nextDuration;
+    nextDuration = sf::Time::Zero;
+    gapMs = measuredGapMs;
+    emit advancedToNext();
+}
@@ -0,0 +1,227 @@
+/*
+ * Author: Itoro Ifon, jason Hippolite, Prince Umeh
+ * Date: 2026-10-16
+ * Course/Assignment: C++ Project - Qt Music Player
+ * File: playbackengine.h
+ * Purpose: Declares the gapless playback engine: a custom SFML sound stream
+ *          that splices a pre-opened next track in at end-of-stream.
+ */
+#pragma once
+
+#include <QObject>
+#include <QString>
+#include <QThreadPool>
+#include <QTimer>
+
+#include <SFML/Audio.hpp>
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <vector>
+
+#include "dspchain.h"
+#include "seekindex.h"
+
+// Struct: TrackSource
+// Purpose: The byte stream a TrackFile decodes from, when it is not simply
+//          the file on disk.
+struct TrackSource {
+    std::unique_ptr<sf::InputStream> source;
+};
+
+// Class: TrackFile
+// Purpose: An open decoder. Long FLAC files with a SeekIndex are read
+//          through a view of the file that carries the index as a
+//          SEEKTABLE, so seeks jump straight to the neighbouring frame
+//          instead of bisecting the whole stream.
+// Notes: TrackSource is the first base: built before the decoder that
+//        reads from it and destroyed after it.
+class TrackFile : private TrackSource, public sf::InputSoundFile {
+public:
+    bool open(const QString& path, const SeekIndex& index = SeekIndex());
+};
+
+// Class: PlaybackStream
+// Purpose: sf::SoundStream that decodes the current file and, when it runs
+//          out, keeps filling the same buffer from the pre-opened next file.
+//          When both share sample rate and channel count the switch happens
+//          inside one chunk, so no silence is inserted between tracks.
+//          Every chunk goes through the DSP chain (gain, EQ, limiter).
+// Notes: onGetData()/onSeek() run on SFML's audio thread and take no locks.
+//        While the stream plays, the audio thread owns `current`; files are
+//        handed over through atomic pointer slots, and whoever exchanges a
+//        file out of a slot owns it. Files are only ever closed on the GUI
+//        thread. The audio thread never posts events: it raises a flag once
+//        per splice, once when data runs out and once when it retires a
+//        file, and the GUI thread polls it with takeServiceRequest().
+class PlaybackStream : public sf::SoundStream {
+public:
+    ~PlaybackStream() override;
+
+    // True once after the audio thread asked for service().
+    bool takeServiceRequest() { return serviceRequested.exchange(false); }
+
+    // Replaces the current file and re-initializes the stream format.
+    // `gain` is linear and applies to that file's samples only.
+    void setCurrent(std::unique_ptr<TrackFile> file, float gain = 1.0f);
+    void setNext(std::unique_ptr<TrackFile> file, float gain = 1.0f);
+    void setGain(float g) { gain = g; }
+    void setNextGain(float g) { nextGain = g; }
+    std::unique_ptr<TrackFile> takeNext();
+    bool hasNext() const { return next.load() != nullptr; }
+
+    // Set once the audio thread has spliced `next` in. The new track becomes
+    // audible at boundary() on the stream clock.
+    bool switchPending() const { return pendingSwitch; }
+    sf::Time boundary() const;
+    void acknowledgeSwitch();
+
+    // Set when the decoder ran dry with nothing to splice in.
+    bool reachedEnd() const { return endOfData; }
+    void acknowledgeEnd() { endOfData = false; }
+    std::chrono::steady_clock::time_point endTime() const;
+
+    // Stream-clock time of the last sample handed to SFML.
+    sf::Time fedUpTo() const;
+    // Audio handed over per onGetData() call (~100 ms).
+    sf::Time chunkDuration() const;
+
+    // Frees the file retired by the last switch (never done on the audio thread).
+    void releaseRetired();
+
+    DspChain& dsp() { return chain; }
+
+protected:
+    bool onGetData(Chunk& data) override;
+    void onSeek(sf::Time timeOffset) override;
+
+private:
+    static bool sameFormat(const sf::InputSoundFile& a, const sf::InputSoundFile& b);
+    bool spliceNext(std::uint64_t filled);
+
+    DspChain chain;
+
+    // Audio thread while playing; GUI thread only while stopped.
+    std::unique_ptr<TrackFile> current;
+    std::vector<std::int16_t> buffer;
+    unsigned channels = 0;
+
+    double samplesPerSecond = 0.0;            // GUI thread, format of `current`
+
+    std::atomic<TrackFile*> next{nullptr};
+    std::atomic<std::uint64_t> nextFormat{0}; // rate and channels of `next`, checked before taking it
+    std::atomic<TrackFile*> retired{nullptr}; // set by the audio thread only while empty
+    std::atomic<float> gain{1.0f};
+    std::atomic<float> nextGain{1.0f};
+
+    std::atomic<std::int64_t> seekTarget{-1};  // microseconds; applied by the next onGetData()
+    std::atomic<std::uint64_t> samplesFed{0};  // stream clock, in interleaved samples
+    std::atomic<std::uint64_t> boundarySample{0};
+    std::atomic<bool> pendingSwitch{false};
+    std::atomic<bool> endOfData{false};
+    std::atomic<bool> serviceRequested{false};
+    std::atomic<std::int64_t> endTicks{0};     // steady_clock ticks when data ran out
+};
+
+// Class: PlaybackEngine
+// Purpose: Owns the stream and exposes the sf::Music-like calls MainWindow
+//          uses, plus next-track preloading. Track positions and durations
+//          are relative to the audible track, even after a gapless switch.
+// Notes: The stream flags a splice or running dry, which can only happen
+//        when the decoder reaches the end of the current file. pollTimer is
+//        armed for that moment (from fedUpTo() and the duration), then
+//        checks once per chunk until the GUI thread sees the flag: one
+//        wakeup per track plus a few at its end. The engine then arms
+//        serviceTimer for the moment the change becomes audible, and emits
+//        advancedToNext() or trackFinished(). Nothing runs while paused or
+//        stopped.
+//        Files are opened on a small worker pool. Each request supersedes
+//        the previous one: stale opens are skipped if they have not started
+//        and discarded when they finish.
+class PlaybackEngine : public QObject {
+    Q_OBJECT
+
+public:
+    explicit PlaybackEngine(QObject* parent = nullptr);
+    ~PlaybackEngine() override;
+
+    // Stops the current track and opens `path` in the background;
+    // openFinished() reports the outcome of the latest request only.
+    void openAsync(const QString& path);
+    bool isOpening() const { return opening; }
+    // A spliced next track is buffered but not audible yet. The audible
+    // track's decoder is gone by then, so seeking in it means reopening it.
+    bool switchPending() const { return stream.switchPending(); }
+
+    void preloadNextAsync(const QString& path);
+    void clearNext();
+    bool hasNext() { return stream.hasNext(); }
+
+    void play();
+    void pause();
+    void stop();
+    sf::SoundSource::Status getStatus() const { return stream.getStatus(); }
+
+    sf::Time getDuration() const { return duration; }
+    sf::Time getPlayingOffset() const;
+    void setPlayingOffset(sf::Time offset);
+    void setVolume(float volume) { stream.setVolume(volume); }
+
+    // Normalization gain in dB for the current and the preloaded track. The
+    // preloaded track's gain follows it through a gapless switch.
+    void setTrackGain(double gainDb);
+    void setNextTrackGain(double gainDb);
+
+    // Silence between the last two tracks: 0 for a spliced switch; when the
+    // formats differed, the wall-clock time from the decoder running dry to
+    // the restart (an upper bound, since buffered audio was still playing).
+    double lastGapMs() const { return gapMs; }
+
+    // Preamp, EQ and limiter settings apply from the next audio block.
+    void setDspParams(const DspParams& p) { stream.dsp().setParams(p); }
+    const DspParams& dspParams() { return stream.dsp().params(); }
+    DspStats dspStats() { return stream.dsp().stats(); }
+    void resetDspStats() { stream.dsp().resetStats(); }
+
+    // Where the engine gets seek indexes for the files it opens. Called on
+    // the open pool; set it before the first open.
+    void setSeekIndexSource(std::function<SeekIndex(const QString&)> source) { seekIndexSource = std::move(source); }
+
+    static std::unique_ptr<TrackFile> openFile(const QString& path, const SeekIndex& index = SeekIndex());
+
+signals:
+    void advancedToNext();
+    void trackFinished();   // played to the end with nothing to follow
+    void statusChanged();   // play / pause / stop / track change
+    void openFinished(const QString& path, bool ok);
+
+private:
+    using FileHolder = std::shared_ptr<std::unique_ptr<TrackFile>>;
+
+    void halt();
+    void poll();
+    void armPoll();
+    void service();
+    void scheduleService(sf::Time delay);
+    void finishSwitch(double measuredGapMs);
+
+    QTimer pollTimer;
+    QTimer serviceTimer;
+
+    QThreadPool pool;
+    std::function<SeekIndex(const QString&)> seekIndexSource;
+    std::atomic<quint64> openGeneration{0};
+    std::atomic<quint64> preloadGeneration{0};
+    bool opening = false;
+
+    PlaybackStream stream;
+    sf::Time duration;
+    sf::Time nextDuration;
+    sf::Time trackStart;   // stream-clock time at which the audible track began
+    double gapMs = 0.0;
+    float trackGain = 1.0f; // linear
+    float nextGain = 1.0f;
+};
@@ -0,0 +1,106 @@
+/*
+ * Author: Itoro Ifon, jason Hippolite, Prince Umeh
+ * Date: 2026-10-16
+ * Course/Assignment: C++ Project - Qt Music Player
+ * File: playqueue.cpp
+ * Purpose: Implements PlayQueue.
+ */
+#include "playqueue.h"
+
+#include <algorithm>
+
+// ========================= Queue =========================
+void PlayQueue::playNext(TrackId id) {
+    if (present(id)) upNext.push_front(id);
+}
+
+void PlayQueue::enqueue(TrackId id) {
+    if (present(id)) upNext.push_back(id);
+}
+
+void PlayQueue::forget(TrackId id) {
+    upNext.erase(std::remove(upNext.begin(), upNext.end(), id), upNext.end());
+    shuffled.forget(id);
+    // Step the anchor back so order resumes with the track after this one.
+    if (id == anchor) anchor = preceding(id);
+}
+
+void PlayQueue::clear() {
+    upNext.clear();
+    history.clear();
+    anchor = kNoTrack;
+    shuffled.clear();
+}
+
+void PlayQueue::setShuffle(bool on) {
+    if (on && !shuffle) {
+        shuffled.restart();
+        if (present(anchor)) shuffled.take(anchor); // usually the current track
+    }
+    shuffle = on;
+}
+
+// ========================= Library order =========================
+// kNoTrack (nothing played yet) is followed by the first row.
+TrackId PlayQueue::following(TrackId from) const {
+    if (tracks.isEmpty()) return kNoTrack;
+    if (shuffle) return shuffled.peek(mode != Repeat::Off);
+    const int row = from == kNoTrack ? -1 : tracks.rowOf(from);
+    if (from != kNoTrack && row < 0) return kNoTrack;
+    if (row + 1 < tracks.size()) return tracks.idAt(row + 1);
+    return mode == Repeat::Off ? kNoTrack : tracks.idAt(0);
+}
+
+TrackId PlayQueue::preceding(TrackId from) const {
+    if (shuffle) return kNoTrack;
+    const int row = tracks.rowOf(from);
+    if (row > 0) return tracks.idAt(row - 1);
+    if (row == 0 && mode != Repeat::Off) return tracks.idAt(tracks.size() - 1);
+    return kNoTrack;
+}
+
+// ========================= Stepping =========================
+TrackId PlayQueue::peek(TrackId current, Step step) const {
+    if (step == Step::Auto && mode == Repeat::One && present(current)) return current;
+    for (TrackId id : upNext)
+        if (present(id)) return id;
+    return following(present(anchor) ? anchor : current);
+}
+
+TrackId PlayQueue::advance(TrackId current, Step step) {
+    while (!upNext.empty() && !present(upNext.front())) upNext.pop_front();
+    const TrackId to = peek(current, step);
+    if (to != kNoTrack && to != current) played(current, to);
+    return to;
+}
+
+TrackId PlayQueue::back(TrackId current) {
+    while (!history.empty()) {
+        const TrackId id = history.back();
+        history.pop_back();
+        if (present(id) && id != current) {
+            anchor = id;
+            return id;
+        }
+    }
+    const TrackId to = preceding(present(current) ? current : anchor);
+    if (to != kNoTrack) anchor = to;
+    return to;
+}
+
+void PlayQueue::played(TrackId from, TrackId to) {
+    if (from == to || to == kNoTrack) return;
+    remember(from);
+    if (shuffle) shuffled.take(to);
+    if (!upNext.empty() && upNext.front() == to) {
+        upNext.pop_front(); // from the queue: the anchor stays put
+    } else {
+        anchor = to;
+    }
+}
+
+void PlayQueue::remember(TrackId id) {
+    if (id == kNoTrack) return;
+    history.push_back(id);
+    if (int(history.size()) > kHistoryLimit) history.pop_front();
+}
@@ -0,0 +1,87 @@
+/*
+ * Author: Itoro Ifon, jason Hippolite, Prince Umeh
+ * Date: 2026-10-16
+ * Course/Assignment: C++ Project - Qt Music Player
+ * File: playqueue.h
+ * Purpose: Declares PlayQueue, the play-order layer between the library and
+ *          the player: an up-next queue, history, repeat and shuffle, all
+ *          kept as track IDs.
+ */
+#pragma once
+
+#include <deque>
+
+#include "shuffleorder.h"
+#include "trackstore.h"
+
+// Class: PlayQueue
+// Purpose: Decides which track plays after (or before) the current one
+//          without reordering the library. Tracks the user queued play
+//          first, in order; after that playback continues through the
+//          library from the last track it took from there (the anchor), so
+//          a queued detour resumes where it left off. With shuffle on, the
+//          library part comes from a ShuffleOrder instead.
+// Notes: Everything is held as TrackIds, so the queue stays valid while the
+//        library is filtered, sorted or reordered; "the following track" is
+//        looked up through TrackStore::rowOf() when it is needed. Each call
+//        is O(1) (amortized over the store's row index rebuilds), except
+//        forget(), which scans the queue. IDs of removed tracks left in the
+//        history are skipped when reached. History keeps the last
+//        kHistoryLimit tracks, so back() retraces shuffled picks too; with
+//        shuffle on and the history used up, there is no previous track.
+class PlayQueue {
+public:
+    enum class Repeat { Off, All, One };
+    enum class Step {
+        Auto, // the current track ended
+        Skip  // the user pressed next; repeat-one does not hold it back
+    };
+
+    explicit PlayQueue(const TrackStore& store) : tracks(store), shuffled(store) {}
+
+    Repeat repeat() const { return mode; }
+    void setRepeat(Repeat r) { mode = r; }
+
+    bool shuffling() const { return shuffle; }
+    void setShuffle(bool on); // turning it on starts a new pass
+    ShuffleOrder::Mode shuffleMode() const { return shuffled.mode(); }
+    void setShuffleMode(ShuffleOrder::Mode m) { shuffled.setMode(m); }
+
+    void playNext(TrackId id); // ahead of everything already queued
+    void enqueue(TrackId id);  // after everything already queued
+    void clearQueue() { upNext.clear(); }
+    const std::deque<TrackId>& queued() const { return upNext; }
+
+    // The track advance() would return, without changing any state. For
+    // preloading the gapless successor.
+    TrackId peek(TrackId current, Step step) const;
+    // Moves on from `current`; kNoTrack at the end of the library with
+    // repeat off.
+    TrackId advance(TrackId current, Step step);
+    // The track played before `current`, or the previous one in the library
+    // once the history runs out.
+    TrackId back(TrackId current);
+    // Records that `to` started after `from`, however it was picked (a
+    // double-click, the engine's gapless splice).
+    void played(TrackId from, TrackId to);
+
+    // Call before the track leaves the store.
+    void forget(TrackId id);
+    void clear();
+
+    static constexpr int kHistoryLimit = 500;
+
+private:
+    bool present(TrackId id) const { return id != kNoTrack && tracks.rowOf(id) >= 0; }
+    TrackId following(TrackId from) const;
+    TrackId preceding(TrackId from) const;
+    void remember(TrackId id);
+
+    const TrackStore& tracks;
+    mutable ShuffleOrder shuffled; // peek() draws the next pick ahead and holds it
+    bool shuffle = false;
+    std::deque<TrackId> upNext;
+    std::deque<TrackId> history; // oldest first
+    TrackId anchor = kNoTrack;   // last track played from library order
+    Repeat mode = Repeat::Off;
+};
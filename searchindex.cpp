@@ -0,0 +1,136 @@
+/*
+ * Author: Itoro Ifon, jason Hippolite, Prince Umeh
+ * Date: 2026-10-16
+ * Course/Assignment: C++ Project - Qt Music Player
+ * File: searchindex.cpp
+ * Purpose: Implements trigram extraction and posting-list intersection.
+ */
+#include "searchindex.h"
+
+#include <algorithm>
+#include <iterator>
+
+// ========================= Trigrams =========================
+QString SearchIndex::normalize(const QString& s) {
+    return s.toCaseFolded();
+}
+
+static void appendGrams(const QString& folded, SearchIndex::Gram tag, QVector<SearchIndex::Gram>& out) {
+    const int n = folded.size();
+    const QChar* c = folded.constData();
+    for (int i = 0; i + SearchIndex::kGramLength <= n; ++i) {
+        out << (tag
+                | (SearchIndex::Gram(c[i].unicode()) << 32)
+                | (SearchIndex::Gram(c[i + 1].unicode()) << 16)
+                | SearchIndex::Gram(c[i + 2].unicode()));
+    }
+}
+
+// Every character and every adjacent pair. A pair's first unit is never 0,
+// so pairs and single characters cannot collide.
+static void appendShortGrams(const QString& folded, SearchIndex::Gram tag, QVector<SearchIndex::Gram>& out) {
+    const int n = folded.size();
+    const QChar* c = folded.constData();
+    for (int i = 0; i < n; ++i) {
+        out << (tag | SearchIndex::Gram(c[i].unicode()));
+        if (i + 1 < n) out << (tag | (SearchIndex::Gram(c[i].unicode()) << 16) | SearchIndex::Gram(c[i + 1].unicode()));
+    }
+}
+
+QVector<SearchIndex::Gram> SearchIndex::extractGrams(const QString& title, const QString& artist,
+                                                     const QString& lyrics) {
+    QVector<Gram> grams;
+    grams.reserve(3 * (title.size() + artist.size()) + lyrics.size());
+
+    // Fields are indexed separately so no gram spans two of them.
+    const QString names[] = {normalize(title), normalize(artist)};
+    for (const QString& name : names) {
+        appendGrams(name, 0, grams);
+        appendShortGrams(name, kShortGram, grams);
+    }
+    appendGrams(normalize(lyrics), kLyricsGram, grams);
+
+    std::sort(grams.begin(), grams.end());
+    grams.erase(std::unique(grams.begin(), grams.end()), grams.end());
+    grams.squeeze();
+    return grams;
+}
+
+QVector<SearchIndex::Gram> SearchIndex::gramsOfQuery(const QString& normalizedQuery, bool lyrics) {
+    QVector<Gram> grams;
+    if (normalizedQuery.size() >= kGramLength) {
+        appendGrams(normalizedQuery, lyrics ? kLyricsGram : 0, grams);
+    } else if (!lyrics && !normalizedQuery.isEmpty()) {
+        // The whole query is one short gram.
+        const QChar* c = normalizedQuery.constData();
+        grams << (normalizedQuery.size() == 1
+                      ? kShortGram | Gram(c[0].unicode())
+                      : kShortGram | (Gram(c[0].unicode()) << 16) | Gram(c[1].unicode()));
+    }
+    std::sort(grams.begin(), grams.end());
+    grams.erase(std::unique(grams.begin(), grams.end()), grams.end());
+    return grams;
+}
+
+// ========================= Updates =========================
+void SearchIndex::add(TrackId id, const QVector<Gram>& grams) {
+    if (id >= alive.size()) alive.resize(id + 1, false);
+    alive[id] = true;
+
+    for (Gram g : grams) postings[g].append(id);
+}
+
+void SearchIndex::remove(TrackId id) {
+    if (id < alive.size()) alive[id] = false;
+}
+
+void SearchIndex::clear() {
+    postings.clear();
+    alive.clear();
+}
+
+// ========================= Query =========================
+QVector<TrackId> SearchIndex::candidates(const QString& normalizedQuery) const {
+    return intersect(gramsOfQuery(normalizedQuery));
+}
+
+QVector<TrackId> SearchIndex::lyricsCandidates(const QString& normalizedQuery) const {
+    return intersect(gramsOfQuery(normalizedQuery, true));
+}
+
+QVector<TrackId> SearchIndex::intersect(const QVector<Gram>& grams) const {
+    if (grams.isEmpty()) return {};
+
+    // Intersect from the rarest trigram up so the working set shrinks fast.
+    QVector<const QVector<TrackId>*> lists;
+    lists.reserve(grams.size());
+    for (Gram g : grams) {
+        auto it = postings.constFind(g);
+        if (it == postings.constEnd()) return {};
+        lists << &it.value();
+    }
+    std::sort(lists.begin(), lists.end(), [](const QVector<TrackId>* a, const QVector<TrackId>* b) {
+        return a->size() < b->size();
+    });
+
+    QVector<TrackId> result;
+    result.reserve(lists.first()->size());
+    for (TrackId id : *lists.first())
+        if (isAlive(id)) result << id;
+
+    QVector<TrackId> next;
+    for (int i = 1; i < lists.size() && !result.isEmpty(); ++i) {
+        next.clear();
+        std::set_intersection(result.cbegin(), result.cend(), lists[i]->cbegin(), lists[i]->cend(),
+                              std::back_inserter(next));
+        result.swap(next);
+    }
+    return result;
+}
+
+qint64 SearchIndex::memoryUsage() const {
+    qint64 bytes = qint64(alive.capacity() / 8);
+    for (auto it = postings.cbegin(); it != postings.cend(); ++it)
+        bytes += qint64(sizeof(Gram) + sizeof(QVector<TrackId>)) + it.value().capacity() * qint64(sizeof(TrackId));
+    return bytes;
+}
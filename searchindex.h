@@ -0,0 +1,65 @@
+/*
+ * Author: Itoro Ifon, jason Hippolite, Prince Umeh
+ * Date: 2026-10-16
+ * Course/Assignment: C++ Project - Qt Music Player
+ * File: searchindex.h
+ * Purpose: Declares SearchIndex, a trigram inverted index over title, artist
+ *          and lyrics used to answer search-box queries without scanning
+ *          every row.
+ */
+#pragma once
+
+#include <QString>
+#include <QVector>
+#include <QHash>
+
+#include <vector>
+
+#include "trackstore.h"
+
+// Class: SearchIndex
+// Purpose: Maps each case-folded character trigram to the sorted list of
+//          tracks containing it. A query resolves to the intersection of its
+//          trigrams' posting lists; callers verify the (few) candidates.
+// Notes: Track IDs only grow, so appending keeps posting lists sorted.
+//        Removed tracks are tombstoned and skipped until the next clear().
+//        Lyrics trigrams are tagged apart from title and artist ones, so a
+//        query finds name matches and lyrics matches separately and only the
+//        latter need their lyrics unpacked. Title and artist also index
+//        their one- and two-character grams, for queries too short for a
+//        trigram; those queries do not search lyrics.
+class SearchIndex {
+public:
+    using Gram = quint64;
+
+    // Thread-safe helpers, used by scan workers.
+    static QString normalize(const QString& s);
+    static QVector<Gram> extractGrams(const QString& title, const QString& artist, const QString& lyrics);
+    static QVector<Gram> gramsOfQuery(const QString& normalizedQuery, bool lyrics = false);
+
+    void add(TrackId id, const QVector<Gram>& grams);
+    void remove(TrackId id);
+    void clear();
+
+    // Shortest query that also searches lyrics.
+    static constexpr int kGramLength = 3;
+
+    // Live tracks whose title or artist contains every gram of the query.
+    QVector<TrackId> candidates(const QString& normalizedQuery) const;
+    // ... and whose lyrics contain every trigram; empty for short queries.
+    QVector<TrackId> lyricsCandidates(const QString& normalizedQuery) const;
+
+    int gramCount() const { return postings.size(); }
+    qint64 memoryUsage() const;
+
+private:
+    bool isAlive(TrackId id) const { return id < alive.size() && alive[id]; }
+    QVector<TrackId> intersect(const QVector<Gram>& grams) const;
+
+    // A gram is up to three UTF-16 units in the low 48 bits, plus a tag.
+    static constexpr Gram kLyricsGram = Gram(1) << 63;
+    static constexpr Gram kShortGram = Gram(1) << 62; // one or two units
+
+    QHash<Gram, QVector<TrackId>> postings;
+    std::vector<bool> alive; // indexed by TrackId
+};
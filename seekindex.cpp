@@ -0,0 +1,315 @@
+/*
+ * Author: Itoro Ifon, jason Hippolite, Prince Umeh
+ * Date: 2026-10-16
+ * Course/Assignment: C++ Project - Qt Music Player
+ * File: seekindex.cpp
+ * Purpose: Implements FLAC frame sampling, the compact encoding and the
+ *          SEEKTABLE rewrite behind SeekIndex.
+ */
+#include "seekindex.h"
+
+#include <QFile>
+
+#include <algorithm>
+#include <cstring>
+
+namespace {
+
+quint32 be16(const uchar* b) { return quint32(b[0]) << 8 | quint32(b[1]); }
+quint32 be24(const uchar* b) { return quint32(b[0]) << 16 | be16(b + 1); }
+quint32 be32(const uchar* b) { return quint32(b[0]) << 24 | be24(b + 1); }
+quint32 synchsafe32(const uchar* b) {
+    return quint32(b[0] & 0x7f) << 21 | quint32(b[1] & 0x7f) << 14 | quint32(b[2] & 0x7f) << 7 | quint32(b[3] & 0x7f);
+}
+
+void putBe(QByteArray& out, quint64 v, int bytes) {
+    for (int i = bytes - 1; i >= 0; --i) out.append(char((v >> (8 * i)) & 0xff));
+}
+
+constexpr quint8 kEncodingVersion = 1;
+constexpr int kStreamInfo = 0;
+constexpr int kSeekTable = 3;
+constexpr int kPicture = 6;
+constexpr int kSeekPointBytes = 18;
+constexpr qint64 kMinWindow = 64 * 1024;
+constexpr qint64 kMaxWindow = 256 * 1024;
+constexpr qint64 kMaxHeaderBytes = 16;
+
+// ========================= Varints =========================
+void putVarint(QByteArray& out, quint64 v) {
+    while (v >= 0x80) {
+        out.append(char(v | 0x80));
+        v >>= 7;
+    }
+    out.append(char(v));
+}
+
+bool getVarint(const uchar*& p, const uchar* end, quint64& v) {
+    v = 0;
+    for (int shift = 0; p < end && shift < 64; shift += 7) {
+        const uchar b = *p++;
+        v |= quint64(b & 0x7f) << shift;
+        if (!(b & 0x80)) return true;
+    }
+    return false;
+}
+
+// ========================= FLAC layout =========================
+struct StreamInfo {
+    quint32 minBlock = 0;
+    quint32 maxBlock = 0;
+    quint32 maxFrame = 0;
+    quint32 rate = 0;
+    quint64 totalSamples = 0;
+};
+
+// Walks the metadata blocks. magic is where "fLaC" starts, audio where
+// the first frame does; existingPoints counts real SEEKTABLE entries.
+bool readLayout(QFile& f, StreamInfo& si, qint64& magic, qint64& audio, int& existingPoints) {
+    uchar h[10];
+    magic = 0;
+    if (f.read(reinterpret_cast<char*>(h), 10) == 10 && std::memcmp(h, "ID3", 3) == 0)
+        magic = 10 + qint64(synchsafe32(h + 6)) + ((h[5] & 0x10) ? 10 : 0);
+    if (!f.seek(magic) || f.read(reinterpret_cast<char*>(h), 4) != 4 || std::memcmp(h, "fLaC", 4) != 0) return false;
+
+    bool haveInfo = false;
+    existingPoints = 0;
+    qint64 pos = magic + 4;
+    for (;;) {
+        if (!f.seek(pos) || f.read(reinterpret_cast<char*>(h), 4) != 4) return false;
+        const int type = h[0] & 0x7f;
+        const qint64 len = be24(h + 1);
+        if (type == kStreamInfo && len >= 34) {
+            uchar b[34];
+            if (f.read(reinterpret_cast<char*>(b), 34) != 34) return false;
+            si.minBlock = be16(b);
+            si.maxBlock = be16(b + 2);
+            si.maxFrame = be24(b + 7);
+            si.rate = be24(b + 10) >> 4;
+            si.totalSamples = (quint64(b[13] & 0x0f) << 32) | be32(b + 14);
+            haveInfo = true;
+        } else if (type == kSeekTable) {
+            const QByteArray table = f.read(len);
+            for (qint64 i = 0; i + kSeekPointBytes <= table.size(); i += kSeekPointBytes)
+                if (quint64(be32(reinterpret_cast<const uchar*>(table.constData()) + i)) != 0xffffffffu)
+                    ++existingPoints;
+        }
+        pos += 4 + len;
+        if (h[0] & 0x80) break;
+    }
+    audio = pos;
+    return haveInfo && si.rate > 0 && audio < f.size();
+}
+
+quint8 crc8(const uchar* p, qint64 n) {
+    quint8 crc = 0;
+    for (qint64 i = 0; i < n; ++i) {
+        crc ^= p[i];
+        for (int bit = 0; bit < 8; ++bit) crc = quint8((crc & 0x80) ? (crc << 1) ^ 0x07 : crc << 1);
+    }
+    return crc;
+}
+
+// Parses and CRC-checks a frame header at p. On success sets the frame's
+// first sample and its sample count.
+bool parseFrameHeader(const uchar* p, qint64 avail, const StreamInfo& si, quint64& sample, quint32& blockSize) {
+    if (avail < kMaxHeaderBytes || p[0] != 0xff || (p[1] & 0xfe) != 0xf8) return false;
+    const bool variable = p[1] & 1;
+    const int bsCode = p[2] >> 4;
+    const int srCode = p[2] & 0x0f;
+    const int chCode = p[3] >> 4;
+    const int ssCode = (p[3] >> 1) & 7;
+    if (bsCode == 0 || srCode == 15 || chCode > 10 || ssCode == 3 || (p[3] & 1)) return false;
+
+    // UTF-8 style coded frame (fixed blocking) or sample (variable) number.
+    int extra = 0;
+    quint64 number = p[4];
+    if (p[4] >= 0x80) {
+        if ((p[4] & 0xc0) == 0x80 || p[4] == 0xff) return false;
+        int lead = 0;
+        while (p[4] & (0x80 >> lead)) ++lead;
+        extra = lead - 1;
+        number = p[4] & (0x7f >> lead);
+    }
+    qint64 pos = 5;
+    for (int i = 0; i < extra; ++i, ++pos) {
+        if ((p[pos] & 0xc0) != 0x80) return false;
+        number = number << 6 | (p[pos] & 0x3f);
+    }
+
+    if (bsCode == 1) blockSize = 192;
+    else if (bsCode <= 5) blockSize = 576u << (bsCode - 2);
+    else if (bsCode == 6) blockSize = quint32(p[pos++]) + 1;
+    else if (bsCode == 7) { blockSize = be16(p + pos) + 1; pos += 2; }
+    else blockSize = 256u << (bsCode - 8);
+
+    if (srCode == 12) pos += 1;
+    else if (srCode == 13 || srCode == 14) pos += 2;
+    if (crc8(p, pos) != p[pos]) return false;
+
+    sample = variable ? number : number * si.maxBlock;
+    return si.totalSamples == 0 || sample < si.totalSamples;
+}
+
+// A header only counts if the next frame's header follows it in the window
+// and continues the sample count; an 8-bit CRC alone lets through one in
+// 256 stray sync codes.
+bool frameAt(const uchar* p, qint64 n, qint64 i, const StreamInfo& si, quint64& sample, quint32& blockSize) {
+    if (!parseFrameHeader(p + i, n - i, si, sample, blockSize)) return false;
+    for (qint64 j = i + 6; j + 1 < n; ++j) {
+        if (p[j] != 0xff) continue;
+        quint64 nextSample = 0;
+        quint32 nextBlock = 0;
+        if (parseFrameHeader(p + j, n - j, si, nextSample, nextBlock) && nextSample == sample + blockSize) return true;
+    }
+    return false;
+}
+
+} // namespace
+
+// ========================= Lookup =========================
+const SeekPoint* SeekIndex::floor(quint64 sample) const {
+    if (points.isEmpty()) return nullptr;
+    auto it = std::upper_bound(points.cbegin(), points.cend(), sample,
+                               [](quint64 s, const SeekPoint& p) { return s < p.sample; });
+    return it == points.cbegin() ? &points.first() : &*(it - 1);
+}
+
+// ========================= Encoding =========================
+// version, rate, magic, audio start, count, then per point the sample and
+// offset deltas and the frame length, all varints.
+QByteArray SeekIndex::encode() const {
+    QByteArray out;
+    if (points.isEmpty()) return out;
+    out.reserve(16 + points.size() * 6);
+    out.append(char(kEncodingVersion));
+    putVarint(out, rate);
+    putVarint(out, quint64(magicStart));
+    putVarint(out, quint64(audioStart));
+    putVarint(out, quint64(points.size()));
+    quint64 lastSample = 0, lastOffset = 0;
+    for (const SeekPoint& p : points) {
+        putVarint(out, p.sample - lastSample);
+        putVarint(out, p.offset - lastOffset);
+        putVarint(out, p.frameSamples);
+        lastSample = p.sample;
+        lastOffset = p.offset;
+    }
+    return out;
+}
+
+SeekIndex SeekIndex::decode(const QByteArray& bytes) {
+    SeekIndex index;
+    if (bytes.isEmpty() || quint8(bytes[0]) != kEncodingVersion) return index;
+    const uchar* p = reinterpret_cast<const uchar*>(bytes.constData()) + 1;
+    const uchar* end = p + bytes.size() - 1;
+    quint64 rate = 0, magic = 0, audio = 0, count = 0;
+    if (!getVarint(p, end, rate) || !getVarint(p, end, magic) || !getVarint(p, end, audio) || !getVarint(p, end, count))
+        return index;
+    if (count > quint64(kMaxPoints)) return index;
+
+    QVector<SeekPoint> points;
+    points.reserve(int(count));
+    quint64 sample = 0, offset = 0;
+    for (quint64 i = 0; i < count; ++i) {
+        quint64 ds = 0, dofs = 0, frame = 0;
+        if (!getVarint(p, end, ds) || !getVarint(p, end, dofs) || !getVarint(p, end, frame)) return index;
+        sample += ds;
+        offset += dofs;
+        points.append({sample, offset, quint16(frame)});
+    }
+    index.points = std::move(points);
+    index.rate = quint32(rate);
+    index.magicStart = qint64(magic);
+    index.audioStart = qint64(audio);
+    return index;
+}
+
+// ========================= Building =========================
+SeekIndex SeekIndex::build(const QString& path) {
+    SeekIndex index;
+    QFile f(path);
+    if (!f.open(QIODevice::ReadOnly)) return index;
+
+    StreamInfo si;
+    qint64 magic = 0, audio = 0;
+    int existing = 0;
+    if (!readLayout(f, si, magic, audio, existing)) return index;
+
+    const double seconds = double(si.totalSamples) / si.rate;
+    if (seconds * 1000.0 < kMinDurationMs) return index;
+    // A table the encoder wrote at least every 10 s is good enough already.
+    if (existing > 0 && seconds / existing <= 10.0) return index;
+
+    const int count = std::clamp(int(seconds / kSpacingSeconds), 1, kMaxPoints);
+    const qint64 audioBytes = f.size() - audio;
+    const qint64 window = std::clamp(qint64(si.maxFrame) * 2 + 32, kMinWindow, kMaxWindow);
+
+    QVector<SeekPoint> points;
+    points.reserve(count);
+    QByteArray buf;
+    for (int k = 0; k < count; ++k) {
+        const qint64 guess = audio + audioBytes * k / count;
+        if (!points.isEmpty() && quint64(guess - audio) <= points.last().offset) continue;
+        if (!f.seek(guess)) break;
+        buf = f.read(window);
+        const uchar* p = reinterpret_cast<const uchar*>(buf.constData());
+        const qint64 n = buf.size();
+
+        // First CRC-valid header in the window that moves forward in time.
+        for (qint64 i = 0; i + 1 < n; ++i) {
+            if (p[i] != 0xff) continue;
+            quint64 sample = 0;
+            quint32 frameSamples = 0;
+            if (!frameAt(p, n, i, si, sample, frameSamples)) continue;
+            if (!points.isEmpty() && sample <= points.last().sample) continue;
+            points.append({sample, quint64(guess + i - audio), quint16(frameSamples)});
+            break;
+        }
+    }
+    if (points.isEmpty() || points.first().sample != 0) return index;
+
+    index.points = std::move(points);
+    index.rate = si.rate;
+    index.magicStart = magic;
+    index.audioStart = audio;
+    return index;
+}
+
+// ========================= SEEKTABLE rewrite =========================
+QByteArray SeekIndex::flacPrefix(const QString& path) const {
+    QFile f(path);
+    if (points.isEmpty() || !f.open(QIODevice::ReadOnly)) return {};
+
+    StreamInfo si;
+    qint64 magic = 0, audio = 0;
+    int existing = 0;
+    if (!readLayout(f, si, magic, audio, existing) || magic != magicStart || audio != audioStart || si.rate != rate)
+        return {};
+
+    QByteArray out("fLaC");
+    qint64 pos = magic + 4;
+    for (bool last = false; !last;) {
+        uchar h[4];
+        if (!f.seek(pos) || f.read(reinterpret_cast<char*>(h), 4) != 4) return {};
+        const int type = h[0] & 0x7f;
+        const qint64 len = be24(h + 1);
+        last = h[0] & 0x80;
+        pos += 4 + len;
+        if (type == kSeekTable || type == kPicture) continue;
+        out.append(char(type)); // last flag cleared: the table goes after it
+        putBe(out, quint64(len), 3);
+        const QByteArray body = f.read(len);
+        if (body.size() != len) return {};
+        out.append(body);
+    }
+
+    out.append(char(0x80 | kSeekTable));
+    putBe(out, quint64(points.size()) * kSeekPointBytes, 3);
+    for (const SeekPoint& p : points) {
+        putBe(out, p.sample, 8);
+        putBe(out, p.offset, 8);
+        putBe(out, p.frameSamples, 2);
+    }
+    return out;
+}
@@ -0,0 +1,66 @@
+/*
+ * Author: Itoro Ifon, jason Hippolite, Prince Umeh
+ * Date: 2026-10-16
+ * Course/Assignment: C++ Project - Qt Music Player
+ * File: seekindex.h
+ * Purpose: Declares SeekIndex, the per-file sample -> byte offset table
+ *          built at scan time for long FLAC files without a usable
+ *          SEEKTABLE, and kept in the library cache.
+ */
+#pragma once
+
+#include <QByteArray>
+#include <QString>
+#include <QVector>
+
+// Struct: SeekPoint
+// Purpose: One frame start: first sample, byte offset from the first audio
+//          frame (FLAC SEEKTABLE convention) and the frame's sample count.
+struct SeekPoint {
+    quint64 sample = 0;
+    quint64 offset = 0;
+    quint16 frameSamples = 0;
+};
+
+// Class: SeekIndex
+// Purpose: Sorted seek points about kSpacingSeconds apart. floor() finds
+//          the frame to start decoding from in O(log n); flacPrefix()
+//          rebuilds the file's metadata with the points as a SEEKTABLE, so
+//          the decoder's own seek lands next to the target in one read.
+// Notes: build() samples frame headers at evenly spaced byte offsets (a
+//        small read each, CRC-checked) instead of walking the whole file.
+//        Files shorter than kMinDurationMs, or that already carry a dense
+//        SEEKTABLE, get an empty index. encode() is a compact varint form
+//        (a few bytes per point) for the library cache.
+class SeekIndex {
+public:
+    bool isEmpty() const { return points.isEmpty(); }
+    int size() const { return points.size(); }
+    const SeekPoint& at(int i) const { return points[i]; }
+    quint32 sampleRate() const { return rate; }
+    qint64 audioOffset() const { return audioStart; } // first frame, in the file
+
+    // Last point at or before `sample`; null when the index is empty.
+    const SeekPoint* floor(quint64 sample) const;
+
+    QByteArray encode() const;
+    static SeekIndex decode(const QByteArray& bytes);
+
+    static SeekIndex build(const QString& path);
+
+    // "fLaC" plus the file's metadata blocks (pictures and any old
+    // SEEKTABLE dropped) and a SEEKTABLE holding these points. Followed by
+    // the file from audioOffset() on, it is a valid FLAC stream with the
+    // same frames. Empty if the file no longer matches.
+    QByteArray flacPrefix(const QString& path) const;
+
+    static constexpr qint64 kMinDurationMs = 10 * 60 * 1000;
+    static constexpr double kSpacingSeconds = 2.0;
+    static constexpr int kMaxPoints = 8192;
+
+private:
+    QVector<SeekPoint> points;
+    quint32 rate = 0;
+    qint64 magicStart = 0; // "fLaC" (after an ID3v2 tag, if any)
+    qint64 audioStart = 0;
+};
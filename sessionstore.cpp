@@ -0,0 +1,223 @@
+/*
+ * Author: Itoro Ifon, jason Hippolite, Prince Umeh
+ * Date: 2026-10-16
+ * Course/Assignment: C++ Project - Qt Music Player
+ * File: sessionstore.cpp
+ * Purpose: Implements the session journal: replay, coalescing and the
+ *          background append/compaction writer.
+ */
+#include "sessionstore.h"
+
+#include <QFile>
+#include <QSaveFile>
+#include <QDataStream>
+#include <QDir>
+#include <QFileInfo>
+#include <QStandardPaths>
+
+#include <algorithm>
+
+static constexpr quint32 kJournalMagic   = 0x514D5053; // "QMPS"
+static constexpr quint32 kJournalVersion = 1;
+static constexpr int kHeaderBytes = 8;
+static constexpr int kFrameBytes = 6; // quint32 size + quint16 crc
+
+static const QString kResumePrefix = QStringLiteral("resume/");
+
+SessionStore::SessionStore(QObject* parent) : SessionStore(defaultFilePath(), parent) {}
+
+SessionStore::SessionStore(const QString& filePath, QObject* parent) : QObject(parent), path(filePath) {
+    writer.setMaxThreadCount(1);
+    flushTimer.setSingleShot(true);
+    connect(&flushTimer, &QTimer::timeout, this, &SessionStore::flush);
+}
+
+SessionStore::~SessionStore() {
+    flushAndWait();
+}
+
+QString SessionStore::defaultFilePath() {
+    return QDir(QStandardPaths::writableLocation(QStandardPaths::AppDataLocation)).filePath("session.journal");
+}
+
+// ========================= Replay =========================
+bool SessionStore::load() {
+    QFile f(path);
+    if (!f.open(QIODevice::ReadOnly)) return false;
+    const QByteArray bytes = f.readAll();
+
+    QDataStream head(bytes);
+    quint32 magic = 0, version = 0;
+    head >> magic >> version;
+    if (head.status() != QDataStream::Ok || magic != kJournalMagic || version != kJournalVersion) {
+        journalBytes = 0; // unreadable: the next flush starts a fresh snapshot
+        return false;
+    }
+
+    qint64 pos = kHeaderBytes;
+    while (pos + kFrameBytes <= bytes.size()) {
+        QDataStream frame(bytes.mid(pos, kFrameBytes));
+        quint32 size = 0;
+        quint16 crc = 0;
+        frame >> size >> crc;
+        if (pos + kFrameBytes + qint64(size) > bytes.size()) break; // torn tail
+
+        const QByteArray payload = bytes.mid(pos + kFrameBytes, size);
+        if (qChecksum(payload) != crc) break; // corrupt: ignore it and the rest
+
+        QDataStream in(payload);
+        in.setVersion(QDataStream::Qt_6_0);
+        quint8 op = 0;
+        QString key;
+        QVariant value;
+        in >> op >> key >> value;
+        if (in.status() != QDataStream::Ok) break;
+
+        if (op == OpSet) state.insert(key, value);
+        else if (op == OpRemove) state.remove(key);
+        pos += kFrameBytes + size;
+    }
+
+    // Anything after a bad record would be unreachable; make the next flush
+    // rewrite the file instead of appending behind it.
+    journalBytes = (pos == bytes.size()) ? pos : 0;
+    indexResumePositions();
+    return true;
+}
+
+void SessionStore::indexResumePositions() {
+    resumeBySeq.clear();
+    resumeSeq.clear();
+    for (auto it = state.cbegin(); it != state.cend(); ++it) {
+        if (!it.key().startsWith(kResumePrefix)) continue;
+        const quint64 seq = it.value().toList().value(1).toULongLong();
+        const QString track = it.key().mid(kResumePrefix.size());
+        resumeBySeq.insert(seq, track);
+        resumeSeq.insert(track, seq);
+        nextResumeSeq = std::max(nextResumeSeq, seq + 1);
+    }
+    // A journal written with a larger limit (or none) shrinks on first use.
+    while (resumeBySeq.size() > kResumeLimit) setResumePosition(resumeBySeq.first(), 0.0);
+}
+
+// ========================= State =========================
+QVariant SessionStore::value(const QString& key, const QVariant& defaultValue) const {
+    return state.value(key, defaultValue);
+}
+
+void SessionStore::setValue(const QString& key, const QVariant& value, Urgency urgency) {
+    auto it = state.constFind(key);
+    if (it != state.constEnd() && it.value() == value) {
+        if (urgency == Urgency::Soon && !pending.isEmpty()) schedule(urgency);
+        return; // unchanged: nothing to write
+    }
+    state.insert(key, value);
+    pending.insert(key, OpSet);
+    schedule(urgency);
+}
+
+void SessionStore::remove(const QString& key, Urgency urgency) {
+    if (!state.remove(key)) return;
+    pending.insert(key, OpRemove);
+    schedule(urgency);
+}
+
+void SessionStore::setResumePosition(const QString& trackPath, double seconds) {
+    const auto old = resumeSeq.constFind(trackPath);
+    if (old != resumeSeq.constEnd()) {
+        resumeBySeq.remove(old.value());
+        resumeSeq.erase(old);
+    }
+    if (seconds <= 0.0) {
+        remove(kResumePrefix + trackPath);
+        return;
+    }
+
+    const quint64 seq = nextResumeSeq++;
+    resumeBySeq.insert(seq, trackPath);
+    resumeSeq.insert(trackPath, seq);
+    setValue(kResumePrefix + trackPath, QVariantList{seconds, seq});
+
+    if (resumeBySeq.size() > kResumeLimit) setResumePosition(resumeBySeq.first(), 0.0); // least recent
+}
+
+double SessionStore::resumePosition(const QString& trackPath) const {
+    return state.value(kResumePrefix + trackPath).toList().value(0).toDouble();
+}
+
+void SessionStore::schedule(Urgency urgency) {
+    const int delay = (urgency == Urgency::Soon) ? kSoonDelayMs : kLazyDelayMs;
+    // Never push an earlier deadline back.
+    if (flushTimer.isActive() && flushTimer.remainingTime() <= delay) return;
+    flushTimer.start(delay);
+}
+
+// ========================= Writing =========================
+QByteArray SessionStore::encodeHeader() {
+    QByteArray out;
+    QDataStream s(&out, QIODevice::WriteOnly);
+    s << kJournalMagic << kJournalVersion;
+    return out;
+}
+
+QByteArray SessionStore::encodeRecord(Op op, const QString& key, const QVariant& value) {
+    QByteArray payload;
+    {
+        QDataStream s(&payload, QIODevice::WriteOnly);
+        s.setVersion(QDataStream::Qt_6_0);
+        s << quint8(op) << key << value;
+    }
+
+    QByteArray out;
+    QDataStream s(&out, QIODevice::WriteOnly);
+    s << quint32(payload.size()) << quint16(qChecksum(payload));
+    out.append(payload);
+    return out;
+}
+
+void SessionStore::flush() {
+    flushTimer.stop();
+    if (pending.isEmpty()) return;
+
+    // Encoding is cheap and happens here; the writer only moves bytes.
+    QByteArray bytes;
+    bool replace = false;
+
+    if (journalBytes == 0 || journalBytes > kCompactBytes) {
+        // Compact: the whole state as one snapshot, swapped in atomically.
+        replace = true;
+        bytes = encodeHeader();
+        for (auto it = state.cbegin(); it != state.cend(); ++it) bytes += encodeRecord(OpSet, it.key(), it.value());
+        journalBytes = bytes.size();
+    } else {
+        for (auto it = pending.cbegin(); it != pending.cend(); ++it)
+            bytes += encodeRecord(it.value(), it.key(), state.value(it.key()));
+        journalBytes += bytes.size();
+    }
+    pending.clear();
+
+    const QString file = path;
+    writer.start([file, bytes, replace] {
+        QDir().mkpath(QFileInfo(file).absolutePath());
+
+        if (replace) {
+            QSaveFile out(file);
+            if (out.open(QIODevice::WriteOnly)) {
+                out.write(bytes);
+                out.commit();
+            }
+            return;
+        }
+
+        QFile out(file);
+        if (out.open(QIODevice::WriteOnly | QIODevice::Append)) {
+            out.write(bytes); // one write per flush; a crash tears at most this record set
+            out.flush();
+        }
+    });
+}
+
+void SessionStore::flushAndWait() {
+    flush();
+    writer.waitForDone();
+}
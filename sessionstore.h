@@ -0,0 +1,88 @@
+/*
+ * Author: Itoro Ifon, jason Hippolite, Prince Umeh
+ * Date: 2026-10-16
+ * Course/Assignment: C++ Project - Qt Music Player
+ * File: sessionstore.h
+ * Purpose: Declares SessionStore, the in-memory player session state that is
+ *          persisted as an append-only journal on a background thread.
+ */
+#pragma once
+
+#include <QObject>
+#include <QString>
+#include <QVariant>
+#include <QHash>
+#include <QMap>
+#include <QByteArray>
+#include <QTimer>
+#include <QThreadPool>
+
+// Class: SessionStore
+// Purpose: Key/value session state (roots, current track, position, and
+//          later the queue, shuffle state and per-track resume positions).
+//          Reads and writes hit memory only; changes are coalesced and
+//          appended to a journal file by a single background writer.
+// Notes: Journal = header + records of [size][crc16][op, key, value].
+//        Loading replays records and stops at the first torn or corrupt one,
+//        so a crash mid-write loses at most the last record. When the
+//        journal grows past kCompactBytes it is rewritten as one snapshot
+//        with QSaveFile (write to a temp file, then atomic rename).
+//        Resume positions are kept for the kResumeLimit tracks played most
+//        recently; each carries a sequence number so the order survives
+//        compaction, and the oldest is dropped when a new track is added.
+//        GUI thread only; the writer thread only ever sees encoded bytes.
+class SessionStore : public QObject {
+    Q_OBJECT
+
+public:
+    // Lazy changes (playback position) are written within a few seconds;
+    // Soon changes (track switch, pause, stop) almost immediately.
+    enum class Urgency { Lazy, Soon };
+
+    explicit SessionStore(QObject* parent = nullptr);
+    SessionStore(const QString& filePath, QObject* parent);
+    ~SessionStore() override; // flushes and waits
+
+    // Replays the journal. Returns false when there was none (first run).
+    bool load();
+
+    QVariant value(const QString& key, const QVariant& defaultValue = QVariant()) const;
+    void setValue(const QString& key, const QVariant& value, Urgency urgency = Urgency::Lazy);
+    void remove(const QString& key, Urgency urgency = Urgency::Lazy);
+
+    // Per-track resume positions, in seconds (0 forgets the track). Setting
+    // one makes the track the most recent.
+    void setResumePosition(const QString& trackPath, double seconds);
+    double resumePosition(const QString& trackPath) const;
+
+    void flush();          // hand pending changes to the writer now
+    void flushAndWait();   // ... and block until they are on disk (shutdown)
+
+    QString filePath() const { return path; }
+    static QString defaultFilePath();
+
+    static constexpr int kLazyDelayMs = 5000;
+    static constexpr int kSoonDelayMs = 250;
+    static constexpr qint64 kCompactBytes = 64 * 1024;
+    static constexpr int kResumeLimit = 200;
+
+private:
+    enum Op : quint8 { OpSet = 1, OpRemove = 2 };
+
+    void schedule(Urgency urgency);
+    static QByteArray encodeRecord(Op op, const QString& key, const QVariant& value);
+    static QByteArray encodeHeader();
+    void indexResumePositions(); // after replay
+
+    QString path;
+    QHash<QString, QVariant> state;
+    QHash<QString, Op> pending;   // keys changed since the last flush
+    qint64 journalBytes = 0;      // size of the file once queued writes land
+
+    QMap<quint64, QString> resumeBySeq; // track path by recency, oldest first
+    QHash<QString, quint64> resumeSeq;  // ... and the inverse
+    quint64 nextResumeSeq = 1;
+
+    QTimer flushTimer;
+    QThreadPool writer;           // one thread: writes land in order
+};
@@ -0,0 +1,146 @@
+/*
+ * Author: Itoro Ifon, jason Hippolite, Prince Umeh
+ * Date: 2026-10-16
+ * Course/Assignment: C++ Project - Qt Music Player
+ * File: shuffleorder.cpp
+ * Purpose: Implements the lazy Fisher-Yates shuffle and its weights.
+ */
+#include "shuffleorder.h"
+
+#include <algorithm>
+
+ShuffleOrder::ShuffleOrder(const TrackStore& store)
+    : tracks(store), rng(QRandomGenerator::global()->generate()) {}
+
+// ========================= Passes =========================
+void ShuffleOrder::restart() {
+    cursor = 0;
+    displaced.clear();
+    positions.clear();
+    held = kNoTrack;
+
+    // Removed IDs go first, so the pass starts past them. Positions below
+    // the cursor only ever receive removed IDs, so each one not placed yet
+    // is still at or above it.
+    for (TrackId id : dead) {
+        swap(positionOf(id), cursor);
+        ++cursor;
+    }
+}
+
+void ShuffleOrder::clear() {
+    dead.clear();
+    restart();
+    base = tracks.idLimit();
+    last = kNoTrack;
+    recentCount = recentNext = 0;
+}
+
+void ShuffleOrder::retire(quint32 pos) {
+    dead.insert(valueAt(pos));
+    swap(pos, cursor);
+    ++cursor;
+}
+
+void ShuffleOrder::swap(quint32 a, quint32 b) {
+    if (a == b) return;
+    const TrackId atA = valueAt(a);
+    const TrackId atB = valueAt(b);
+    displaced.insert(a, atB);
+    displaced.insert(b, atA);
+    positions.insert(atB, a);
+    positions.insert(atA, b);
+}
+
+// ========================= Picks =========================
+TrackId ShuffleOrder::peek(bool wrap) {
+    if (held != kNoTrack && tracks.rowOf(held) >= 0 && positionOf(held) >= cursor) return held;
+    held = draw();
+    if (held == kNoTrack && wrap && !tracks.isEmpty()) {
+        restart();
+        held = draw();
+    }
+    return held;
+}
+
+TrackId ShuffleOrder::draw() {
+    TrackId best = kNoTrack;
+    double bestWeight = -1.0;
+    int draws = 0;
+    while (draws < kMaxDraws && cursor < span()) {
+        const quint32 pos = cursor + rng.bounded(span() - cursor);
+        const TrackId id = valueAt(pos);
+        const int row = tracks.rowOf(id);
+        if (row < 0) {
+            // Removed without forget(): out of this and every future pass.
+            retire(pos);
+            continue;
+        }
+
+        ++draws;
+        const double w = weight(id, row);
+        if (w >= 1.0 || rng.generateDouble() < w) return id;
+        if (w > bestWeight) {
+            best = id;
+            bestWeight = w;
+        }
+    }
+    return best;
+}
+
+void ShuffleOrder::take(TrackId id) {
+    const int row = tracks.rowOf(id);
+    if (row < 0) return;
+    if (id == held) held = kNoTrack;
+
+    const quint32 pos = positionOf(id);
+    if (pos >= cursor && pos < span()) {
+        swap(pos, cursor);
+        ++cursor;
+    }
+
+    last = id;
+    const QByteArray& artist = tracks.sortKeysAt(row).artist;
+    if (artist.isEmpty()) return;
+    recentArtists[recentNext] = qHash(artist);
+    recentNext = (recentNext + 1) % kArtistSpread;
+    recentCount = std::min(recentCount + 1, int(kArtistSpread));
+}
+
+void ShuffleOrder::forget(TrackId id) {
+    if (id < base || id >= tracks.idLimit() || dead.contains(id)) return;
+    if (id == held) held = kNoTrack;
+    if (id == last) last = kNoTrack;
+
+    const quint32 pos = positionOf(id);
+    if (pos >= cursor) retire(pos);
+    else dead.insert(id); // already played this pass
+}
+
+// ========================= Weights =========================
+double ShuffleOrder::weight(TrackId id, int row) const {
+    if (id == last) return 0.0; // only if nothing else turns up
+
+    switch (weighting) {
+    case Mode::Uniform:
+        return 1.0;
+    case Mode::LeastPlayed:
+        return 1.0 / (1.0 + tracks.playCountAt(row));
+    case Mode::SpreadArtists: {
+        const QByteArray& artist = tracks.sortKeysAt(row).artist;
+        if (artist.isEmpty()) return 1.0;
+        const size_t h = qHash(artist);
+        // Distance 1 is the artist just played; the weight recovers
+        // quadratically over the window.
+        for (int d = 1; d <= recentCount; ++d) {
+            const int slot = (recentNext - d + kArtistSpread) % kArtistSpread;
+            if (recentArtists[slot] == h) {
+                const double f = double(d) / (kArtistSpread + 1);
+                return f * f;
+            }
+        }
+        return 1.0;
+    }
+    }
+    return 1.0;
+}
@@ -0,0 +1,91 @@
+/*
+ * Author: Itoro Ifon, jason Hippolite, Prince Umeh
+ * Date: 2026-10-16
+ * Course/Assignment: C++ Project - Qt Music Player
+ * File: shuffleorder.h
+ * Purpose: Declares ShuffleOrder, the lazily drawn shuffle behind
+ *          PlayQueue: one pick at a time, optionally weighted.
+ */
+#pragma once
+
+#include <QHash>
+#include <QSet>
+#include <QRandomGenerator>
+
+#include <array>
+
+#include "trackstore.h"
+
+// Class: ShuffleOrder
+// Purpose: Plays every track once per pass in random order without
+//          building the permutation. A Fisher-Yates cursor runs over the
+//          track ID space: positions before the cursor are this pass's
+//          picks, and only positions that were ever swapped are stored, so
+//          a pick is O(1) and the memory is proportional to what has been
+//          played or removed, not to the library.
+// Notes: Tracks added mid-pass get new IDs, which lie past the end of the
+//        space the pass has seen, so they join the pass as unpicked.
+//        forget() moves a removed ID below the cursor at once, and
+//        restart() parks every removed ID in front of the first position a
+//        pass draws from, so a removed track costs one swap per pass and is
+//        never drawn again. An ID removed without forget() is retired the
+//        same way the one time it is drawn. The weighted modes
+//        accept a drawn track with probability equal to its weight and
+//        otherwise draw again, up to kMaxDraws times, then take the
+//        heaviest track drawn. That keeps each pick O(1); the weighting is
+//        a bias, not an exact distribution. The track just taken is never
+//        picked again while another one remains.
+class ShuffleOrder {
+public:
+    enum class Mode {
+        Uniform,
+        LeastPlayed,  // weight 1 / (1 + play count)
+        SpreadArtists // the last kArtistSpread artists are mostly held back
+    };
+
+    explicit ShuffleOrder(const TrackStore& store);
+
+    Mode mode() const { return weighting; }
+    void setMode(Mode m) { weighting = m; held = kNoTrack; }
+
+    // The next pick, drawn once and held until taken; kNoTrack when the
+    // pass is over and `wrap` is false. With `wrap` a new pass starts.
+    TrackId peek(bool wrap);
+    // `id` started playing, picked by the shuffle or not: it leaves this
+    // pass and counts as the latest artist.
+    void take(TrackId id);
+    // `id` is about to leave the library: out of this pass and every later one.
+    void forget(TrackId id);
+
+    void restart();        // a new pass, keeping the ID range
+    void clear();          // the library was emptied; IDs so far are gone
+    int taken() const { return int(cursor); }
+
+    static constexpr int kMaxDraws = 8;
+    static constexpr int kArtistSpread = 8;
+
+private:
+    quint32 span() const { return tracks.idLimit() - base; }
+    TrackId valueAt(quint32 pos) const { return displaced.value(pos, base + pos); }
+    quint32 positionOf(TrackId id) const { return positions.value(id, id - base); }
+    void swap(quint32 a, quint32 b);
+    void retire(quint32 pos); // the removed ID at `pos` (>= cursor) leaves the pass
+    TrackId draw();
+    double weight(TrackId id, int row) const;
+
+    const TrackStore& tracks;
+    QRandomGenerator rng;
+    Mode weighting = Mode::Uniform;
+
+    TrackId base = 1;                  // position 0 holds this ID until swapped
+    quint32 cursor = 0;                // positions below are taken this pass
+    QHash<quint32, TrackId> displaced; // position -> ID, only where swapped
+    QHash<TrackId, quint32> positions; // ... and the inverse
+    QSet<TrackId> dead;                // removed IDs; below the cursor in every pass
+    TrackId held = kNoTrack;           // drawn by peek(), not taken yet
+    TrackId last = kNoTrack;           // taken most recently
+
+    std::array<size_t, kArtistSpread> recentArtists{}; // qHash of the artist key, newest at recentNext - 1
+    int recentNext = 0;
+    int recentCount = 0;
+};
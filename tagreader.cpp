@@ -0,0 +1,472 @@
+/*
+ * Author: Itoro Ifon, jason Hippolite, Prince Umeh
+ * Date: 2026-10-16
+ * Course/Assignment: C++ Project - Qt Music Player
+ * File: tagreader.cpp
+ * Purpose: Implements the per-format header parsers behind TagReader.
+ */
+#include "tagreader.h"
+
+#include <QFile>
+#include <QByteArray>
+#include <QStringDecoder>
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <deque>
+
+namespace {
+
+// ========================= Byte views =========================
+// Non-owning view into a mapping (or, if mapping failed, a read buffer).
+struct Span {
+    const uchar* p = nullptr;
+    qint64 n = 0;
+
+    bool has(qint64 off, qint64 len) const { return off >= 0 && len >= 0 && off + len <= n; }
+    Span sub(qint64 off, qint64 len) const {
+        if (!has(off, 0)) return {};
+        return {p + off, std::min(len, n - off)};
+    }
+    bool startsWith(const char* magic, qint64 len) const { return n >= len && std::memcmp(p, magic, len) == 0; }
+};
+
+quint32 le16(const uchar* b) { return quint32(b[0]) | quint32(b[1]) << 8; }
+quint32 le32(const uchar* b) { return le16(b) | quint32(b[2]) << 16 | quint32(b[3]) << 24; }
+quint64 le64(const uchar* b) { return quint64(le32(b)) | quint64(le32(b + 4)) << 32; }
+quint32 be16(const uchar* b) { return quint32(b[0]) << 8 | quint32(b[1]); }
+quint32 be24(const uchar* b) { return quint32(b[0]) << 16 | be16(b + 1); }
+quint32 be32(const uchar* b) { return quint32(b[0]) << 24 | be24(b + 1); }
+quint64 be64(const uchar* b) { return quint64(be32(b)) << 32 | quint64(be32(b + 4)); }
+quint32 synchsafe32(const uchar* b) {
+    return quint32(b[0] & 0x7f) << 21 | quint32(b[1] & 0x7f) << 14 | quint32(b[2] & 0x7f) << 7 | quint32(b[3] & 0x7f);
+}
+
+// Class: MappedFile
+// Purpose: Maps byte ranges of one file on demand; mappings stay valid until
+//          the object goes away (QFile unmaps on close).
+class MappedFile {
+public:
+    explicit MappedFile(const QString& path) : file(path) {}
+
+    bool open() {
+        if (!file.open(QIODevice::ReadOnly)) return false;
+        size = file.size();
+        return true;
+    }
+
+    qint64 fileSize() const { return size; }
+
+    Span map(qint64 off, qint64 len) {
+        if (off < 0 || off >= size || len <= 0) return {};
+        len = std::min(len, size - off);
+
+        if (uchar* p = file.map(off, len)) return {p, len};
+
+        // Some filesystems cannot be mapped; read that range instead.
+        if (!file.seek(off)) return {};
+        fallback.push_back(file.read(len));
+        const QByteArray& b = fallback.back();
+        return {reinterpret_cast<const uchar*>(b.constData()), b.size()};
+    }
+
+private:
+    QFile file;
+    qint64 size = 0;
+    std::deque<QByteArray> fallback; // deque: earlier buffers never move
+};
+
+// Returns bytes [off, off+len) from `head` when it covers them, else maps them.
+Span rangeAt(MappedFile& mf, const Span& head, qint64 off, qint64 len) {
+    if (head.has(off, len)) return head.sub(off, len);
+    return mf.map(off, len);
+}
+
+// ========================= Text =========================
+QString text8(const uchar* p, qint64 n) {
+    while (n > 0 && p[n - 1] == 0) --n; // C-string padding
+    const char* c = reinterpret_cast<const char*>(p);
+    QString s = QString::fromUtf8(c, n);
+    if (s.contains(QChar::ReplacementCharacter)) s = QString::fromLatin1(c, n); // legacy INFO tags
+    return s.trimmed();
+}
+
+QString text16(const uchar* p, qint64 n, QStringConverter::Encoding enc) {
+    QStringDecoder decode(enc);
+    QString s = decode(QByteArrayView(p, n));
+    while (s.endsWith(QChar(0))) s.chop(1);
+    return s.trimmed();
+}
+
+int parseTrackNumber(const QString& s) {
+    // "7", "07" or "7/12"
+    return s.section('/', 0, 0).trimmed().toInt();
+}
+
+void setIfEmpty(QString& field, const QString& value) {
+    if (field.isEmpty() && !value.isEmpty()) field = value;
+}
+
+// ========================= Vorbis comments =========================
+// Shared by FLAC, Ogg Vorbis and Opus. Little-endian lengths; tolerant of a
+// truncated block (stops at the first field that does not fit).
+void parseVorbisComment(const Span& s, AudioTags& out) {
+    qint64 pos = 0;
+    if (!s.has(pos, 4)) return;
+    pos += 4 + qint64(le32(s.p + pos)); // vendor string
+    if (!s.has(pos, 4)) return;
+    quint32 count = le32(s.p + pos);
+    pos += 4;
+
+    QString albumArtist;
+    for (; count > 0 && s.has(pos, 4); --count) {
+        const qint64 len = le32(s.p + pos);
+        pos += 4;
+        if (!s.has(pos, len)) return;
+
+        const char* field = reinterpret_cast<const char*>(s.p + pos);
+        const char* eq = static_cast<const char*>(std::memchr(field, '=', size_t(len)));
+        if (eq) {
+            const QByteArrayView key(field, eq - field);
+            const uchar* value = reinterpret_cast<const uchar*>(eq + 1);
+            const qint64 valueLen = len - (eq + 1 - field);
+
+            if (key.compare("TITLE", Qt::CaseInsensitive) == 0) setIfEmpty(out.title, text8(value, valueLen));
+            else if (key.compare("ARTIST", Qt::CaseInsensitive) == 0) setIfEmpty(out.artist, text8(value, valueLen));
+            else if (key.compare("ALBUM", Qt::CaseInsensitive) == 0) setIfEmpty(out.album, text8(value, valueLen));
+            else if (key.compare("ALBUMARTIST", Qt::CaseInsensitive) == 0) setIfEmpty(albumArtist, text8(value, valueLen));
+            else if (key.compare("TRACKNUMBER", Qt::CaseInsensitive) == 0 && out.trackNumber == 0)
+                out.trackNumber = parseTrackNumber(text8(value, valueLen));
+        }
+        pos += len;
+    }
+    setIfEmpty(out.artist, albumArtist);
+}
+
+// ========================= ID3v2 =========================
+// Text frames of an ID3v2.3/2.4 tag, as embedded in WAV ("id3 ") and AIFF
+// ("ID3 ") chunks.
+void parseId3v2(const Span& s, AudioTags& out) {
+    if (!s.startsWith("ID3", 3) || !s.has(0, 10)) return;
+    const int major = s.p[3];
+    const uchar flags = s.p[5];
+    if (major < 3 || major > 4) return;  // v2.2 uses 3-char frame IDs; not worth it here
+    if (flags & 0x80) return;            // unsynchronised tags are rare; skip rather than copy
+
+    const qint64 end = std::min<qint64>(s.n, 10 + qint64(synchsafe32(s.p + 6)));
+    qint64 pos = 10;
+    if (flags & 0x40) { // extended header
+        if (!s.has(pos, 4)) return;
+        pos += (major == 4) ? qint64(synchsafe32(s.p + pos)) : 4 + qint64(be32(s.p + pos));
+    }
+
+    while (pos + 10 <= end) {
+        const uchar* h = s.p + pos;
+        if (h[0] == 0) break; // padding
+        const qint64 size = (major == 4) ? qint64(synchsafe32(h + 4)) : qint64(be32(h + 4));
+        const qint64 body = pos + 10;
+        if (size <= 0 || body + size > end) break;
+
+        const QByteArrayView id(reinterpret_cast<const char*>(h), 4);
+        QString* target = nullptr;
+        QString trackText;
+        if (id == "TIT2") target = &out.title;
+        else if (id == "TPE1") target = &out.artist;
+        else if (id == "TALB") target = &out.album;
+        else if (id == "TRCK") target = &trackText;
+
+        if (target && size > 1) {
+            const uchar* t = s.p + body + 1;
+            const qint64 tn = size - 1;
+            QString value;
+            switch (s.p[body]) {
+            case 0: value = QString::fromLatin1(reinterpret_cast<const char*>(t), tn).trimmed(); break;
+            case 1: value = text16(t, tn, QStringConverter::Utf16); break; // BOM decides
+            case 2: value = text16(t, tn, QStringConverter::Utf16BE); break;
+            case 3: value = text8(t, tn); break;
+            default: break;
+            }
+            value = value.section(QChar(0), 0, 0); // first of multiple values
+            setIfEmpty(*target, value);
+            if (target == &trackText && out.trackNumber == 0) out.trackNumber = parseTrackNumber(trackText);
+        }
+        pos = body + size;
+    }
+}
+
+// ========================= FLAC =========================
+bool readFlac(MappedFile& mf, const Span& head, AudioTags& out) {
+    qint64 pos = 0;
+    // Some taggers prepend an ID3v2 tag; skip it.
+    if (head.startsWith("ID3", 3) && head.has(0, 10)) {
+        pos = 10 + qint64(synchsafe32(head.p + 6));
+        if (head.p[5] & 0x10) pos += 10; // footer
+    }
+
+    const Span magic = rangeAt(mf, head, pos, 4);
+    if (!magic.startsWith("fLaC", 4)) return false;
+    pos += 4;
+
+    for (;;) {
+        const Span h = rangeAt(mf, head, pos, 4);
+        if (h.n < 4) break;
+        const bool last = h.p[0] & 0x80;
+        const int type = h.p[0] & 0x7f;
+        const qint64 len = be24(h.p + 1);
+        pos += 4;
+
+        if (type == 0 && len >= 18) { // STREAMINFO
+            const Span b = rangeAt(mf, head, pos, 18);
+            if (b.n == 18) {
+                const quint32 rate = (quint32(b.p[10]) << 12) | (quint32(b.p[11]) << 4) | (b.p[12] >> 4);
+                const quint64 samples = (quint64(b.p[13] & 0x0f) << 32) | be32(b.p + 14);
+                if (rate > 0) out.durationMs = qint64(samples * 1000 / rate);
+            }
+        } else if (type == 4) { // VORBIS_COMMENT; may sit past a large PICTURE block
+            parseVorbisComment(rangeAt(mf, head, pos, len), out);
+        } else if (type == 127) {
+            break; // invalid
+        }
+
+        pos += len;
+        if (last) break;
+    }
+    return true;
+}
+
+// ========================= Ogg =========================
+// Walks the pages inside `head`, reassembling the first two packets of the
+// first logical stream. A packet that fits in one page is parsed in place;
+// only packets that span pages are copied (and only up to the window).
+bool readOgg(MappedFile& mf, const Span& head, AudioTags& out) {
+    if (!head.startsWith("OggS", 4)) return false;
+
+    quint32 serial = 0;
+    bool haveSerial = false;
+    int packetIndex = 0;
+    QByteArray spanning;
+    bool continuing = false;
+
+    enum class Codec { Unknown, Vorbis, Opus } codec = Codec::Unknown;
+    quint32 sampleRate = 0;
+    quint32 preSkip = 0;
+
+    auto handlePacket = [&](const Span& pk) {
+        if (packetIndex == 0) {
+            if (pk.startsWith("\x01vorbis", 7) && pk.has(12, 4)) {
+                codec = Codec::Vorbis;
+                sampleRate = le32(pk.p + 12);
+            } else if (pk.startsWith("OpusHead", 8) && pk.has(10, 2)) {
+                codec = Codec::Opus;
+                sampleRate = 48000; // Opus granules always count 48 kHz samples
+                preSkip = le16(pk.p + 10);
+            }
+        } else if (packetIndex == 1) {
+            if (codec == Codec::Vorbis && pk.startsWith("\x03vorbis", 7)) parseVorbisComment(pk.sub(7, pk.n), out);
+            else if (codec == Codec::Opus && pk.startsWith("OpusTags", 8)) parseVorbisComment(pk.sub(8, pk.n), out);
+        }
+        ++packetIndex;
+    };
+
+    qint64 pos = 0;
+    while (packetIndex < 2 && head.has(pos, 27) && std::memcmp(head.p + pos, "OggS", 4) == 0) {
+        const uchar* page = head.p + pos;
+        const quint32 pageSerial = le32(page + 14);
+        const int segments = page[26];
+        if (!head.has(pos + 27, segments)) break;
+
+        qint64 body = pos + 27 + segments;
+        qint64 bodyLen = 0;
+        for (int i = 0; i < segments; ++i) bodyLen += page[27 + i];
+
+        if (!haveSerial) {
+            serial = pageSerial;
+            haveSerial = true;
+        }
+        if (pageSerial == serial) {
+            qint64 at = body;
+            qint64 packetStart = body;
+            for (int i = 0; i < segments && packetIndex < 2; ++i) {
+                const int lace = page[27 + i];
+                at += lace;
+                if (lace == 255) continue; // packet continues
+
+                const Span piece = head.sub(packetStart, at - packetStart);
+                if (continuing) {
+                    spanning.append(reinterpret_cast<const char*>(piece.p), piece.n);
+                    handlePacket({reinterpret_cast<const uchar*>(spanning.constData()), spanning.size()});
+                    spanning.clear();
+                    continuing = false;
+                } else {
+                    handlePacket(piece);
+                }
+                packetStart = at;
+            }
+            // Packet still open at the end of the page: carry it over.
+            if (packetIndex < 2 && packetStart < body + bodyLen) {
+                const Span piece = head.sub(packetStart, body + bodyLen - packetStart);
+                spanning.append(reinterpret_cast<const char*>(piece.p), piece.n);
+                continuing = true;
+            }
+        }
+        pos = body + bodyLen;
+    }
+
+    // Header window ended inside the comment packet (usually embedded cover
+    // art): use what we have, the comment parser stops at the cut.
+    if (packetIndex == 1 && continuing) handlePacket({reinterpret_cast<const uchar*>(spanning.constData()), spanning.size()});
+
+    // Duration: granule position of the last page of our stream.
+    if (sampleRate > 0) {
+        const qint64 tailLen = std::min(mf.fileSize(), TagReader::kTailWindow);
+        const Span tail = rangeAt(mf, head, mf.fileSize() - tailLen, tailLen);
+        for (qint64 i = tail.n - 27; i >= 0; --i) {
+            if (std::memcmp(tail.p + i, "OggS", 4) != 0 || le32(tail.p + i + 14) != serial) continue;
+            const quint64 granule = le64(tail.p + i + 6);
+            if (granule == ~quint64(0)) continue; // no packet ends on this page
+            const quint64 samples = granule > preSkip ? granule - preSkip : 0;
+            out.durationMs = qint64(samples * 1000 / sampleRate);
+            break;
+        }
+    }
+    return codec != Codec::Unknown;
+}
+
+// ========================= RIFF / WAV =========================
+void parseRiffInfo(const Span& list, AudioTags& out) {
+    if (!list.startsWith("INFO", 4)) return;
+    qint64 pos = 4;
+    while (list.has(pos, 8)) {
+        const QByteArrayView id(reinterpret_cast<const char*>(list.p + pos), 4);
+        const qint64 len = le32(list.p + pos + 4);
+        const qint64 body = pos + 8;
+        if (!list.has(body, len)) break;
+
+        const uchar* t = list.p + body;
+        if (id == "INAM") setIfEmpty(out.title, text8(t, len));
+        else if (id == "IART") setIfEmpty(out.artist, text8(t, len));
+        else if (id == "IPRD") setIfEmpty(out.album, text8(t, len));
+        else if ((id == "ITRK" || id == "IPRT") && out.trackNumber == 0) out.trackNumber = parseTrackNumber(text8(t, len));
+
+        pos = body + len + (len & 1);
+    }
+}
+
+bool readWav(MappedFile& mf, const Span& head, AudioTags& out) {
+    if (!head.startsWith("RIFF", 4) || !head.has(8, 4) || std::memcmp(head.p + 8, "WAVE", 4) != 0) return false;
+
+    quint32 byteRate = 0;
+    qint64 dataBytes = 0;
+    qint64 pos = 12;
+    while (pos + 8 <= mf.fileSize()) {
+        const Span h = rangeAt(mf, head, pos, 8);
+        if (h.n < 8) break;
+        const QByteArrayView id(reinterpret_cast<const char*>(h.p), 4);
+        const qint64 len = le32(h.p + 4);
+        const qint64 body = pos + 8;
+
+        if (id == "fmt ") {
+            const Span fmt = rangeAt(mf, head, body, 16);
+            if (fmt.n >= 12) byteRate = le32(fmt.p + 8);
+        } else if (id == "data") {
+            dataBytes = std::min(len, mf.fileSize() - body); // audio itself is never mapped
+        } else if (id == "LIST") {
+            parseRiffInfo(rangeAt(mf, head, body, len), out);
+        } else if (id == "id3 " || id == "ID3 ") {
+            parseId3v2(rangeAt(mf, head, body, len), out);
+        }
+
+        pos = body + len + (len & 1);
+    }
+
+    if (byteRate > 0) out.durationMs = dataBytes * 1000 / byteRate;
+    return true;
+}
+
+// ========================= AIFF =========================
+double extended80(const uchar* b) {
+    const int exponent = int(be16(b) & 0x7fff);
+    const quint64 mantissa = be64(b + 2);
+    if (exponent == 0 && mantissa == 0) return 0.0;
+    return std::ldexp(double(mantissa), exponent - 16383 - 63);
+}
+
+bool readAiff(MappedFile& mf, const Span& head, AudioTags& out) {
+    if (!head.startsWith("FORM", 4) || !head.has(8, 4)) return false;
+    if (std::memcmp(head.p + 8, "AIFF", 4) != 0 && std::memcmp(head.p + 8, "AIFC", 4) != 0) return false;
+
+    qint64 pos = 12;
+    while (pos + 8 <= mf.fileSize()) {
+        const Span h = rangeAt(mf, head, pos, 8);
+        if (h.n < 8) break;
+        const QByteArrayView id(reinterpret_cast<const char*>(h.p), 4);
+        const qint64 len = be32(h.p + 4);
+        const qint64 body = pos + 8;
+
+        if (id == "COMM") {
+            const Span c = rangeAt(mf, head, body, 18);
+            if (c.n == 18) {
+                const quint32 frames = be32(c.p + 2);
+                const double rate = extended80(c.p + 8);
+                if (rate > 0.0) out.durationMs = qint64(double(frames) * 1000.0 / rate);
+            }
+        } else if (id == "NAME") {
+            const Span t = rangeAt(mf, head, body, len);
+            setIfEmpty(out.title, text8(t.p, t.n));
+        } else if (id == "AUTH") {
+            const Span t = rangeAt(mf, head, body, len);
+            setIfEmpty(out.artist, text8(t.p, t.n));
+        } else if (id == "ID3 " || id == "id3 ") {
+            parseId3v2(rangeAt(mf, head, body, len), out);
+        }
+
+        pos = body + len + (len & 1);
+    }
+    return true;
+}
+
+// ========================= AU =========================
+bool readAu(MappedFile& mf, const Span& head, AudioTags& out) {
+    if (!head.startsWith(".snd", 4) || !head.has(0, 24)) return false;
+
+    const qint64 offset = be32(head.p + 4);
+    qint64 dataBytes = be32(head.p + 8);
+    const quint32 encoding = be32(head.p + 12);
+    const quint32 rate = be32(head.p + 16);
+    const quint32 channels = be32(head.p + 20);
+    if (dataBytes == 0xffffffff) dataBytes = mf.fileSize() - offset; // size unknown
+
+    int bytesPerSample = 0;
+    switch (encoding) {
+    case 1: case 2: case 27: bytesPerSample = 1; break; // mu-law, 8-bit, A-law
+    case 3: bytesPerSample = 2; break;
+    case 4: bytesPerSample = 3; break;
+    case 5: case 6: bytesPerSample = 4; break;
+    case 7: bytesPerSample = 8; break;
+    default: break;
+    }
+
+    const qint64 perSecond = qint64(bytesPerSample) * channels * rate;
+    if (perSecond > 0 && dataBytes > 0) out.durationMs = dataBytes * 1000 / perSecond;
+    return true;
+}
+
+} // namespace
+
+// ========================= Entry point =========================
+bool TagReader::read(const QString& path, AudioTags& out) {
+    MappedFile mf(path);
+    if (!mf.open()) return false;
+
+    const Span head = mf.map(0, std::min(mf.fileSize(), kHeaderWindow));
+    if (head.n < 12) return false;
+
+    // Sniff the content rather than trusting the extension.
+    if (head.startsWith("fLaC", 4) || head.startsWith("ID3", 3)) return readFlac(mf, head, out);
+    if (head.startsWith("OggS", 4)) return readOgg(mf, head, out);
+    if (head.startsWith("RIFF", 4)) return readWav(mf, head, out);
+    if (head.startsWith("FORM", 4)) return readAiff(mf, head, out);
+    if (head.startsWith(".snd", 4)) return readAu(mf, head, out);
+    return false;
+}
@@ -0,0 +1,45 @@
+/*
+ * Author: Itoro Ifon, jason Hippolite, Prince Umeh
+ * Date: 2026-10-16
+ * Course/Assignment: C++ Project - Qt Music Player
+ * File: tagreader.h
+ * Purpose: Declares TagReader, a lightweight metadata parser for the audio
+ *          formats the player supports (FLAC, Ogg Vorbis/Opus, WAV, AIFF, AU).
+ */
+#pragma once
+
+#include <QString>
+
+// Struct: AudioTags
+// Purpose: Metadata read from a file's own header; empty/zero when absent.
+struct AudioTags {
+    QString title;
+    QString artist;
+    QString album;
+    int trackNumber = 0;
+    qint64 durationMs = 0;
+};
+
+// Class: TagReader
+// Purpose: Reads tags and duration straight from the container headers
+//          without opening a decoder:
+//            FLAC - STREAMINFO + VORBIS_COMMENT blocks
+//            Ogg  - identification/comment packets + last page granule
+//            WAV  - fmt/data sizes + LIST/INFO or an embedded ID3v2 chunk
+//            AIFF - COMM + NAME/AUTH or an embedded ID3v2 chunk
+//            AU   - header fields (duration only)
+// Notes: Only the header window and the chunks that hold tags are
+//        memory-mapped; audio data is never touched. Strings are decoded
+//        straight out of the mapping. Stateless and thread-safe, so scan
+//        workers call it concurrently.
+class TagReader {
+public:
+    // Returns false when the file could not be opened or is not a format
+    // recognised here; `out` may still be partially filled.
+    static bool read(const QString& path, AudioTags& out);
+
+    // How much of the file start is mapped up front.
+    static constexpr qint64 kHeaderWindow = 256 * 1024;
+    // How much of the file end is mapped to find the last Ogg page.
+    static constexpr qint64 kTailWindow = 64 * 1024;
+};
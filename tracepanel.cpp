@@ -0,0 +1,157 @@
+/*
+ * Author: Itoro Ifon, jason Hippolite, Prince Umeh
+ * Date: 2026-10-16
+ * Course/Assignment: C++ Project - Qt Music Player
+ * File: tracepanel.cpp
+ * Purpose: Implements the live diagnostics window.
+ */
+#include "tracepanel.h"
+#include "tracer.h"
+
+#include <QCheckBox>
+#include <QDateTime>
+#include <QDir>
+#include <QFileDialog>
+#include <QHBoxLayout>
+#include <QHeaderView>
+#include <QLabel>
+#include <QMessageBox>
+#include <QPushButton>
+#include <QTableWidget>
+#include <QVBoxLayout>
+
+#include <algorithm>
+#include <vector>
+
+namespace {
+
+QTableWidgetItem* numberItem(double value, int decimals) {
+    auto* item = new QTableWidgetItem(QString::number(value, 'f', decimals));
+    item->setTextAlignment(Qt::AlignRight | Qt::AlignVCenter);
+    return item;
+}
+
+QTableWidget* makeTable(const QStringList& headers) {
+    auto* t = new QTableWidget(0, headers.size());
+    t->setHorizontalHeaderLabels(headers);
+    t->setEditTriggers(QAbstractItemView::NoEditTriggers);
+    t->setSelectionMode(QAbstractItemView::NoSelection);
+    t->verticalHeader()->setVisible(false);
+    t->horizontalHeader()->setSectionResizeMode(0, QHeaderView::Stretch);
+    for (int c = 1; c < headers.size(); ++c)
+        t->horizontalHeader()->setSectionResizeMode(c, QHeaderView::ResizeToContents);
+    return t;
+}
+
+} // namespace
+
+TracePanel::TracePanel(StallDetector* stallDetector, QWidget* parent)
+    : QWidget(parent, Qt::Tool), stalls(stallDetector) {
+    setWindowTitle("Diagnostics");
+
+    recordBox = new QCheckBox("Record trace");
+    recordBox->setChecked(Tracer::enabled());
+    connect(recordBox, &QCheckBox::toggled, this, &TracePanel::setRecording);
+
+    saveBtn = new QPushButton("Save Trace…");
+    saveBtn->setToolTip("Chrome trace JSON; open it in ui.perfetto.dev or chrome://tracing");
+    connect(saveBtn, &QPushButton::clicked, this, &TracePanel::saveTrace);
+
+    resetBtn = new QPushButton("Reset");
+    connect(resetBtn, &QPushButton::clicked, this, &TracePanel::resetTrace);
+
+    auto* topRow = new QHBoxLayout();
+    topRow->addWidget(recordBox);
+    topRow->addStretch(1);
+    topRow->addWidget(resetBtn);
+    topRow->addWidget(saveBtn);
+
+    statusLabel = new QLabel();
+
+    spanTable = makeTable({"Span", "Count", "Total ms", "Avg ms", "Max ms"});
+    counterTable = makeTable({"Counter", "Value"});
+
+    auto* layout = new QVBoxLayout(this);
+    layout->addLayout(topRow);
+    layout->addWidget(statusLabel);
+    layout->addWidget(spanTable, 3);
+    layout->addWidget(counterTable, 2);
+
+    refreshTimer.setInterval(kRefreshMs);
+    connect(&refreshTimer, &QTimer::timeout, this, &TracePanel::refresh);
+
+    resize(560, 520);
+}
+
+void TracePanel::showEvent(QShowEvent* e) {
+    QWidget::showEvent(e);
+    recordBox->setChecked(Tracer::enabled()); // may have been enabled from the environment
+    refresh();
+    refreshTimer.start();
+}
+
+void TracePanel::hideEvent(QHideEvent* e) {
+    QWidget::hideEvent(e);
+    refreshTimer.stop();
+}
+
+void TracePanel::setRecording(bool on) {
+    Tracer::setEnabled(on);
+    if (stalls) stalls->setActive(on);
+    refresh();
+}
+
+void TracePanel::saveTrace() {
+    const QString suggested = QDir::home().filePath(
+        "qtmusicplayer-" + QDateTime::currentDateTime().toString("yyyyMMdd-hhmmss") + ".trace.json");
+    const QString path = QFileDialog::getSaveFileName(this, "Save Trace", suggested, "Chrome trace (*.json)");
+    if (path.isEmpty()) return;
+
+    if (!Tracer::writeChromeTrace(path))
+        QMessageBox::warning(this, "Save Trace", "Could not write:\n" + path);
+}
+
+void TracePanel::resetTrace() {
+    Tracer::reset();
+    if (stalls) stalls->reset();
+    refresh();
+}
+
+void TracePanel::refresh() {
+    // Spans, slowest total first: the likely culprits sit at the top.
+    const QHash<QString, Tracer::SpanStats> spans = Tracer::spanStats();
+    std::vector<std::pair<QString, Tracer::SpanStats>> rows;
+    rows.reserve(spans.size());
+    for (auto it = spans.cbegin(); it != spans.cend(); ++it) rows.emplace_back(it.key(), it.value());
+    std::sort(rows.begin(), rows.end(),
+              [](const auto& a, const auto& b) { return a.second.totalNs > b.second.totalNs; });
+
+    spanTable->setRowCount(int(rows.size()));
+    for (int r = 0; r < int(rows.size()); ++r) {
+        const Tracer::SpanStats& s = rows[r].second;
+        spanTable->setItem(r, 0, new QTableWidgetItem(rows[r].first));
+        spanTable->setItem(r, 1, numberItem(double(s.count), 0));
+        spanTable->setItem(r, 2, numberItem(double(s.totalNs) / 1e6, 1));
+        spanTable->setItem(r, 3, numberItem(s.count ? double(s.totalNs) / 1e6 / double(s.count) : 0.0, 3));
+        spanTable->setItem(r, 4, numberItem(double(s.maxNs) / 1e6, 2));
+    }
+
+    const QHash<QString, double> counters = Tracer::counters();
+    QStringList names = counters.keys();
+    names.sort();
+    counterTable->setRowCount(names.size());
+    for (int r = 0; r < names.size(); ++r) {
+        const double v = counters.value(names[r]);
+        counterTable->setItem(r, 0, new QTableWidgetItem(names[r]));
+        counterTable->setItem(r, 1, numberItem(v, v == double(qint64(v)) ? 0 : 2));
+    }
+
+    QString status = QString("%1 events").arg(Tracer::eventCount());
+    if (const qint64 dropped = Tracer::droppedEvents()) status += QString(", %1 dropped (buffer full)").arg(dropped);
+    if (stalls)
+        status += QString(" · UI stalls over %1 ms: %2 (longest %3 ms)")
+                      .arg(StallDetector::kStallMs)
+                      .arg(stalls->stallCount())
+                      .arg(stalls->longestStallMs(), 0, 'f', 0);
+    statusLabel->setText(status);
+}
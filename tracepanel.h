@@ -0,0 +1,52 @@
+/*
+ * Author: Itoro Ifon, jason Hippolite, Prince Umeh
+ * Date: 2026-10-16
+ * Course/Assignment: C++ Project - Qt Music Player
+ * File: tracepanel.h
+ * Purpose: Declares TracePanel, the live diagnostics window (span timings,
+ *          counters, UI stalls) with trace recording controls.
+ */
+#pragma once
+
+#include <QWidget>
+#include <QTimer>
+
+class QCheckBox;
+class QLabel;
+class QPushButton;
+class QTableWidget;
+class StallDetector;
+
+// Class: TracePanel
+// Purpose: Tool window that turns tracing on and off, shows per-span totals
+//          and the latest counter values twice a second, and saves the
+//          recorded trace as Chrome-trace JSON for Perfetto.
+// Notes: Refreshes only while visible. Recording follows the checkbox, not
+//        the window: closing the panel keeps an ongoing recording going.
+class TracePanel : public QWidget {
+    Q_OBJECT
+public:
+    TracePanel(StallDetector* stalls, QWidget* parent = nullptr);
+
+protected:
+    void showEvent(QShowEvent* e) override;
+    void hideEvent(QHideEvent* e) override;
+
+private:
+    void setRecording(bool on);
+    void saveTrace();
+    void resetTrace();
+    void refresh();
+
+    static constexpr int kRefreshMs = 500;
+
+    StallDetector* stalls = nullptr;
+    QTimer refreshTimer;
+
+    QCheckBox* recordBox = nullptr;
+    QPushButton* saveBtn = nullptr;
+    QPushButton* resetBtn = nullptr;
+    QLabel* statusLabel = nullptr;
+    QTableWidget* spanTable = nullptr;
+    QTableWidget* counterTable = nullptr;
+};
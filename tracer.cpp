@@ -0,0 +1,276 @@
+/*
+ * Author: Itoro Ifon, jason Hippolite, Prince Umeh
+ * Date: 2026-10-16
+ * Course/Assignment: C++ Project - Qt Music Player
+ * File: tracer.cpp
+ * Purpose: Implements the per-thread trace buffers, the Chrome-trace JSON
+ *          writer and the GUI-thread stall detector.
+ */
+#include "tracer.h"
+
+#include <QCoreApplication>
+#include <QMutex>
+#include <QMutexLocker>
+#include <QSaveFile>
+#include <QThread>
+
+#include <algorithm>
+#include <chrono>
+#include <memory>
+#include <vector>
+
+namespace {
+
+// ========================= Buffers =========================
+struct Event {
+    const char* name;
+    qint64 startNs;
+    qint64 durNs;   // spans
+    double value;   // counters
+    char phase;     // 'X' span, 'C' counter
+};
+
+// One per thread that ever recorded. The lock is only contended while the
+// panel or the writer reads the buffer.
+struct ThreadBuffer {
+    QMutex lock;
+    std::vector<Event> events;
+    QHash<const char*, Tracer::SpanStats> stats;
+    qint64 dropped = 0;
+    int tid = 0;
+    QString name;
+};
+
+struct Registry {
+    QMutex lock;
+    std::vector<std::shared_ptr<ThreadBuffer>> buffers;
+    QHash<QString, double> counters;
+};
+
+Registry& registry() {
+    static Registry r;
+    return r;
+}
+
+// The registry keeps buffers alive after their thread exits, so pooled
+// threads that come and go still show up in the trace.
+ThreadBuffer& localBuffer() {
+    thread_local std::shared_ptr<ThreadBuffer> mine;
+    if (!mine) {
+        mine = std::make_shared<ThreadBuffer>();
+        QThread* t = QThread::currentThread();
+        QCoreApplication* app = QCoreApplication::instance();
+        if (app && t == app->thread()) mine->name = "GUI";
+        else if (!t->objectName().isEmpty()) mine->name = t->objectName();
+
+        Registry& r = registry();
+        QMutexLocker guard(&r.lock);
+        mine->tid = int(r.buffers.size()) + 1;
+        if (mine->name.isEmpty()) mine->name = QString("Worker %1").arg(mine->tid);
+        r.buffers.push_back(mine);
+    }
+    return *mine;
+}
+
+std::vector<std::shared_ptr<ThreadBuffer>> allBuffers() {
+    Registry& r = registry();
+    QMutexLocker guard(&r.lock);
+    return r.buffers;
+}
+
+void append(ThreadBuffer& b, const Event& e) {
+    if (b.events.size() >= size_t(Tracer::kMaxEventsPerThread)) {
+        ++b.dropped;
+        return;
+    }
+    if (b.events.capacity() == 0) b.events.reserve(4096);
+    b.events.push_back(e);
+}
+
+// ========================= JSON =========================
+QByteArray jsonString(const char* s) {
+    QByteArray out("\"");
+    for (const char* p = s; *p; ++p) {
+        const char c = *p;
+        if (c == '"' || c == '\\') out += '\\';
+        if (static_cast<unsigned char>(c) < 0x20) { out += ' '; continue; }
+        out += c;
+    }
+    out += '"';
+    return out;
+}
+
+QByteArray micros(qint64 ns) {
+    return QByteArray::number(double(ns) / 1000.0, 'f', 3);
+}
+
+} // namespace
+
+// ========================= Tracer =========================
+std::atomic<bool> Tracer::on{false};
+
+void Tracer::setEnabled(bool enable) {
+    nowNs(); // pin the time origin before the first span
+    on.store(enable, std::memory_order_relaxed);
+}
+
+qint64 Tracer::nowNs() {
+    using Clock = std::chrono::steady_clock;
+    static const Clock::time_point origin = Clock::now();
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(Clock::now() - origin).count();
+}
+
+void Tracer::complete(const char* name, qint64 startNs, qint64 endNs) {
+    ThreadBuffer& b = localBuffer();
+    const qint64 dur = endNs - startNs;
+
+    QMutexLocker guard(&b.lock);
+    SpanStats& s = b.stats[name];
+    ++s.count;
+    s.totalNs += dur;
+    if (dur > s.maxNs) s.maxNs = dur;
+    append(b, {name, startNs, dur, 0.0, 'X'});
+}
+
+void Tracer::recordCounter(const char* name, double value) {
+    const qint64 now = nowNs();
+    {
+        Registry& r = registry();
+        QMutexLocker guard(&r.lock);
+        r.counters[QString::fromLatin1(name)] = value;
+    }
+
+    ThreadBuffer& b = localBuffer();
+    QMutexLocker guard(&b.lock);
+    append(b, {name, now, 0, value, 'C'});
+}
+
+QHash<QString, Tracer::SpanStats> Tracer::spanStats() {
+    QHash<QString, SpanStats> merged;
+    for (const auto& b : allBuffers()) {
+        QMutexLocker guard(&b->lock);
+        for (auto it = b->stats.cbegin(); it != b->stats.cend(); ++it) {
+            SpanStats& m = merged[QString::fromLatin1(it.key())];
+            m.count += it->count;
+            m.totalNs += it->totalNs;
+            m.maxNs = std::max(m.maxNs, it->maxNs);
+        }
+    }
+    return merged;
+}
+
+QHash<QString, double> Tracer::counters() {
+    Registry& r = registry();
+    QMutexLocker guard(&r.lock);
+    return r.counters;
+}
+
+qint64 Tracer::eventCount() {
+    qint64 n = 0;
+    for (const auto& b : allBuffers()) {
+        QMutexLocker guard(&b->lock);
+        n += qint64(b->events.size());
+    }
+    return n;
+}
+
+qint64 Tracer::droppedEvents() {
+    qint64 n = 0;
+    for (const auto& b : allBuffers()) {
+        QMutexLocker guard(&b->lock);
+        n += b->dropped;
+    }
+    return n;
+}
+
+void Tracer::reset() {
+    for (const auto& b : allBuffers()) {
+        QMutexLocker guard(&b->lock);
+        b->events.clear();
+        b->stats.clear();
+        b->dropped = 0;
+    }
+    Registry& r = registry();
+    QMutexLocker guard(&r.lock);
+    r.counters.clear();
+}
+
+// Chrome trace event format ("X" complete events, "C" counters, "M" thread
+// names); loads in chrome://tracing and ui.perfetto.dev.
+bool Tracer::writeChromeTrace(const QString& path) {
+    QSaveFile f(path);
+    if (!f.open(QIODevice::WriteOnly)) return false;
+
+    f.write("{\"displayTimeUnit\":\"ms\",\"traceEvents\":[\n");
+    bool first = true;
+    auto emitLine = [&](const QByteArray& line) {
+        if (!first) f.write(",\n");
+        first = false;
+        f.write(line);
+    };
+
+    for (const auto& b : allBuffers()) {
+        std::vector<Event> events;
+        QString threadName;
+        int tid = 0;
+        {
+            QMutexLocker guard(&b->lock); // copy out; recording goes on meanwhile
+            events = b->events;
+            threadName = b->name;
+            tid = b->tid;
+        }
+        const QByteArray tidText = QByteArray::number(tid);
+
+        emitLine("{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":" + tidText
+                 + ",\"args\":{\"name\":" + jsonString(threadName.toUtf8().constData()) + "}}");
+
+        for (const Event& e : events) {
+            QByteArray line = "{\"name\":" + jsonString(e.name) + ",\"ph\":\"" + e.phase
+                              + "\",\"pid\":1,\"tid\":" + tidText + ",\"ts\":" + micros(e.startNs);
+            if (e.phase == 'X') line += ",\"dur\":" + micros(e.durNs);
+            else line += ",\"args\":{\"value\":" + QByteArray::number(e.value, 'g', 12) + "}";
+            line += '}';
+            emitLine(line);
+        }
+    }
+
+    f.write("\n]}\n");
+    return f.commit();
+}
+
+// ========================= StallDetector =========================
+StallDetector::StallDetector(QObject* parent) : QObject(parent) {
+    beat.setTimerType(Qt::PreciseTimer);
+    beat.setInterval(kBeatMs);
+    connect(&beat, &QTimer::timeout, this, &StallDetector::onBeat);
+}
+
+void StallDetector::setActive(bool active) {
+    if (active == beat.isActive()) return;
+    if (active) {
+        lastBeatNs = Tracer::nowNs();
+        beat.start();
+    } else {
+        beat.stop();
+    }
+}
+
+void StallDetector::reset() {
+    stalls = 0;
+    longestMs = 0.0;
+}
+
+void StallDetector::onBeat() {
+    const qint64 now = Tracer::nowNs();
+    const qint64 expected = lastBeatNs + qint64(kBeatMs) * 1000000;
+    lastBeatNs = now;
+
+    const double lateMs = double(now - expected) / 1e6;
+    if (lateMs < kStallMs) return;
+
+    ++stalls;
+    longestMs = std::max(longestMs, lateMs);
+    Tracer::complete("UI stall", expected, now);
+    Tracer::counter("ui.stalls", stalls);
+    emit stallDetected(lateMs);
+}
@@ -0,0 +1,123 @@
+/*
+ * Author: Itoro Ifon, jason Hippolite, Prince Umeh
+ * Date: 2026-10-16
+ * Course/Assignment: C++ Project - Qt Music Player
+ * File: tracer.h
+ * Purpose: Declares Tracer (scoped timing spans and counters written out as
+ *          a Chrome-trace / Perfetto JSON file) and StallDetector (reports
+ *          stretches where the GUI thread stopped servicing events).
+ */
+#pragma once
+
+#include <QObject>
+#include <QString>
+#include <QHash>
+#include <QTimer>
+
+#include <atomic>
+
+// Class: Tracer
+// Purpose: Process-wide, off by default. While enabled, TRACE_SCOPE spans and
+//          counters are appended to a per-thread buffer (no cross-thread
+//          contention) and summed per span name for the live panel.
+// Notes: Disabled cost is one relaxed atomic load and a branch per site, so
+//        builds ship with tracing compiled in. Define QTMUSICPLAYER_NO_TRACING
+//        to compile the sites out entirely.
+//        Span and counter names must be string literals (stored by pointer).
+class Tracer {
+public:
+    static bool enabled() { return on.load(std::memory_order_relaxed); }
+    static void setEnabled(bool enable);
+
+    // Monotonic nanoseconds since the tracer was first used.
+    static qint64 nowNs();
+
+    // A finished span on the calling thread; TRACE_SCOPE calls this.
+    static void complete(const char* name, qint64 startNs, qint64 endNs);
+
+    // Latest value of a named counter (shown in the panel, plotted in Perfetto).
+    static void counter(const char* name, double value) {
+        if (enabled()) recordCounter(name, value);
+    }
+
+    struct SpanStats {
+        qint64 count = 0;
+        qint64 totalNs = 0;
+        qint64 maxNs = 0;
+    };
+    static QHash<QString, SpanStats> spanStats(); // merged over all threads
+    static QHash<QString, double> counters();
+    static qint64 eventCount();
+    static qint64 droppedEvents();                // buffers full
+
+    // Writes everything recorded so far. Safe while recording continues.
+    static bool writeChromeTrace(const QString& path);
+    static void reset();
+
+    static constexpr int kMaxEventsPerThread = 1 << 18;
+
+private:
+    static void recordCounter(const char* name, double value);
+    static std::atomic<bool> on;
+};
+
+// Class: TraceSpan
+// Purpose: Times the enclosing scope when tracing was on at its start.
+class TraceSpan {
+public:
+    explicit TraceSpan(const char* spanName)
+        : name(spanName), startNs(Tracer::enabled() ? Tracer::nowNs() : -1) {}
+    ~TraceSpan() {
+        if (startNs >= 0) Tracer::complete(name, startNs, Tracer::nowNs());
+    }
+
+    TraceSpan(const TraceSpan&) = delete;
+    TraceSpan& operator=(const TraceSpan&) = delete;
+
+private:
+    const char* name;
+    qint64 startNs;
+};
+
+#ifdef QTMUSICPLAYER_NO_TRACING
+#define TRACE_SCOPE(name) do {} while (0)
+#define TRACE_COUNTER(name, value) do {} while (0)
+#else
+#define QMP_TRACE_CONCAT2(a, b) a##b
+#define QMP_TRACE_CONCAT(a, b) QMP_TRACE_CONCAT2(a, b)
+#define TRACE_SCOPE(name) TraceSpan QMP_TRACE_CONCAT(traceSpan_, __LINE__)(name)
+#define TRACE_COUNTER(name, value) Tracer::counter(name, double(value))
+#endif
+
+// Class: StallDetector
+// Purpose: A heartbeat timer on the GUI thread. When a beat arrives more than
+//          kStallMs late, the thread was blocked: the gap is recorded as a
+//          "UI stall" span (so Perfetto shows it next to whatever span ran
+//          long) and counted.
+// Notes: Only beats while active; MainWindow keeps it in step with Tracer.
+class StallDetector : public QObject {
+    Q_OBJECT
+public:
+    explicit StallDetector(QObject* parent = nullptr);
+
+    void setActive(bool active);
+    bool isActive() const { return beat.isActive(); }
+
+    int stallCount() const { return stalls; }
+    double longestStallMs() const { return longestMs; }
+    void reset();
+
+    static constexpr int kBeatMs = 20;
+    static constexpr int kStallMs = 50;
+
+signals:
+    void stallDetected(double ms);
+
+private:
+    void onBeat();
+
+    QTimer beat;
+    qint64 lastBeatNs = 0;
+    int stalls = 0;
+    double longestMs = 0.0;
+};
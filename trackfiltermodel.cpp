@@ -0,0 +1,193 @@
+/*
+ * Author: Itoro Ifon, jason Hippolite, Prince Umeh
+ * Date: 2026-10-16
+ * Course/Assignment: C++ Project - Qt Music Player
+ * File: trackfiltermodel.cpp
+ * Purpose: Implements the debounced, incremental library search filter.
+ */
+#include "trackfiltermodel.h"
+#include "tracer.h"
+
+#include <QElapsedTimer>
+
+#include <algorithm>
+
+// ===== Filter Title OR Artist OR Lyrics =====
+const LibraryModel* TrackFilterModel::library() const {
+    return static_cast<const LibraryModel*>(sourceModel());
+}
+
+LibraryModel* TrackFilterModel::library() {
+    return static_cast<LibraryModel*>(sourceModel());
+}
+
+TrackFilterModel::TrackFilterModel(QObject* parent) : QSortFilterProxyModel(parent) {
+    debounce.setSingleShot(true);
+    debounce.setInterval(kDebounceMs);
+    connect(&debounce, &QTimer::timeout, this, [this] { applyQuery(pendingQuery); });
+}
+
+void TrackFilterModel::setQuery(const QString& text) {
+    pendingQuery = text;
+
+    // Clearing the box should feel instant; typing is coalesced.
+    if (text.isEmpty()) {
+        debounce.stop();
+        applyQuery(text);
+        return;
+    }
+    debounce.start();
+}
+
+void TrackFilterModel::setSourceModel(QAbstractItemModel* source) {
+    QSortFilterProxyModel::setSourceModel(source);
+    // A sort moves matches between fetched and unfetched rows.
+    connect(source, &QAbstractItemModel::layoutChanged, this, [this] {
+        if (!currentQuery.isEmpty()) unexposedMatchRows();
+    });
+}
+
+void TrackFilterModel::applyQuery(const QString& text) {
+    const quint64 generation = ++passGeneration; // any older pass is now stale
+
+    pass = Pass();
+    pass.query = text;
+
+    if (text.isEmpty()) {
+        finishPass();
+        return;
+    }
+    if (currentQuery.isEmpty()) exposedBeforeQuery = library()->exposedRows();
+
+    const QString folded = SearchIndex::normalize(text);
+    const QString previous = SearchIndex::normalize(currentQuery);
+    // A short query leaves lyrics out, so a longer one cannot refine it.
+    const bool refines = !previous.isEmpty() && folded.contains(previous)
+                         && (previous.size() >= SearchIndex::kGramLength || folded.size() < SearchIndex::kGramLength);
+
+    if (refines) {
+        // Every match of the longer query matched the shorter one, so only
+        // the previous matches need re-checking. Rows newer than the old pass
+        // keep being checked one by one.
+        pass.candidates = currentMatches;
+        pass.queriedUpTo = queriedUpTo;
+    } else {
+        pass.candidates = library()->candidates(text);
+        pass.queriedUpTo = library()->store().idLimit();
+    }
+    pass.matches.reserve(pass.candidates.size());
+
+    runPassSlice(generation);
+}
+
+void TrackFilterModel::runPassSlice(quint64 generation) {
+    if (generation != passGeneration) return; // superseded by a newer query
+    TRACE_SCOPE("TrackFilterModel::passSlice");
+
+    QElapsedTimer clock;
+    clock.start();
+
+    const LibraryModel* lib = library();
+    while (pass.pos < pass.candidates.size()) {
+        const TrackId id = pass.candidates[pass.pos++];
+        if (lib->idMatches(id, pass.query)) pass.matches << id;
+
+        if ((pass.pos & 255) == 0 && clock.elapsed() >= kSliceMs) {
+            // Yield to the event loop so keystrokes and repaints get through.
+            QTimer::singleShot(0, this, [this, generation] { runPassSlice(generation); });
+            return;
+        }
+    }
+
+    finishPass();
+}
+
+void TrackFilterModel::finishPass() {
+    const bool wasFiltering = !currentQuery.isEmpty();
+    currentQuery = pass.query;
+    currentMatches = std::move(pass.matches);
+    queriedUpTo = pass.queriedUpTo;
+
+    accepted.assign(queriedUpTo, false);
+    for (TrackId id : currentMatches) accepted[id] = true;
+
+    pass = Pass();
+    if (currentQuery.isEmpty()) {
+        lastMatchRow = -1;
+        if (wasFiltering) library()->collapseTo(exposedBeforeQuery); // back to what the view had fetched
+    }
+    {
+        TRACE_SCOPE("TrackFilterModel::filterAcceptsRow batch"); // one call per row
+        invalidateFilter();
+    }
+    if (!currentQuery.isEmpty()) exposeMatches();
+    emit queryApplied();
+}
+
+// ========================= Lazy rows =========================
+// Tracks streamed in after the pass are verified once, here, so fetching
+// needs only the match list.
+void TrackFilterModel::absorbNewTracks() {
+    const TrackStore& store = library()->store();
+    const TrackId limit = store.idLimit();
+    if (queriedUpTo >= limit) return;
+
+    accepted.resize(limit, false);
+    for (TrackId id = queriedUpTo; id < limit; ++id) {
+        if (!library()->idMatches(id, currentQuery)) continue;
+        currentMatches << id;
+        accepted[id] = true;
+    }
+    queriedUpTo = limit;
+}
+
+QVector<int> TrackFilterModel::unexposedMatchRows() {
+    const TrackStore& store = library()->store();
+    const int from = library()->exposedRows();
+    QVector<int> rows;
+    lastMatchRow = -1;
+    for (TrackId id : currentMatches) {
+        const int row = store.rowOf(id);
+        lastMatchRow = std::max(lastMatchRow, row);
+        if (row >= from) rows << row;
+    }
+    return rows;
+}
+
+void TrackFilterModel::exposeMatches() {
+    TRACE_SCOPE("TrackFilterModel::exposeMatches");
+    absorbNewTracks();
+    QVector<int> rows = unexposedMatchRows();
+    if (rows.isEmpty()) return;
+
+    const int n = std::min<int>(rows.size(), LibraryModel::kFetchBatch);
+    std::nth_element(rows.begin(), rows.begin() + (n - 1), rows.end());
+    library()->exposeUpTo(rows[n - 1]);
+}
+
+bool TrackFilterModel::canFetchMore(const QModelIndex& parent) const {
+    if (currentQuery.isEmpty()) return QSortFilterProxyModel::canFetchMore(parent);
+    if (parent.isValid()) return false;
+    const LibraryModel* lib = library();
+    return lastMatchRow >= lib->exposedRows()
+           || (queriedUpTo < lib->store().idLimit() && lib->canFetchMore(QModelIndex()));
+}
+
+void TrackFilterModel::fetchMore(const QModelIndex& parent) {
+    if (currentQuery.isEmpty()) {
+        QSortFilterProxyModel::fetchMore(parent);
+        return;
+    }
+    if (!parent.isValid()) exposeMatches();
+}
+
+bool TrackFilterModel::filterAcceptsRow(int row, const QModelIndex& parent) const {
+    Q_UNUSED(parent);
+    if (currentQuery.isEmpty()) return true;
+
+    const TrackId id = library()->store().idAt(row);
+
+    // Rows appended after the query ran (scan still streaming) are checked directly.
+    if (id >= queriedUpTo) return library()->rowMatches(row, currentQuery);
+    return accepted[id];
+}
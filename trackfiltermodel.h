@@ -0,0 +1,83 @@
+/*
+ * Author: Itoro Ifon, jason Hippolite, Prince Umeh
+ * Date: 2026-10-16
+ * Course/Assignment: C++ Project - Qt Music Player
+ * File: trackfiltermodel.h
+ * Purpose: Declares TrackFilterModel, the search proxy between the library
+ *          model and the playlist view.
+ */
+#pragma once
+
+#include <QSortFilterProxyModel>
+#include <QString>
+#include <QVector>
+#include <QTimer>
+
+#include <vector>
+
+#include "librarymodel.h"
+
+// Class: TrackFilterModel
+// Purpose: Filters the library by title, artist or lyrics (case-insensitive
+//          substring) through the library's search index. The source model
+//          must be a LibraryModel.
+// Notes: setQuery() is debounced. A query that extends the applied one only
+//        re-checks the previous matches, and candidates are verified in time
+//        slices so a newer query abandons the stale pass. Filtering keeps the
+//        library's lazy rows: matches are found by track ID, and fetchMore()
+//        exposes source rows only up to the next kFetchBatch matches, so the
+//        rows past the last match are never fetched. Clearing the query hands
+//        the rows fetched for it back to the library.
+class TrackFilterModel : public QSortFilterProxyModel {
+    Q_OBJECT
+public:
+    explicit TrackFilterModel(QObject* parent = nullptr);
+
+    void setQuery(const QString& text);   // debounced
+    void applyQuery(const QString& text); // starts a pass right away
+    const QString& query() const { return currentQuery; }
+    int matchCount() const { return currentMatches.size(); } // fetched or not
+
+    void setSourceModel(QAbstractItemModel* source) override; // must be a LibraryModel
+    bool canFetchMore(const QModelIndex& parent) const override;
+    void fetchMore(const QModelIndex& parent) override;
+
+signals:
+    void queryApplied();
+
+protected:
+    bool filterAcceptsRow(int row, const QModelIndex& parent) const override;
+
+private:
+    const LibraryModel* library() const;
+    LibraryModel* library();
+    void runPassSlice(quint64 generation);
+    void finishPass();
+    void absorbNewTracks();
+    QVector<int> unexposedMatchRows(); // also refreshes lastMatchRow
+    void exposeMatches();
+
+    static constexpr int kDebounceMs = 120;
+    static constexpr int kSliceMs = 8;
+
+    QTimer debounce;
+    QString pendingQuery;
+
+    // Applied state, read by filterAcceptsRow()
+    QString currentQuery;
+    QVector<TrackId> currentMatches;
+    std::vector<bool> accepted;   // indexed by TrackId
+    TrackId queriedUpTo = 0;      // IDs at or above this are checked row by row
+    int lastMatchRow = -1;        // highest source row of a match, as of the last look
+    int exposedBeforeQuery = 0;   // library rows fetched when filtering began
+
+    // In-flight pass
+    struct Pass {
+        QString query;
+        QVector<TrackId> candidates;
+        QVector<TrackId> matches;
+        int pos = 0;
+        TrackId queriedUpTo = 0;
+    } pass;
+    quint64 passGeneration = 0;
+};
@@ -0,0 +1,234 @@
+/*
+ * Author: Itoro Ifon, jason Hippolite, Prince Umeh
+ * Date: 2026-10-16
+ * Course/Assignment: C++ Project - Qt Music Player
+ * File: trackstore.cpp
+ * Purpose: Implements TrackStore's hash-indexed, column-oriented track list.
+ */
+#include "trackstore.h"
+
+TrackId TrackStore::add(const ScannedTrack& t) {
+    if (idByPath.contains(t.path)) return kNoTrack;
+
+    const TrackId id = nextId++;
+    idByPath.insert(t.path, id);
+    if (!rowIndexStale) rowById.insert(id, ids.size());
+
+    ids.append(id);
+    paths.append(t.path);
+    titles.append(t.title);
+    artists.append(t.artist);
+    albums.append(t.album);
+    trackNumbers.append(t.trackNumber);
+    durations.append(t.durationMs);
+    lyrics.append(lyricsStore.add(t.packedLyrics.isEmpty() ? LyricsStore::pack(t.lyrics) : t.packedLyrics));
+    loudness.append(t.loudness);
+    playCounts.append(t.playCount);
+    contentHashes.append(t.contentHash);
+    keys.append(t.sortKeys.path.isEmpty() ? CollationKey::forTrack(t.title, t.artist, t.album, t.path) : t.sortKeys);
+    return id;
+}
+
+void TrackStore::reserve(int n) {
+    ids.reserve(n);
+    paths.reserve(n);
+    titles.reserve(n);
+    artists.reserve(n);
+    albums.reserve(n);
+    trackNumbers.reserve(n);
+    durations.reserve(n);
+    lyrics.reserve(n);
+    loudness.reserve(n);
+    playCounts.reserve(n);
+    contentHashes.reserve(n);
+    keys.reserve(n);
+    idByPath.reserve(n);
+    rowById.reserve(n);
+}
+
+int TrackStore::rowOf(TrackId id) const {
+    if (rowIndexStale) rebuildRowIndex();
+    return rowById.value(id, -1);
+}
+
+// Moves the kept rows down over the removed ones, then trims the tail.
+template <typename T>
+static void compactColumn(QVector<T>& column, const QVector<int>& rows) {
+    int write = rows.first();
+    int next = 0;
+    for (int read = rows.first(); read < column.size(); ++read) {
+        if (next < rows.size() && rows[next] == read) {
+            ++next;
+            continue;
+        }
+        column[write++] = std::move(column[read]);
+    }
+    column.resize(write);
+}
+
+void TrackStore::removeRows(const QVector<int>& rows) {
+    if (rows.isEmpty() || rows.first() < 0 || rows.last() >= ids.size()) return;
+    for (int row : rows) idByPath.remove(paths[row]);
+    compactColumn(ids, rows);
+    compactColumn(paths, rows);
+    compactColumn(titles, rows);
+    compactColumn(artists, rows);
+    compactColumn(albums, rows);
+    compactColumn(trackNumbers, rows);
+    compactColumn(durations, rows);
+    compactColumn(lyrics, rows);
+    compactColumn(loudness, rows);
+    compactColumn(playCounts, rows);
+    compactColumn(contentHashes, rows);
+    compactColumn(keys, rows);
+    rowIndexStale = true;
+}
+
+bool TrackStore::setPath(int row, const QString& path) {
+    if (row < 0 || row >= ids.size() || idByPath.contains(path)) return false;
+    idByPath.remove(paths[row]);
+    idByPath.insert(path, ids[row]);
+    paths[row] = path;
+    keys[row].path = CollationKey::make(path);
+    return true;
+}
+
+void TrackStore::move(int from, int to) {
+    if (from < 0 || from >= ids.size() || to < 0 || to >= ids.size() || from == to) return;
+    ids.move(from, to);
+    paths.move(from, to);
+    titles.move(from, to);
+    artists.move(from, to);
+    albums.move(from, to);
+    trackNumbers.move(from, to);
+    durations.move(from, to);
+    lyrics.move(from, to);
+    loudness.move(from, to);
+    playCounts.move(from, to);
+    contentHashes.move(from, to);
+    keys.move(from, to);
+    rowIndexStale = true;
+}
+
+void TrackStore::clear() {
+    ids.clear();
+    paths.clear();
+    titles.clear();
+    artists.clear();
+    albums.clear();
+    trackNumbers.clear();
+    durations.clear();
+    lyrics.clear();
+    lyricsStore.clear();
+    loudness.clear();
+    playCounts.clear();
+    contentHashes.clear();
+    keys.clear();
+    idByPath.clear();
+    rowById.clear();
+    rowIndexStale = false;
+}
+
+// ========================= Sorting =========================
+QVector<int> TrackStore::sortedOrder(SortField field, Qt::SortOrder direction) const {
+    if (field == SortField::Duration) return CollationKey::order(durations, direction);
+
+    QVector<const QByteArray*> column;
+    column.reserve(keys.size());
+    for (const SortKeys& k : keys) {
+        switch (field) {
+        case SortField::Title:  column << &k.title; break;
+        case SortField::Artist: column << &k.artist; break;
+        case SortField::Album:  column << &k.album; break;
+        default:                column << &k.path; break;
+        }
+    }
+    return CollationKey::order(column, direction);
+}
+
+template <typename T>
+static void permuteColumn(QVector<T>& column, const QVector<int>& order) {
+    QVector<T> out;
+    out.reserve(column.size());
+    for (int from : order) out.append(std::move(column[from]));
+    column = std::move(out);
+}
+
+void TrackStore::permute(const QVector<int>& order) {
+    if (order.size() != ids.size()) return;
+    permuteColumn(ids, order);
+    permuteColumn(paths, order);
+    permuteColumn(titles, order);
+    permuteColumn(artists, order);
+    permuteColumn(albums, order);
+    permuteColumn(trackNumbers, order);
+    permuteColumn(durations, order);
+    permuteColumn(lyrics, order);
+    permuteColumn(loudness, order);
+    permuteColumn(playCounts, order);
+    permuteColumn(contentHashes, order);
+    permuteColumn(keys, order);
+    rowIndexStale = true;
+}
+
+// ========================= Duplicates =========================
+QVector<QVector<TrackId>> TrackStore::duplicateGroups() const {
+    QHash<quint64, int> groupOf; // hash -> index in `groups`, or -1 - row of a lone first sighting
+    QVector<QVector<TrackId>> groups;
+    for (int r = 0; r < ids.size(); ++r) {
+        const quint64 h = contentHashes[r];
+        if (h == 0) continue;
+        auto it = groupOf.find(h);
+        if (it == groupOf.end()) {
+            groupOf.insert(h, -1 - r);
+        } else if (*it < 0) {
+            const int first = -1 - *it;
+            *it = groups.size();
+            groups.push_back({ids[first], ids[r]});
+        } else {
+            groups[*it].push_back(ids[r]);
+        }
+    }
+    return groups;
+}
+
+void TrackStore::rebuildRowIndex() const {
+    rowById.clear();
+    rowById.reserve(ids.size());
+    for (int r = 0; r < ids.size(); ++r) rowById.insert(ids[r], r);
+    rowIndexStale = false;
+}
+
+// ========================= Memory accounting =========================
+static qint64 stringHeapBytes(const QString& s) {
+    // QArrayData header + UTF-16 payload; empty strings share a static block.
+    return s.isEmpty() ? 0 : qint64(sizeof(QArrayData)) + qint64(s.capacity() + 1) * qint64(sizeof(QChar));
+}
+
+static qint64 bytesHeapBytes(const QByteArray& b) {
+    return b.isEmpty() ? 0 : qint64(sizeof(QArrayData)) + qint64(b.capacity() + 1);
+}
+
+qint64 TrackStore::memoryUsage() const {
+    const qint64 n = ids.size();
+
+    qint64 bytes = ids.capacity() * qint64(sizeof(TrackId));
+    bytes += (paths.capacity() + titles.capacity() + artists.capacity() + albums.capacity()) * qint64(sizeof(QString));
+    bytes += lyrics.capacity() * qint64(sizeof(LyricsRef)) + lyricsStore.residentBytes();
+    bytes += trackNumbers.capacity() * qint64(sizeof(int)) + durations.capacity() * qint64(sizeof(qint64));
+    bytes += loudness.capacity() * qint64(sizeof(TrackLoudness)) + keys.capacity() * qint64(sizeof(SortKeys));
+    bytes += playCounts.capacity() * qint64(sizeof(quint32)) + contentHashes.capacity() * qint64(sizeof(quint64));
+
+    for (int r = 0; r < n; ++r) {
+        // Paths are implicitly shared with idByPath, so count them once.
+        bytes += stringHeapBytes(paths[r]) + stringHeapBytes(titles[r])
+                 + stringHeapBytes(artists[r]) + stringHeapBytes(albums[r]);
+        const SortKeys& k = keys[r];
+        bytes += bytesHeapBytes(k.title) + bytesHeapBytes(k.artist) + bytesHeapBytes(k.album) + bytesHeapBytes(k.path);
+    }
+
+    // Hash nodes: key + value + roughly one span slot of bookkeeping each.
+    bytes += idByPath.capacity() * qint64(sizeof(QString) + sizeof(TrackId) + 1);
+    bytes += rowById.capacity() * qint64(sizeof(TrackId) + sizeof(int) + 1);
+    return bytes;
+}
@@ -0,0 +1,107 @@
+/*
+ * Author: Itoro Ifon, jason Hippolite, Prince Umeh
+ * Date: 2026-10-16
+ * Course/Assignment: C++ Project - Qt Music Player
+ * File: trackstore.h
+ * Purpose: Declares TrackStore, the playlist's single source of truth: track
+ *          columns in display order plus hash indexes by path and by track ID.
+ */
+#pragma once
+
+#include <QString>
+#include <QVector>
+#include <QHash>
+
+#include "collationkey.h"
+#include "libraryscanner.h"
+#include "lyricsstore.h"
+
+// Stable identifier for a track. IDs are never reused while the store lives,
+// so they survive row moves and removals. 0 means "no track".
+using TrackId = quint32;
+static constexpr TrackId kNoTrack = 0;
+
+// Class: TrackStore
+// Purpose: Ordered track list stored column by column (struct of arrays), with
+//          O(1) duplicate checks (hash on path) and O(1) row <-> ID lookups.
+//          Removing or moving rows only marks the row index stale; it is
+//          rebuilt once on the next ID lookup.
+// Notes: Lyrics are kept compressed in a LyricsStore; lyricsAt() unpacks.
+//        Every row carries CollationKey sort keys, so sortedOrder() only
+//        compares bytes. Row order is the play order, so removal keeps it:
+//        removeRows() compacts every column in one pass from the first
+//        removed row, so a batch costs what a single removal does, and the
+//        row index is rebuilt once for the whole batch.
+class TrackStore {
+public:
+    // Returns the new track's ID, or kNoTrack if the path is already present.
+    TrackId add(const ScannedTrack& t);
+    void reserve(int n);
+
+    bool contains(const QString& path) const { return idByPath.contains(path); }
+    TrackId idOfPath(const QString& path) const { return idByPath.value(path, kNoTrack); }
+    int rowOf(TrackId id) const;
+    TrackId idLimit() const { return nextId; } // every ID handed out is below this
+
+    int size() const { return ids.size(); }
+    bool isEmpty() const { return ids.isEmpty(); }
+    TrackId idAt(int row) const { return ids[row]; }
+    const QString& pathAt(int row) const { return paths[row]; }
+    const QString& titleAt(int row) const { return titles[row]; }
+    const QString& artistAt(int row) const { return artists[row]; }
+    const QString& albumAt(int row) const { return albums[row]; }
+    int trackNumberAt(int row) const { return trackNumbers[row]; }
+    qint64 durationMsAt(int row) const { return durations[row]; }
+    QString lyricsAt(int row) const { return lyricsStore.text(lyrics[row]); } // decoded on each call
+    bool hasLyrics(int row) const { return lyrics[row].size > 0; }
+    const TrackLoudness& loudnessAt(int row) const { return loudness[row]; }
+    quint32 playCountAt(int row) const { return playCounts[row]; }
+    quint64 contentHashAt(int row) const { return contentHashes[row]; } // 0: not hashed yet
+    const SortKeys& sortKeysAt(int row) const { return keys[row]; }
+
+    enum class SortField { Title, Artist, Album, Duration, Path };
+    // Permutation for permute(): new row i holds old row order[i].
+    QVector<int> sortedOrder(SortField field, Qt::SortOrder direction) const;
+    void permute(const QVector<int>& order);
+
+    void removeAt(int row) { removeRows({row}); }
+    void removeRows(const QVector<int>& rows); // ascending, no repeats
+    bool setPath(int row, const QString& path); // false if `path` is taken
+    void setLoudness(int row, const TrackLoudness& l) { loudness[row] = l; }
+    void setPlayCount(int row, quint32 count) { playCounts[row] = count; }
+    void setContentHash(int row, quint64 hash) { contentHashes[row] = hash; }
+
+    // Tracks sharing a content hash, two or more per group, each group and
+    // the groups in row order.
+    QVector<QVector<TrackId>> duplicateGroups() const;
+    void move(int from, int to);
+    void clear();
+
+    // Approximate heap + inline bytes held for all tracks, indexes included.
+    qint64 memoryUsage() const;
+    const LyricsStore& lyricsPool() const { return lyricsStore; }
+
+private:
+    void rebuildRowIndex() const;
+
+    // Columns, all indexed by row
+    QVector<TrackId> ids;
+    QVector<QString> paths;
+    QVector<QString> titles;
+    QVector<QString> artists;
+    QVector<QString> albums;
+    QVector<int> trackNumbers;
+    QVector<qint64> durations; // ms, 0 when unknown
+    QVector<LyricsRef> lyrics;
+    QVector<TrackLoudness> loudness;
+    QVector<quint32> playCounts;
+    QVector<quint64> contentHashes;
+    QVector<SortKeys> keys;
+
+    LyricsStore lyricsStore;
+
+    QHash<QString, TrackId> idByPath;
+    mutable QHash<TrackId, int> rowById;
+    mutable bool rowIndexStale = false;
+    TrackId nextId = 1;
+};
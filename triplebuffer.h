@@ -0,0 +1,47 @@
+/*
+ * Author: Itoro Ifon, jason Hippolite, Prince Umeh
+ * Date: 2026-10-16
+ * Course/Assignment: C++ Project - Qt Music Player
+ * File: triplebuffer.h
+ * Purpose: Declares TripleBuffer, a wait-free single-writer/single-reader
+ *          hand-over of the latest value of a plain struct.
+ */
+#pragma once
+
+#include <atomic>
+
+// Class: TripleBuffer
+// Purpose: Lets one thread publish settings that another thread (e.g. the
+//          audio callback) picks up without locks or allocation. The writer
+//          fills its own slot and swaps it with the shared middle slot; the
+//          reader swaps the middle slot for its own only when it is newer.
+// Notes: Exactly one writer thread and one reader thread. Intermediate
+//        values may be skipped; the reader always ends up with the latest.
+//        T should be cheap to copy (no heap members).
+template <typename T>
+class TripleBuffer {
+public:
+    explicit TripleBuffer(const T& initial = T()) : slots{initial, initial, initial} {}
+
+    // Writer thread.
+    void write(const T& value) {
+        slots[back] = value;
+        back = middle.exchange(back | kFresh, std::memory_order_acq_rel) & kIndex;
+    }
+
+    // Reader thread. Null when nothing new was written since the last call.
+    const T* read() {
+        if (!(middle.load(std::memory_order_acquire) & kFresh)) return nullptr;
+        front = middle.exchange(front, std::memory_order_acq_rel) & kIndex;
+        return &slots[front];
+    }
+
+private:
+    static constexpr int kIndex = 3;
+    static constexpr int kFresh = 4;
+
+    T slots[3];
+    std::atomic<int> middle{1};
+    int back = 0;  // writer's slot
+    int front = 2; // reader's slot
+};
@@ -0,0 +1,150 @@
+/*
+ * Author: Itoro Ifon, jason Hippolite, Prince Umeh
+ * Date: 2026-10-16
+ * Course/Assignment: C++ Project - Qt Music Player
+ * File: waveformpeaks.cpp
+ * Purpose: Implements the PCM peak reduction, the mip levels, column
+ *          rendering and the compact serialized form.
+ */
+#include "waveformpeaks.h"
+
+#include <QDataStream>
+
+#include <algorithm>
+#include <cmath>
+
+static constexpr quint32 kPeaksMagic = 0x514D5057; // "QMPW"
+static constexpr quint32 kPeaksVersion = 1;
+
+static PeakPair merged(PeakPair a, PeakPair b) {
+    return {std::min(a.lo, b.lo), std::max(a.hi, b.hi)};
+}
+
+// ========================= Pyramid =========================
+PeakPyramid::PeakPyramid(std::vector<PeakPair> base, unsigned framesPerBucket, unsigned sampleRate)
+    : bucketFrames(framesPerBucket), rate(sampleRate) {
+    if (base.empty()) return;
+    levels.push_back(std::move(base));
+
+    // Halve down to a single bucket; the whole pyramid costs less than
+    // twice the base level.
+    while (levels.back().size() > 1) {
+        const std::vector<PeakPair>& below = levels.back();
+        std::vector<PeakPair> up((below.size() + 1) / 2);
+        for (std::size_t i = 0; i + 1 < below.size(); i += 2) up[i / 2] = merged(below[i], below[i + 1]);
+        if (below.size() % 2) up.back() = below.back();
+        levels.push_back(std::move(up));
+    }
+}
+
+double PeakPyramid::durationSeconds() const {
+    if (rate == 0) return 0.0;
+    return double(baseBuckets()) * double(bucketFrames) / double(rate);
+}
+
+void PeakPyramid::render(double from, double to, int columns, std::vector<PeakPair>& out) const {
+    out.assign(std::size_t(std::max(0, columns)), PeakPair());
+    if (isEmpty() || columns <= 0 || to <= from) return;
+
+    const double n0 = double(baseBuckets());
+    const double perColumn = (to - from) * n0 / columns; // base buckets per column
+
+    int l = 0;
+    while (l + 1 < levelCount() && double(std::size_t(1) << (l + 1)) <= perColumn) ++l;
+    const std::vector<PeakPair>& lvl = levels[std::size_t(l)];
+    const double scale = 1.0 / double(std::size_t(1) << l);
+    const std::size_t n = lvl.size();
+
+    for (int c = 0; c < columns; ++c) {
+        const double a = (from * n0 + c * perColumn) * scale;
+        const double b = (from * n0 + (c + 1) * perColumn) * scale;
+        if (a < 0.0 || a >= double(n)) continue;
+
+        const std::size_t i0 = std::size_t(a);
+        const std::size_t i1 = std::min(n, std::max(i0 + 1, std::size_t(b)));
+        PeakPair p = lvl[i0];
+        for (std::size_t i = i0 + 1; i < i1; ++i) p = merged(p, lvl[i]); // at most one more at the chosen level
+        out[std::size_t(c)] = p;
+    }
+}
+
+// ========================= Storage =========================
+QByteArray PeakPyramid::serialize() const {
+    QByteArray raw;
+    if (!isEmpty()) {
+        const std::vector<PeakPair>& base = levels.front();
+        raw.resize(qsizetype(base.size() * 2));
+        char* dst = raw.data();
+        for (std::size_t i = 0; i < base.size(); ++i) {
+            dst[2 * i] = char(base[i].lo);
+            dst[2 * i + 1] = char(base[i].hi);
+        }
+    }
+
+    QByteArray bytes;
+    QDataStream out(&bytes, QIODevice::WriteOnly);
+    out.setVersion(QDataStream::Qt_6_0);
+    out << kPeaksMagic << kPeaksVersion << quint32(bucketFrames) << quint32(rate) << qCompress(raw);
+    return bytes;
+}
+
+bool PeakPyramid::deserialize(const QByteArray& bytes, PeakPyramid& out) {
+    QDataStream in(bytes);
+    in.setVersion(QDataStream::Qt_6_0);
+
+    quint32 magic = 0, version = 0, frames = 0, sampleRate = 0;
+    QByteArray packed;
+    in >> magic >> version >> frames >> sampleRate >> packed;
+    if (in.status() != QDataStream::Ok || magic != kPeaksMagic || version != kPeaksVersion || frames == 0)
+        return false;
+
+    const QByteArray raw = qUncompress(packed);
+    if (raw.isEmpty() || raw.size() % 2) return false;
+
+    std::vector<PeakPair> base(std::size_t(raw.size() / 2));
+    const char* src = raw.constData();
+    for (std::size_t i = 0; i < base.size(); ++i) base[i] = {std::int8_t(src[2 * i]), std::int8_t(src[2 * i + 1])};
+
+    out = PeakPyramid(std::move(base), frames, sampleRate);
+    return true;
+}
+
+// ========================= Builder =========================
+PeakBuilder::PeakBuilder(unsigned channels, unsigned framesPerBucket)
+    : bucketFrames(std::max(1u, framesPerBucket)),
+      bucketSamples(std::size_t(std::max(1u, framesPerBucket)) * std::max(1u, channels)) {}
+
+void PeakBuilder::addFrames(const std::int16_t* interleaved, std::size_t frames) {
+    const std::size_t total = frames * (bucketSamples / bucketFrames);
+    std::size_t i = 0;
+
+    while (i < total) {
+        const std::size_t take = std::min(bucketSamples - fill, total - i);
+        const std::int16_t* p = interleaved + i;
+
+        // Branch-free reduction over a contiguous run.
+        std::int16_t l = lo, h = hi;
+        for (std::size_t j = 0; j < take; ++j) {
+            l = std::min(l, p[j]);
+            h = std::max(h, p[j]);
+        }
+        lo = l;
+        hi = h;
+
+        fill += take;
+        i += take;
+        if (fill == bucketSamples) closeBucket();
+    }
+}
+
+void PeakBuilder::closeBucket() {
+    base.push_back({std::int8_t(lo >> 8), std::int8_t(hi >> 8)});
+    fill = 0;
+    lo = INT16_MAX;
+    hi = INT16_MIN;
+}
+
+PeakPyramid PeakBuilder::finish(unsigned sampleRate) {
+    if (fill > 0) closeBucket();
+    return PeakPyramid(std::move(base), bucketFrames, sampleRate);
+}
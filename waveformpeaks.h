@@ -0,0 +1,85 @@
+/*
+ * Author: Itoro Ifon, jason Hippolite, Prince Umeh
+ * Date: 2026-10-16
+ * Course/Assignment: C++ Project - Qt Music Player
+ * File: waveformpeaks.h
+ * Purpose: Declares the min/max peak summaries behind the waveform seek bar:
+ *          PeakBuilder reduces decoded PCM, PeakPyramid keeps the mip levels
+ *          and renders any zoomed span into a fixed number of columns.
+ */
+#pragma once
+
+#include <QByteArray>
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+// Struct: PeakPair
+// Purpose: Lowest and highest sample of one bucket, in 8 bits (sample >> 8);
+//          plenty for a bar a few dozen pixels tall.
+struct PeakPair {
+    std::int8_t lo = 0;
+    std::int8_t hi = 0;
+};
+
+// Class: PeakPyramid
+// Purpose: Level 0 holds one PeakPair per kFramesPerBucket frames; every
+//          further level merges neighbouring pairs of the one below, so any
+//          zoom reads at most two buckets per output column.
+// Notes: Immutable once built; shared between threads through PeakPyramidPtr.
+//        Only level 0 is stored on disk, the rest is rebuilt on load.
+class PeakPyramid {
+public:
+    PeakPyramid() = default;
+    PeakPyramid(std::vector<PeakPair> base, unsigned framesPerBucket, unsigned sampleRate);
+
+    bool isEmpty() const { return levels.empty() || levels.front().empty(); }
+    int levelCount() const { return int(levels.size()); }
+    const std::vector<PeakPair>& level(int i) const { return levels[std::size_t(i)]; }
+    std::size_t baseBuckets() const { return isEmpty() ? 0 : levels.front().size(); }
+    unsigned framesPerBucket() const { return bucketFrames; }
+    unsigned sampleRate() const { return rate; }
+    double durationSeconds() const;
+
+    // Fills `columns` pairs covering the fraction [from, to) of the track,
+    // reading from the coarsest level that still has a bucket per column.
+    void render(double from, double to, int columns, std::vector<PeakPair>& out) const;
+
+    QByteArray serialize() const;
+    static bool deserialize(const QByteArray& bytes, PeakPyramid& out);
+
+private:
+    std::vector<std::vector<PeakPair>> levels;
+    unsigned bucketFrames = 0;
+    unsigned rate = 0;
+};
+
+using PeakPyramidPtr = std::shared_ptr<const PeakPyramid>;
+
+// Class: PeakBuilder
+// Purpose: Streams interleaved 16-bit PCM into level-0 buckets.
+// Notes: A bucket spans framesPerBucket frames of all channels, which are
+//        contiguous in interleaved PCM, so each bucket is one flat integer
+//        min/max reduction the compiler turns into packed min/max
+//        instructions. A partial bucket carries over to the next call.
+class PeakBuilder {
+public:
+    explicit PeakBuilder(unsigned channels, unsigned framesPerBucket = kFramesPerBucket);
+
+    void addFrames(const std::int16_t* interleaved, std::size_t frames);
+    PeakPyramid finish(unsigned sampleRate);
+
+    static constexpr unsigned kFramesPerBucket = 512; // ~11.6 ms at 44.1 kHz
+
+private:
+    void closeBucket();
+
+    unsigned bucketFrames;
+    std::size_t bucketSamples;       // framesPerBucket * channels
+    std::size_t fill = 0;            // samples in the open bucket
+    std::int16_t lo = INT16_MAX;
+    std::int16_t hi = INT16_MIN;
+    std::vector<PeakPair> base;
+};
@@ -0,0 +1,121 @@
+/*
+ * Author: Itoro Ifon, jason Hippolite, Prince Umeh
+ * Date: 2026-10-16
+ * Course/Assignment: C++ Project - Qt Music Player
+ * File: waveformprovider.cpp
+ * Purpose: Implements the peak cache levels and the background decode.
+ */
+#include "waveformprovider.h"
+#include "playbackengine.h"
+#include "tracer.h"
+
+#include <QDir>
+#include <QFile>
+#include <QSaveFile>
+#include <QCryptographicHash>
+#include <QStandardPaths>
+#include <QThread>
+
+#include <vector>
+
+WaveformProvider::WaveformProvider(QObject* parent, int maxTracks)
+    : QObject(parent),
+      diskDir(QDir(QStandardPaths::writableLocation(QStandardPaths::CacheLocation)).filePath("waveforms")),
+      peaks(maxTracks) {
+    pool.setMaxThreadCount(1);                    // a single decode keeps its I/O off playback's toes
+    pool.setThreadPriority(QThread::LowPriority);
+}
+
+WaveformProvider::~WaveformProvider() {
+    pool.clear();
+    pool.waitForDone();
+}
+
+// ========================= Lookup =========================
+PeakPyramidPtr WaveformProvider::request(const QString& path) {
+    if (PeakPyramidPtr* hit = peaks.object(path)) return *hit;
+
+    // Loads queued for tracks the user already skipped past are not wanted.
+    pool.clear();
+    pending.clear();
+    schedule(path, 1);
+    return nullptr;
+}
+
+void WaveformProvider::prefetch(const QString& path) {
+    if (!peaks.contains(path)) schedule(path, 0);
+}
+
+void WaveformProvider::schedule(const QString& path, int priority) {
+    if (path.isEmpty() || pending.contains(path) || undecodable.contains(path)) return;
+    pending.insert(path);
+    pool.start([this, path] { load(path); }, priority);
+}
+
+// Pool thread: disk first, then a full decode whose result is written back.
+void WaveformProvider::load(const QString& path) {
+    TRACE_SCOPE("WaveformProvider::load");
+    const QFileInfo audio(path);
+    const QString stored = QDir(diskDir).filePath(diskKey(audio) + ".peaks");
+
+    PeakPyramid pyramid;
+    bool ok = false;
+
+    QFile f(stored);
+    if (f.open(QIODevice::ReadOnly)) ok = PeakPyramid::deserialize(f.readAll(), pyramid);
+
+    if (!ok) {
+        ok = compute(path, pyramid);
+        if (ok) {
+            // Best effort; a failed write only costs a re-decode next time.
+            QDir().mkpath(diskDir);
+            QSaveFile out(stored);
+            if (out.open(QIODevice::WriteOnly)) {
+                out.write(pyramid.serialize());
+                out.commit();
+            }
+        }
+    }
+
+    PeakPyramidPtr result = ok ? std::make_shared<const PeakPyramid>(std::move(pyramid)) : nullptr;
+    QMetaObject::invokeMethod(this, [this, path, result] {
+        pending.remove(path);
+        if (!result) {
+            undecodable.insert(path);
+            return;
+        }
+        peaks.insert(path, new PeakPyramidPtr(result));
+        emit ready(path, result);
+    }, Qt::QueuedConnection);
+}
+
+bool WaveformProvider::compute(const QString& path, PeakPyramid& out) {
+    TRACE_SCOPE("WaveformProvider::compute");
+    auto file = PlaybackEngine::openFile(path);
+    if (!file) return false;
+
+    const unsigned channels = file->getChannelCount();
+    const unsigned rate = file->getSampleRate();
+    if (channels == 0 || rate == 0) return false;
+
+    PeakBuilder builder(channels);
+    std::vector<std::int16_t> buffer(std::size_t(rate / 2) * channels); // 500 ms per read
+
+    for (;;) {
+        const std::uint64_t got = file->read(buffer.data(), buffer.size());
+        if (got == 0) break;
+        builder.addFrames(buffer.data(), std::size_t(got / channels));
+    }
+
+    out = builder.finish(rate);
+    return !out.isEmpty();
+}
+
+QString WaveformProvider::diskKey(const QFileInfo& audio) const {
+    QCryptographicHash h(QCryptographicHash::Sha1);
+    h.addData(audio.absoluteFilePath().toUtf8());
+    h.addData(QByteArray::number(audio.size()));
+    h.addData(QByteArray::number(audio.lastModified().toMSecsSinceEpoch()));
+    h.addData(QByteArray::number(PeakBuilder::kFramesPerBucket));
+    return QString::fromLatin1(h.result().toHex());
+}
@@ -0,0 +1,59 @@
+/*
+ * Author: Itoro Ifon, jason Hippolite, Prince Umeh
+ * Date: 2026-10-16
+ * Course/Assignment: C++ Project - Qt Music Player
+ * File: waveformprovider.h
+ * Purpose: Declares WaveformProvider, which hands out peak pyramids for the
+ *          seek bar from memory, from disk, or by decoding in the background.
+ */
+#pragma once
+
+#include <QObject>
+#include <QString>
+#include <QSet>
+#include <QCache>
+#include <QFileInfo>
+#include <QThreadPool>
+
+#include "waveformpeaks.h"
+
+// Class: WaveformProvider
+// Purpose: Turns an audio path into a PeakPyramid.
+//          Level 1: LRU of pyramids keyed by path.
+//          Level 2: compressed peak files under the app cache directory,
+//                   keyed by path, size and mtime.
+//          Misses are decoded with SFML on one low-priority thread, separate
+//          from playback's own file handle; ready() delivers the result.
+// Notes: GUI thread API. request() is for the track on screen and drops
+//        loads queued for tracks skipped past; prefetch() queues behind it.
+class WaveformProvider : public QObject {
+    Q_OBJECT
+
+public:
+    explicit WaveformProvider(QObject* parent = nullptr, int maxTracks = 32);
+    ~WaveformProvider() override;
+
+    // Cached pyramid, or null with a load scheduled.
+    PeakPyramidPtr request(const QString& path);
+    void prefetch(const QString& path);
+
+    QString storeDir() const { return diskDir; }
+
+    // Decodes the whole file (any thread). False if it can't be read.
+    static bool compute(const QString& path, PeakPyramid& out);
+
+signals:
+    void ready(const QString& path, PeakPyramidPtr peaks);
+
+private:
+    void schedule(const QString& path, int priority);
+    void load(const QString& path);
+    QString diskKey(const QFileInfo& audio) const;
+
+    QString diskDir;
+    QThreadPool pool;
+
+    QCache<QString, PeakPyramidPtr> peaks; // path -> pyramid
+    QSet<QString> pending;                 // queued or being loaded
+    QSet<QString> undecodable;
+};
@@ -0,0 +1,204 @@
+/*
+ * Author: Itoro Ifon, jason Hippolite, Prince Umeh
+ * Date: 2026-10-16
+ * Course/Assignment: C++ Project - Qt Music Player
+ * File: waveformseekbar.cpp
+ * Purpose: Implements waveform painting, click-to-seek and zooming.
+ */
+#include "waveformseekbar.h"
+#include "tracer.h"
+
+#include <QPainter>
+#include <QMouseEvent>
+#include <QWheelEvent>
+
+#include <algorithm>
+#include <cmath>
+
+static const QColor kPlayedColor("#3b82f6");
+static const QColor kRemainingColor("#4a5a7d");
+static const QColor kPlayheadColor("#eef2ff");
+
+WaveformSeekBar::WaveformSeekBar(QWidget* parent) : QSlider(Qt::Horizontal, parent) {
+    setRange(0, kSteps);
+    setMinimumHeight(36);
+}
+
+// ========================= Peaks & view =========================
+void WaveformSeekBar::setPeaks(PeakPyramidPtr p) {
+    if (p == peaks) return; // same track again: keep the zoom
+    peaks = std::move(p);
+    viewFrom = 0.0;
+    viewTo = 1.0;
+    pixmapsStale = true;
+    update();
+    emit viewChanged();
+}
+
+void WaveformSeekBar::resetZoom() { setView(0.0, 1.0); }
+
+void WaveformSeekBar::setView(double from, double to) {
+    double span = std::clamp(to - from, minSpan(), 1.0);
+    from = std::clamp(from, 0.0, 1.0 - span);
+    if (from == viewFrom && from + span == viewTo) return;
+
+    viewFrom = from;
+    viewTo = from + span;
+    pixmapsStale = true;
+    update();
+    emit viewChanged();
+}
+
+// Closest zoom: one level-0 bucket per pixel.
+double WaveformSeekBar::minSpan() const {
+    if (!hasPeaks()) return 1.0;
+    return std::min(1.0, double(std::max(1, width())) / double(peaks->baseBuckets()));
+}
+
+int WaveformSeekBar::valueAt(double x) const {
+    const double f = viewFrom + std::clamp(x / std::max(1, width()), 0.0, 1.0) * visibleSpan();
+    return int(std::lround(f * maximum()));
+}
+
+double WaveformSeekBar::xOf(int value) const {
+    const double f = maximum() > 0 ? double(value) / maximum() : 0.0;
+    return (f - viewFrom) / visibleSpan() * width();
+}
+
+// ========================= Painting =========================
+void WaveformSeekBar::rebuildPixmaps() {
+    TRACE_SCOPE("WaveformSeekBar::rebuildPixmaps");
+    const qreal dpr = devicePixelRatioF();
+    const int w = std::max(1, int(std::lround(width() * dpr)));
+    const int h = std::max(1, int(std::lround(height() * dpr)));
+
+    peaks->render(viewFrom, viewTo, w, columns);
+
+    const double mid = h / 2.0;
+    const double scale = (h / 2.0 - 1.0) / 128.0;
+    auto draw = [&](QPixmap& px, const QColor& color) {
+        px = QPixmap(w, h);
+        px.fill(Qt::transparent);
+        QPainter p(&px);
+        for (int x = 0; x < w; ++x) {
+            const PeakPair c = columns[std::size_t(x)];
+            const int top = int(std::floor(mid - c.hi * scale));
+            const int bottom = int(std::ceil(mid - c.lo * scale));
+            p.fillRect(x, top, 1, std::max(1, bottom - top), color); // silence stays a 1 px line
+        }
+        p.end();
+        px.setDevicePixelRatio(dpr);
+    };
+    draw(playedPx, kPlayedColor);
+    draw(remainingPx, kRemainingColor);
+    pixmapsStale = false;
+}
+
+void WaveformSeekBar::paintEvent(QPaintEvent* e) {
+    if (!hasPeaks()) {
+        QSlider::paintEvent(e);
+        return;
+    }
+
+    TRACE_SCOPE("WaveformSeekBar::paint");
+    if (pixmapsStale || playedPx.deviceIndependentSize().toSize() != size()) rebuildPixmaps();
+
+    const qreal dpr = devicePixelRatioF();
+    const int w = width(), h = height();
+    const int x = std::clamp(int(std::lround(xOf(sliderPosition()))), 0, w);
+
+    QPainter p(this);
+    if (x > 0) p.drawPixmap(QRectF(0, 0, x, h), playedPx, QRectF(0, 0, x * dpr, h * dpr));
+    if (x < w) p.drawPixmap(QRectF(x, 0, w - x, h), remainingPx, QRectF(x * dpr, 0, (w - x) * dpr, h * dpr));
+
+    const double f = maximum() > 0 ? double(sliderPosition()) / maximum() : 0.0;
+    if (f >= viewFrom && f <= viewTo) p.fillRect(std::min(x, w - 2), 0, 2, h, kPlayheadColor);
+
+    // Where the zoomed view sits within the track.
+    if (visibleSpan() < 1.0)
+        p.fillRect(QRectF(viewFrom * w, h - 2, visibleSpan() * w, 2), kPlayedColor);
+}
+
+void WaveformSeekBar::resizeEvent(QResizeEvent* e) {
+    QSlider::resizeEvent(e);
+    pixmapsStale = true;
+    if (hasPeaks()) setView(viewFrom, viewTo); // the closest zoom depends on the width
+}
+
+// ========================= Mouse =========================
+// The plain slider pages towards a click; a waveform jumps to it.
+void WaveformSeekBar::mousePressEvent(QMouseEvent* e) {
+    if (!hasPeaks() || e->button() != Qt::LeftButton) {
+        QSlider::mousePressEvent(e);
+        return;
+    }
+    setSliderDown(true);
+    setSliderPosition(valueAt(e->position().x()));
+    e->accept();
+}
+
+void WaveformSeekBar::mouseMoveEvent(QMouseEvent* e) {
+    if (!hasPeaks() || !isSliderDown()) {
+        QSlider::mouseMoveEvent(e);
+        return;
+    }
+    setSliderPosition(valueAt(e->position().x()));
+    e->accept();
+}
+
+void WaveformSeekBar::mouseReleaseEvent(QMouseEvent* e) {
+    if (!hasPeaks() || !isSliderDown()) {
+        QSlider::mouseReleaseEvent(e);
+        return;
+    }
+    setSliderPosition(valueAt(e->position().x()));
+    setSliderDown(false); // emits sliderReleased(); the owner seeks
+    e->accept();
+}
+
+void WaveformSeekBar::mouseDoubleClickEvent(QMouseEvent* e) {
+    if (!hasPeaks()) {
+        QSlider::mouseDoubleClickEvent(e);
+        return;
+    }
+    resetZoom();
+    e->accept();
+}
+
+void WaveformSeekBar::wheelEvent(QWheelEvent* e) {
+    if (!hasPeaks()) {
+        QSlider::wheelEvent(e);
+        return;
+    }
+
+    const QPoint delta = e->angleDelta();
+    const double notches = (delta.y() != 0 ? delta.y() : delta.x()) / 120.0;
+
+    if (e->modifiers() & Qt::ControlModifier) {
+        // Keep the point under the cursor where it is.
+        const double anchor = std::clamp(e->position().x() / std::max(1, width()), 0.0, 1.0);
+        const double at = viewFrom + anchor * visibleSpan();
+        const double span = std::clamp(visibleSpan() * std::pow(0.8, notches), minSpan(), 1.0);
+        setView(at - anchor * span, at - anchor * span + span);
+    } else if (visibleSpan() < 1.0) {
+        const double shift = -notches * 0.1 * visibleSpan();
+        setView(viewFrom + shift, viewTo + shift);
+    } else {
+        e->ignore(); // let the window scroll
+        return;
+    }
+    e->accept();
+}
+
+// ========================= Follow playback =========================
+void WaveformSeekBar::sliderChange(SliderChange change) {
+    QSlider::sliderChange(change);
+    if (change != SliderValueChange || isSliderDown() || visibleSpan() >= 1.0) return;
+
+    // Page the zoomed view along when the playhead leaves it.
+    const double f = maximum() > 0 ? double(value()) / maximum() : 0.0;
+    if (f < viewFrom || f > viewTo) {
+        const double from = f - 0.05 * visibleSpan();
+        setView(from, from + visibleSpan());
+    }
+}
@@ -0,0 +1,71 @@
+/*
+ * Author: Itoro Ifon, jason Hippolite, Prince Umeh
+ * Date: 2026-10-16
+ * Course/Assignment: C++ Project - Qt Music Player
+ * File: waveformseekbar.h
+ * Purpose: Declares WaveformSeekBar, the seek slider that draws the track's
+ *          waveform and can zoom into part of it.
+ */
+#pragma once
+
+#include <QSlider>
+#include <QPixmap>
+
+#include <vector>
+
+#include "waveformpeaks.h"
+
+// Class: WaveformSeekBar
+// Purpose: A horizontal QSlider (same signals, range 0..kSteps) that paints
+//          the peak pyramid of the current track instead of a groove, with
+//          the played part highlighted.
+// Notes: The waveform is rendered into two pixmaps (played / remaining
+//        colours) only when the peaks, the size or the zoom change; a frame
+//        is two blits and the playhead. Clicking jumps straight to the
+//        clicked position. Ctrl+wheel zooms around the cursor, the wheel
+//        pans while zoomed, double-click shows the whole track again. The
+//        zoomed view follows the playhead a page at a time. Without peaks it
+//        paints like a plain slider.
+class WaveformSeekBar : public QSlider {
+    Q_OBJECT
+
+public:
+    explicit WaveformSeekBar(QWidget* parent = nullptr);
+
+    void setPeaks(PeakPyramidPtr peaks); // null clears the waveform
+    bool hasPeaks() const { return peaks && !peaks->isEmpty(); }
+
+    double visibleSpan() const { return viewTo - viewFrom; } // fraction of the track on screen
+    void resetZoom();
+
+    static constexpr int kSteps = 100000;
+
+signals:
+    void viewChanged();
+
+protected:
+    void paintEvent(QPaintEvent* e) override;
+    void resizeEvent(QResizeEvent* e) override;
+    void mousePressEvent(QMouseEvent* e) override;
+    void mouseMoveEvent(QMouseEvent* e) override;
+    void mouseReleaseEvent(QMouseEvent* e) override;
+    void mouseDoubleClickEvent(QMouseEvent* e) override;
+    void wheelEvent(QWheelEvent* e) override;
+    void sliderChange(SliderChange change) override;
+
+private:
+    void setView(double from, double to);
+    void rebuildPixmaps();
+    int valueAt(double x) const;
+    double xOf(int value) const;
+    double minSpan() const;
+
+    PeakPyramidPtr peaks;
+    double viewFrom = 0.0;
+    double viewTo = 1.0;
+
+    QPixmap playedPx;
+    QPixmap remainingPx;
+    bool pixmapsStale = true;
+    std::vector<PeakPair> columns; // scratch for render()
+};